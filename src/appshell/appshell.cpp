@@ -21,6 +21,7 @@
 
 #include <QApplication>
 #include <QQmlApplicationEngine>
+#include <QQuickWindow>
 #ifndef Q_OS_WASM
 #include <QThreadPool>
 #endif
@@ -73,23 +74,20 @@ int AppShell::run(int argc, char** argv)
     // ====================================================
     // Setup modules: Resources, Exports, Imports, UiTypes
     // ====================================================
+    std::vector<framework::IModuleSetup*> modules(m_modules.begin(), m_modules.end());
+
     globalModule.registerResources();
     globalModule.registerExports();
     globalModule.registerUiTypes();
 
-    for (mu::framework::IModuleSetup* m : m_modules) {
-        m->registerResources();
-    }
-
-    for (mu::framework::IModuleSetup* m : m_modules) {
-        m->registerExports();
-    }
+    m_setupRunner.run(modules, "registerResources", [](framework::IModuleSetup* m) { m->registerResources(); });
+    m_setupRunner.run(modules, "registerExports", [](framework::IModuleSetup* m) { m->registerExports(); });
 
     globalModule.resolveImports();
-    for (mu::framework::IModuleSetup* m : m_modules) {
+    m_setupRunner.run(modules, "resolveImports", [](framework::IModuleSetup* m) {
         m->registerUiTypes();
         m->resolveImports();
-    }
+    });
 
     // ====================================================
     // Parse and apply command line options
@@ -98,23 +96,20 @@ int AppShell::run(int argc, char** argv)
     commandLine.parse(QCoreApplication::arguments());
     commandLine.apply();
     framework::IApplication::RunMode runMode = muapplication()->runMode();
+    m_startupTraceFile = commandLine.startupTraceFile();
 
     // ====================================================
     // Setup modules: onInit
     // ====================================================
     globalModule.onInit(runMode);
-    for (mu::framework::IModuleSetup* m : m_modules) {
-        m->onInit(runMode);
-    }
+    m_setupRunner.init(modules, runMode);
 
     // ====================================================
     // Setup modules: onStartApp (on next event loop)
     // ====================================================
-    QMetaObject::invokeMethod(qApp, [this]() {
+    QMetaObject::invokeMethod(qApp, [this, modules]() {
         globalModule.onStartApp();
-        for (mu::framework::IModuleSetup* m : m_modules) {
-            m->onStartApp();
-        }
+        m_setupRunner.run(modules, "onStartApp", [](framework::IModuleSetup* m) { m->onStartApp(); });
     }, Qt::QueuedConnection);
 
     // ====================================================
@@ -127,7 +122,9 @@ int AppShell::run(int argc, char** argv)
         // Process Converter
         // ====================================================
         auto task = commandLine.converterTask();
-        QMetaObject::invokeMethod(qApp, [this, task]() {
+        QMetaObject::invokeMethod(qApp, [this, task, modules]() {
+                // there is no window, so delayed init is done before the conversion
+                delayedInit(modules);
                 int code = processConverter(task);
                 qApp->exit(code);
             }, Qt::QueuedConnection);
@@ -165,6 +162,24 @@ int AppShell::run(int argc, char** argv)
                 }
             });
 
+        // ====================================================
+        // Delayed init after the first frame
+        // ====================================================
+        QObject::connect(engine, &QQmlApplicationEngine::objectCreated,
+                         &app, [this, modules](QObject* obj, const QUrl&) {
+                QQuickWindow* window = qobject_cast<QQuickWindow*>(obj);
+                if (!window) {
+                    delayedInit(modules);
+                    return;
+                }
+                QMetaObject::Connection* conn = new QMetaObject::Connection();
+                *conn = QObject::connect(window, &QQuickWindow::frameSwapped, window, [this, modules, conn]() {
+                    QObject::disconnect(*conn);
+                    delete conn;
+                    delayedInit(modules);
+                }, Qt::QueuedConnection);
+            }, Qt::QueuedConnection);
+
         // ====================================================
         // Load Main qml
         // ====================================================
@@ -204,16 +219,56 @@ int AppShell::run(int argc, char** argv)
     return retCode;
 }
 
+void AppShell::delayedInit(const std::vector<framework::IModuleSetup*>& modules)
+{
+    if (m_delayedInitDone) {
+        return;
+    }
+    m_delayedInitDone = true;
+
+    globalModule.onDelayedInit();
+    m_setupRunner.run(modules, "onDelayedInit", [](framework::IModuleSetup* m) { m->onDelayedInit(); });
+
+    LOGI() << "startup: onInit " << m_setupRunner.phaseDurationUs("onInit") / 1000 << " ms, "
+           << "onDelayedInit " << m_setupRunner.phaseDurationUs("onDelayedInit") / 1000 << " ms";
+
+    if (!m_startupTraceFile.isEmpty()) {
+        m_setupRunner.writeTrace(m_startupTraceFile);
+    }
+}
+
 int AppShell::processConverter(const CommandLineController::ConverterTask& task)
 {
     Ret ret;
-    if (task.isBatchMode) {
-        ret = converter()->batchConvert(task.inputFile);
+    if (task.isServerMode) {
+        converter::ServerOptions options;
+        options.socketName = task.serverSocket.toStdString();
+        options.workers = task.jobWorkers;
+        options.maxPendingJobs = task.serverMaxPending;
+        for (const QString& arg : task.childArguments) {
+            options.childArguments.push_back(arg.toStdString());
+        }
+        ret = converter()->serve(options);
+        if (!ret) {
+            LOGE() << "failed serve, error: " << ret.toString();
+        }
+    } else if (task.isBatchMode) {
+        converter::BatchOptions options;
+        options.workers = task.jobWorkers;
+        options.isolateProcesses = task.jobIsolate;
+        options.reportPath = task.jobReportFile;
+        options.convert.allPages = task.exportAllPages;
+        for (const QString& arg : task.childArguments) {
+            options.childArguments.push_back(arg.toStdString());
+        }
+        ret = converter()->batchConvert(task.inputFile, options);
         if (!ret) {
             LOGE() << "failed batch convert, error: " << ret.toString();
         }
     } else {
-        ret = converter()->fileConvert(task.inputFile, task.outputFile);
+        converter::ConvertOptions options;
+        options.allPages = task.exportAllPages;
+        ret = converter()->fileConvert(task.inputFile, task.outputFile, options);
         if (!ret) {
             LOGE() << "failed file convert, error: " << ret.toString();
         }
@@ -21,8 +21,10 @@
 #define MU_APPSHELL_APPSHELL_H
 
 #include <QList>
+#include <vector>
 
 #include "modularity/imodulesetup.h"
+#include "modularity/modulessetuprunner.h"
 #include "modularity/ioc.h"
 #include "global/iapplication.h"
 #include "converter/iconvertercontroller.h"
@@ -44,9 +46,13 @@ public:
 
 private:
 
+    void delayedInit(const std::vector<framework::IModuleSetup*>& modules);
     int processConverter(const CommandLineController::ConverterTask& task);
 
     QList<mu::framework::IModuleSetup*> m_modules;
+    framework::ModulesSetupRunner m_setupRunner;
+    QString m_startupTraceFile;
+    bool m_delayedInitDone = false;
 };
 }
 
@@ -32,11 +32,20 @@ void CommandLineController::parse(const QStringList& args)
     m_parser.addPositionalArgument("scorefiles", "The files to open", "[scorefile...]");
 
     m_parser.addOption(QCommandLineOption({ "D", "monitor-resolution" }, "Specify monitor resolution", "DPI"));
+    m_parser.addOption(QCommandLineOption("startup-trace", "Write per-module startup timings to 'file' (Chrome trace format)", "file"));
 
     // Converter mode
     m_parser.addOption(QCommandLineOption({ "r", "image-resolution" }, "Set output resolution for image export", "DPI"));
     m_parser.addOption(QCommandLineOption({ "j", "job" }, "Process a conversion job", "file"));
     m_parser.addOption(QCommandLineOption({ "o", "export-to" }, "Export to 'file'. Format depends on file's extension", "file"));
+    m_parser.addOption(QCommandLineOption("export-all-pages",
+                                          "Export every page of a PNG or SVG export to its own file: 'file'-1.png, 'file'-2.png, ..."));
+    m_parser.addOption(QCommandLineOption("job-workers", "Number of conversion jobs processed at the same time, each in a separate child process", "count"));
+    m_parser.addOption(QCommandLineOption("job-isolate", "Process each conversion job in a separate child process, also with one worker"));
+    m_parser.addOption(QCommandLineOption("job-report", "Write a JSON report with per-job metrics to 'file'", "file"));
+    m_parser.addOption(QCommandLineOption("serve", "Run as a conversion server reading JSON-lines requests from stdin"));
+    m_parser.addOption(QCommandLineOption("serve-socket", "Run as a conversion server listening on the local socket 'name'", "name"));
+    m_parser.addOption(QCommandLineOption("serve-max-pending", "Number of requests the server accepts before it stops reading", "count"));
 
     m_parser.process(args);
 }
@@ -56,6 +65,10 @@ void CommandLineController::apply()
     // TODO: Open these files at launch if RunMode is Editor
     QStringList scorefiles = m_parser.positionalArguments();
 
+    if (m_parser.isSet("startup-trace")) {
+        m_startupTraceFile = m_parser.value("startup-trace");
+    }
+
     if (m_parser.isSet("D")) {
         std::optional<float> val = floatValue("D");
         if (val) {
@@ -93,9 +106,69 @@ void CommandLineController::apply()
         m_converterTask.isBatchMode = true;
         m_converterTask.inputFile = m_parser.value("j");
     }
+
+    if (m_parser.isSet("serve") || m_parser.isSet("serve-socket")) {
+        application()->setRunMode(IApplication::RunMode::Converter);
+        m_converterTask.isServerMode = true;
+        m_converterTask.serverSocket = m_parser.value("serve-socket");
+    }
+
+    if (m_parser.isSet("serve-max-pending")) {
+        bool ok = false;
+        int count = m_parser.value("serve-max-pending").toInt(&ok);
+        if (ok && count > 0) {
+            m_converterTask.serverMaxPending = count;
+        } else {
+            LOGE() << "Option: --serve-max-pending not recognized count value: " << m_parser.value("serve-max-pending");
+        }
+    }
+
+    if (m_parser.isSet("job-workers")) {
+        bool ok = false;
+        int workers = m_parser.value("job-workers").toInt(&ok);
+        if (ok && workers > 0) {
+            m_converterTask.jobWorkers = workers;
+        } else {
+            LOGE() << "Option: --job-workers not recognized count value: " << m_parser.value("job-workers");
+        }
+    }
+
+    m_converterTask.jobIsolate = m_parser.isSet("job-isolate");
+
+    if (m_parser.isSet("job-report")) {
+        m_converterTask.jobReportFile = m_parser.value("job-report");
+    }
+
+    m_converterTask.exportAllPages = m_parser.isSet("export-all-pages");
+
+    //! NOTE Jobs in child processes must be converted with the options of the user.
+    //! Only the options which change the output are passed on, the parent sets up the job of each child.
+    static const QStringList CHILD_OPTIONS = { "r", "D", "export-all-pages" };
+
+    for (const QString& name : CHILD_OPTIONS) {
+        if (!m_parser.isSet(name)) {
+            continue;
+        }
+
+        QString option = (name.size() == 1 ? "-" : "--") + name;
+        QStringList values = m_parser.values(name);
+        if (values.isEmpty()) {
+            m_converterTask.childArguments << option;
+            continue;
+        }
+
+        for (const QString& value : values) {
+            m_converterTask.childArguments << option << value;
+        }
+    }
 }
 
 CommandLineController::ConverterTask CommandLineController::converterTask() const
 {
     return m_converterTask;
 }
+
+QString CommandLineController::startupTraceFile() const
+{
+    return m_startupTraceFile;
+}
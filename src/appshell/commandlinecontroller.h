@@ -40,17 +40,27 @@ public:
         bool isBatchMode = false;
         QString inputFile;
         QString outputFile;
+        bool exportAllPages = false;
+        int jobWorkers = 1;
+        bool jobIsolate = false;
+        QString jobReportFile;
+        QStringList childArguments;
+        bool isServerMode = false;
+        QString serverSocket;
+        int serverMaxPending = 0;
     };
 
     void parse(const QStringList& args);
     void apply();
 
     ConverterTask converterTask() const;
+    QString startupTraceFile() const;
 
 private:
 
     QCommandLineParser m_parser;
     ConverterTask m_converterTask;
+    QString m_startupTraceFile;
 };
 }
 
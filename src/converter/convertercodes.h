@@ -29,6 +29,8 @@ enum class Err {
 
     BatchJobFileFailedOpen = 1301,
     BatchJobFileFailedParse = 1302,
+    BatchJobFailed = 1303,
+    BatchReportFailedWrite = 1304,
 
     ConvertTypeUnknown = 1310,
 
@@ -36,6 +38,12 @@ enum class Err {
 
     OutFileFailedOpen = 1330,
     OutFileFailedWrite = 1331,
+
+    WorkerProcessFailed = 1340,
+
+    ServerFailedListen = 1350,
+    ServerRequestFailedParse = 1351,
+    ServerQueueFull = 1352,
 };
 
 inline Ret make_ret(Err e)
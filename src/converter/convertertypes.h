@@ -0,0 +1,83 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_CONVERTER_CONVERTERTYPES_H
+#define MU_CONVERTER_CONVERTERTYPES_H
+
+#include <string>
+#include <vector>
+
+#include "io/path.h"
+
+namespace mu::converter {
+struct ConvertOptions {
+    //! Write every page of a PNG or SVG export to its own file: out-1.png, out-2.png, ...
+    //! Otherwise only the first page is written to out
+    bool allPages = false;
+};
+
+struct BatchOptions {
+    //! Number of jobs converted at the same time. With more than one,
+    //! every job is converted in a separate child process
+    int workers = 1;
+    //! Convert every job in a separate child process, also with one worker
+    bool isolateProcesses = false;
+    //! If not empty, a JSON report with per-job metrics is written to this file
+    io::path reportPath;
+    //! Command line options passed on to every child process, e.g. the image resolution
+    std::vector<std::string> childArguments;
+    ConvertOptions convert;
+};
+
+struct JobMetrics {
+    io::path in;
+    io::path out;
+
+    int errorCode = 0;
+    std::string errorText;
+
+    //! NOTE Loading includes the initial layout of the score
+    double loadMs = 0.0;
+    double exportMs = 0.0;
+    double totalMs = 0.0;
+
+    //! Peak resident set size of the process that converted the job, 0 if unknown.
+    //! NOTE For jobs converted in the calling process, this is the peak of the whole process so far
+    long long peakRssKb = 0;
+
+    bool success() const { return errorCode == 0; }
+};
+
+struct ServerOptions {
+    //! Name or path of the local socket to listen on.
+    //! If empty, requests are read from stdin and responses are written to stdout
+    std::string socketName;
+    //! Number of requests converted at the same time
+    int workers = 1;
+    //! Requests accepted but not answered yet, 0 means twice the number of workers.
+    //! While the limit is reached, reading stdin waits and requests from a local socket
+    //! are answered at once with ServerQueueFull
+    int maxPendingJobs = 0;
+    //! Number of most recent requests the latency percentiles are computed over
+    int latencyWindow = 1024;
+    //! Command line options passed on to the child process converting each request
+    std::vector<std::string> childArguments;
+};
+}
+
+#endif // MU_CONVERTER_CONVERTERTYPES_H
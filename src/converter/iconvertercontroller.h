@@ -23,6 +23,8 @@
 #include "ret.h"
 #include "io/path.h"
 
+#include "convertertypes.h"
+
 namespace mu::converter {
 class IConverterController : MODULE_EXPORT_INTERFACE
 {
@@ -30,8 +32,11 @@ class IConverterController : MODULE_EXPORT_INTERFACE
 public:
     virtual ~IConverterController() = default;
 
-    virtual Ret fileConvert(const io::path& in, const io::path& out) = 0;
-    virtual Ret batchConvert(const io::path& batchJobFile) = 0;
+    virtual Ret fileConvert(const io::path& in, const io::path& out, const ConvertOptions& options) = 0;
+    virtual Ret batchConvert(const io::path& batchJobFile, const BatchOptions& options) = 0;
+
+    //! Runs until the input is closed or a quit request is received
+    virtual Ret serve(const ServerOptions& options) = 0;
 };
 }
 
@@ -18,19 +18,56 @@
 //=============================================================================
 #include "convertercontroller.h"
 
+#include <algorithm>
+#include <memory>
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
 #include <QFile>
 #include <QJsonDocument>
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QJsonParseError>
+#include <QProcess>
+#include <QTemporaryDir>
+#include <QThreadPool>
+
+#if defined(Q_OS_UNIX) && !defined(Q_OS_WASM)
+#include <sys/resource.h>
+#endif
 
 #include "log.h"
 #include "convertercodes.h"
+#include "converterserver.h"
 #include "stringutils.h"
 
+#include "libmscore/score.h"
+
 using namespace mu::converter;
 
-mu::Ret ConverterController::batchConvert(const io::path& batchJobFile)
+static long long peakRssKb()
+{
+#if defined(Q_OS_UNIX) && !defined(Q_OS_WASM)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) {
+        return 0;
+    }
+#ifdef Q_OS_MACOS
+    return usage.ru_maxrss / 1024; // bytes on macOS
+#else
+    return usage.ru_maxrss;
+#endif
+#else
+    return 0;
+#endif
+}
+
+static double elapsedMs(const QElapsedTimer& timer)
+{
+    return timer.nsecsElapsed() / 1000000.0;
+}
+
+mu::Ret ConverterController::batchConvert(const io::path& batchJobFile, const BatchOptions& options)
 {
     RetVal<BatchJob> batchJob = parseBatchJob(batchJobFile);
     if (!batchJob.ret) {
@@ -38,19 +75,182 @@ mu::Ret ConverterController::batchConvert(const io::path& batchJobFile)
         return batchJob.ret;
     }
 
+    QElapsedTimer timer;
+    timer.start();
+
+    std::vector<JobMetrics> metrics = runJobs(batchJob.val, options);
+
+    double totalMs = elapsedMs(timer);
+
     Ret ret = make_ret(Ret::Code::Ok);
-    for (const Job& job : batchJob.val) {
-        ret = fileConvert(job.in, job.out);
-        if (!ret) {
-            LOGE() << "failed convert, err: " << ret.toString() << ", in: " << job.in << ", out: " << job.out;
-            break;
+    size_t failed = 0;
+    for (const JobMetrics& m : metrics) {
+        if (!m.success()) {
+            LOGE() << "failed convert, err: " << m.errorCode << " " << m.errorText << ", in: " << m.in << ", out: " << m.out;
+            ++failed;
+        }
+    }
+
+    LOGI() << "converted " << (metrics.size() - failed) << " of " << metrics.size() << " jobs in " << totalMs << " ms";
+
+    if (failed > 0) {
+        ret = make_ret(Err::BatchJobFailed);
+    }
+
+    if (!options.reportPath.empty()) {
+        Ret reportRet = writeReport(options.reportPath, metrics, options, totalMs);
+        if (!reportRet) {
+            LOGE() << "failed write batch report, path: " << options.reportPath;
+            if (ret) {
+                ret = reportRet;
+            }
         }
     }
 
     return ret;
 }
 
-mu::Ret ConverterController::fileConvert(const io::path& in, const io::path& out)
+mu::Ret ConverterController::serve(const ServerOptions& options)
+{
+    //! NOTE Loading, layout and painting change global state, so every request is
+    //! converted in its own child process; the worker threads of the server just wait for those.
+    //! The memory reported for a request is the peak of its process.
+    ConverterServer server(options, [this, &options](const io::path& in, const io::path& out) {
+        return convertJobInChildProcess({ in, out }, options.childArguments);
+    });
+
+    return server.run();
+}
+
+std::vector<JobMetrics> ConverterController::runJobs(const BatchJob& batchJob, const BatchOptions& options) const
+{
+    std::vector<JobMetrics> metrics(batchJob.size());
+    if (batchJob.empty()) {
+        return metrics;
+    }
+
+    //! NOTE Loading, layout and painting read and change global state
+    //! (MScore::pixelRatio, the printing flags, the image store), so the jobs
+    //! of one process run one after another. Jobs run at the same time only in
+    //! separate processes; the worker threads here just wait for those.
+    if (!isolatedJobs(options)) {
+        size_t index = 0;
+        for (const Job& job : batchJob) {
+            metrics[index++] = convertJob(job, options.convert);
+        }
+        return metrics;
+    }
+
+    QThreadPool pool;
+    pool.setMaxThreadCount(std::max(1, options.workers));
+
+    size_t index = 0;
+    for (const Job& job : batchJob) {
+        JobMetrics* result = &metrics[index++];
+        pool.start([this, result, &job, &options]() {
+            *result = convertJobInChildProcess(job, options.childArguments);
+        });
+    }
+
+    pool.waitForDone();
+
+    return metrics;
+}
+
+bool ConverterController::isolatedJobs(const BatchOptions& options)
+{
+    return options.isolateProcesses || options.workers > 1;
+}
+
+JobMetrics ConverterController::convertJob(const Job& job, const ConvertOptions& options) const
+{
+    JobMetrics metrics;
+    metrics.in = job.in;
+    metrics.out = job.out;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    Ret ret = convert(job.in, job.out, options, metrics);
+
+    metrics.totalMs = elapsedMs(timer);
+    metrics.errorCode = ret ? 0 : ret.code();
+    metrics.errorText = ret ? std::string() : ret.toString();
+    metrics.peakRssKb = peakRssKb();
+
+    return metrics;
+}
+
+JobMetrics ConverterController::convertJobInChildProcess(const Job& job, const std::vector<std::string>& childArguments) const
+{
+    JobMetrics metrics;
+    metrics.in = job.in;
+    metrics.out = job.out;
+
+    auto fail = [&metrics](const std::string& text) {
+        metrics.errorCode = int(Err::WorkerProcessFailed);
+        metrics.errorText = text;
+        return metrics;
+    };
+
+    QTemporaryDir tmpDir;
+    if (!tmpDir.isValid()) {
+        return fail("failed create temporary directory");
+    }
+
+    //! NOTE The child runs the same batch code path on a single job and reports back through a report file
+    QString jobPath = tmpDir.filePath("job.json");
+    QString reportPath = tmpDir.filePath("report.json");
+
+    QJsonObject jobObj;
+    jobObj["in"] = job.in.toQString();
+    jobObj["out"] = job.out.toQString();
+
+    QFile jobFile(jobPath);
+    if (!jobFile.open(QIODevice::WriteOnly)) {
+        return fail("failed write job file");
+    }
+    jobFile.write(QJsonDocument(QJsonArray { jobObj }).toJson(QJsonDocument::Compact));
+    jobFile.close();
+
+    QStringList args;
+    for (const std::string& arg : childArguments) {
+        args << QString::fromStdString(arg);
+    }
+    args << "-j" << jobPath << "--job-report" << reportPath;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QProcess process;
+    //! NOTE In the server's stdin mode stdout carries the responses, only the log of the child is passed on
+    process.setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    process.setStandardOutputFile(QProcess::nullDevice());
+    process.start(QCoreApplication::applicationFilePath(), args);
+    process.waitForFinished(-1);
+
+    double totalMs = elapsedMs(timer);
+
+    RetVal<std::vector<JobMetrics> > report = readReport(reportPath);
+    if (!report.ret || report.val.empty()) {
+        return fail("worker process failed, exit code: " + std::to_string(process.exitCode()));
+    }
+
+    metrics = report.val.front();
+    //! NOTE Includes the start-up of the child process
+    metrics.totalMs = totalMs;
+
+    return metrics;
+}
+
+mu::Ret ConverterController::fileConvert(const io::path& in, const io::path& out, const ConvertOptions& options)
+{
+    JobMetrics metrics;
+    return convert(in, out, options, metrics);
+}
+
+mu::Ret ConverterController::convert(const io::path& in, const io::path& out, const ConvertOptions& options,
+                                     JobMetrics& metrics) const
 {
     TRACEFUNC;
     LOGI() << "in: " << in << ", out: " << out;
@@ -65,18 +265,44 @@ mu::Ret ConverterController::fileConvert(const io::path& in, const io::path& out
         return make_ret(Err::ConvertTypeUnknown);
     }
 
+    QElapsedTimer timer;
+    timer.start();
+
     Ret ret = notation->load(in);
     if (!ret) {
         LOGE() << "failed load notation, err: " << ret.toString() << ", path: " << in;
         return make_ret(Err::InFileFailedLoad);
     }
 
+    metrics.loadMs = elapsedMs(timer);
+
+    timer.restart();
+
+    //! NOTE Image formats hold one page, a score with more pages is written to one file per page if asked for
+    if (options.allPages && (suffix == "png" || suffix == "svg") && notation->elements()->msScore()->npages() > 1) {
+        ret = convertPageByPage(writer, notation, out);
+    } else {
+        ret = convertFile(writer, notation, out);
+    }
+
+    if (!ret) {
+        return ret;
+    }
+
+    metrics.exportMs = elapsedMs(timer);
+
+    return make_ret(Ret::Code::Ok);
+}
+
+mu::Ret ConverterController::convertFile(notation::INotationWriterPtr writer, notation::INotationPtr notation,
+                                         const io::path& out) const
+{
     QFile file(out.toQString());
     if (!file.open(QFile::WriteOnly)) {
         return make_ret(Err::OutFileFailedOpen);
     }
 
-    ret = writer->write(notation, file);
+    Ret ret = writer->write(notation, file);
     if (!ret) {
         LOGE() << "failed write, err: " << ret.toString() << ", path: " << out;
         return make_ret(Err::OutFileFailedWrite);
@@ -87,6 +313,38 @@ mu::Ret ConverterController::fileConvert(const io::path& in, const io::path& out
     return make_ret(Ret::Code::Ok);
 }
 
+mu::Ret ConverterController::convertPageByPage(notation::INotationWriterPtr writer, notation::INotationPtr notation,
+                                               const io::path& out) const
+{
+    std::string suffix = io::syffix(out);
+    QString basePath = out.toQString();
+    basePath.chop(static_cast<int>(suffix.size()) + 1);
+
+    int pageCount = notation->elements()->msScore()->npages();
+
+    std::vector<std::unique_ptr<QFile> > files;
+    std::vector<system::IODevice*> devices;
+    for (int i = 0; i < pageCount; ++i) {
+        //! NOTE Same naming as MuseScore 3: score-1.png, score-2.png, ...
+        QString pagePath = QString("%1-%2.%3").arg(basePath).arg(i + 1).arg(QString::fromStdString(suffix));
+        auto file = std::make_unique<QFile>(pagePath);
+        if (!file->open(QFile::WriteOnly)) {
+            LOGE() << "failed open, path: " << pagePath;
+            return make_ret(Err::OutFileFailedOpen);
+        }
+        devices.push_back(file.get());
+        files.push_back(std::move(file));
+    }
+
+    Ret ret = writer->writePages(notation, devices);
+    if (!ret) {
+        LOGE() << "failed write pages, err: " << ret.toString() << ", path: " << out;
+        return make_ret(Err::OutFileFailedWrite);
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
+
 mu::RetVal<ConverterController::BatchJob> ConverterController::parseBatchJob(const io::path& batchJobFile) const
 {
     RetVal<BatchJob> rv;
@@ -121,3 +379,78 @@ mu::RetVal<ConverterController::BatchJob> ConverterController::parseBatchJob(con
     rv.ret = make_ret(Ret::Code::Ok);
     return rv;
 }
+
+mu::Ret ConverterController::writeReport(const io::path& reportPath, const std::vector<JobMetrics>& metrics,
+                                         const BatchOptions& options, double totalMs) const
+{
+    QJsonArray jobs;
+    int failed = 0;
+    for (const JobMetrics& m : metrics) {
+        QJsonObject obj;
+        obj["in"] = m.in.toQString();
+        obj["out"] = m.out.toQString();
+        obj["success"] = m.success();
+        if (!m.success()) {
+            obj["errorCode"] = m.errorCode;
+            obj["errorText"] = QString::fromStdString(m.errorText);
+            ++failed;
+        }
+        obj["loadMs"] = m.loadMs;
+        obj["exportMs"] = m.exportMs;
+        obj["totalMs"] = m.totalMs;
+        obj["peakRssKb"] = double(m.peakRssKb);
+        jobs.append(obj);
+    }
+
+    QJsonObject root;
+    root["workers"] = options.workers;
+    root["isolateProcesses"] = isolatedJobs(options);
+    root["totalMs"] = totalMs;
+    root["failed"] = failed;
+    root["peakRssKb"] = double(peakRssKb());
+    root["jobs"] = jobs;
+
+    QFile file(reportPath.toQString());
+    if (!file.open(QIODevice::WriteOnly)) {
+        return make_ret(Err::BatchReportFailedWrite);
+    }
+
+    file.write(QJsonDocument(root).toJson());
+    return make_ret(Ret::Code::Ok);
+}
+
+mu::RetVal<std::vector<JobMetrics> > ConverterController::readReport(const io::path& reportPath) const
+{
+    RetVal<std::vector<JobMetrics> > rv;
+    QFile file(reportPath.toQString());
+    if (!file.open(QIODevice::ReadOnly)) {
+        rv.ret = make_ret(Err::BatchJobFileFailedOpen);
+        return rv;
+    }
+
+    QJsonParseError err;
+    QJsonDocument doc = QJsonDocument::fromJson(file.readAll(), &err);
+    if (err.error != QJsonParseError::NoError || !doc.isObject()) {
+        rv.ret = make_ret(Err::BatchJobFileFailedParse, err.errorString().toStdString());
+        return rv;
+    }
+
+    for (const QJsonValue v : doc.object().value("jobs").toArray()) {
+        QJsonObject obj = v.toObject();
+
+        JobMetrics m;
+        m.in = obj["in"].toString();
+        m.out = obj["out"].toString();
+        m.errorCode = obj["errorCode"].toInt();
+        m.errorText = obj["errorText"].toString().toStdString();
+        m.loadMs = obj["loadMs"].toDouble();
+        m.exportMs = obj["exportMs"].toDouble();
+        m.totalMs = obj["totalMs"].toDouble();
+        m.peakRssKb = static_cast<long long>(obj["peakRssKb"].toDouble());
+
+        rv.val.push_back(std::move(m));
+    }
+
+    rv.ret = make_ret(Ret::Code::Ok);
+    return rv;
+}
@@ -20,6 +20,7 @@
 #define MU_CONVERTER_CONVERTERCONTROLLER_H
 
 #include <list>
+#include <vector>
 
 #include "../iconvertercontroller.h"
 
@@ -38,8 +39,9 @@ class ConverterController : public IConverterController
 public:
     ConverterController() = default;
 
-    Ret fileConvert(const io::path& in, const io::path& out) override;
-    Ret batchConvert(const io::path& batchJobFile) override;
+    Ret fileConvert(const io::path& in, const io::path& out, const ConvertOptions& options) override;
+    Ret batchConvert(const io::path& batchJobFile, const BatchOptions& options) override;
+    Ret serve(const ServerOptions& options) override;
 
 private:
 
@@ -51,6 +53,19 @@ private:
     using BatchJob = std::list<Job>;
 
     RetVal<BatchJob> parseBatchJob(const io::path& batchJobFile) const;
+
+    Ret convert(const io::path& in, const io::path& out, const ConvertOptions& options, JobMetrics& metrics) const;
+    Ret convertFile(notation::INotationWriterPtr writer, notation::INotationPtr notation, const io::path& out) const;
+    Ret convertPageByPage(notation::INotationWriterPtr writer, notation::INotationPtr notation, const io::path& out) const;
+
+    JobMetrics convertJob(const Job& job, const ConvertOptions& options) const;
+    JobMetrics convertJobInChildProcess(const Job& job, const std::vector<std::string>& childArguments) const;
+    std::vector<JobMetrics> runJobs(const BatchJob& batchJob, const BatchOptions& options) const;
+    static bool isolatedJobs(const BatchOptions& options);
+
+    Ret writeReport(const io::path& reportPath, const std::vector<JobMetrics>& metrics, const BatchOptions& options,
+                    double totalMs) const;
+    RetVal<std::vector<JobMetrics> > readReport(const io::path& reportPath) const;
 };
 }
 
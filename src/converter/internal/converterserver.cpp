@@ -0,0 +1,356 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "converterserver.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include <QCoreApplication>
+#include <QEventLoop>
+#include <QJsonDocument>
+#include <QJsonParseError>
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QPointer>
+
+#include "log.h"
+#include "convertercodes.h"
+
+using namespace mu::converter;
+
+static double elapsedMs(const QElapsedTimer& timer)
+{
+    return timer.nsecsElapsed() / 1000000.0;
+}
+
+static QByteArray toLine(const QJsonObject& obj)
+{
+    return QJsonDocument(obj).toJson(QJsonDocument::Compact);
+}
+
+static int pendingLimit(const ServerOptions& options)
+{
+    if (options.maxPendingJobs > 0) {
+        return options.maxPendingJobs;
+    }
+    return 2 * std::max(1, options.workers);
+}
+
+ConverterServer::ConverterServer(const ServerOptions& options, const ConvertFunc& convert)
+    : m_options(options), m_convert(convert), m_pendingSlots(pendingLimit(options))
+{
+    m_pool.setMaxThreadCount(std::max(1, options.workers));
+}
+
+mu::Ret ConverterServer::run()
+{
+    m_uptime.start();
+
+    Ret ret = m_options.socketName.empty() ? runStdin() : runLocalSocket();
+
+    LatencyStats s = stats();
+    LOGI() << "served " << s.count << " requests, failed: " << s.failed << ", rejected: " << s.rejected
+           << ", latency p50: " << s.p50Ms << " ms, p95: " << s.p95Ms << " ms, max: " << s.maxMs << " ms";
+
+    return ret;
+}
+
+mu::Ret ConverterServer::runStdin()
+{
+    //! NOTE The log goes to stderr, so stdout only carries the responses
+    std::mutex outMutex;
+    Reply reply = [&outMutex](const QByteArray& data) {
+        std::lock_guard<std::mutex> lock(outMutex);
+        std::fwrite(data.constData(), 1, data.size(), stdout);
+        std::fputc('\n', stdout);
+        std::fflush(stdout);
+    };
+
+    std::string line;
+    while (std::getline(std::cin, line)) {
+        //! NOTE Nothing else runs on this thread, waiting for a slot holds back the client
+        if (!handleRequest(QByteArray::fromStdString(line), reply, true)) {
+            break;
+        }
+    }
+
+    waitForPending();
+
+    return make_ret(Ret::Code::Ok);
+}
+
+mu::Ret ConverterServer::runLocalSocket()
+{
+    QString name = QString::fromStdString(m_options.socketName);
+
+    //! NOTE Removes a socket file left over by a server that was not shut down properly
+    QLocalServer::removeServer(name);
+
+    QLocalServer server;
+    if (!server.listen(name)) {
+        LOGE() << "failed listen, name: " << name << ", err: " << server.errorString();
+        return make_ret(Err::ServerFailedListen, server.errorString().toStdString());
+    }
+
+    LOGI() << "listening on " << server.fullServerName();
+
+    QEventLoop loop;
+
+    QObject::connect(&server, &QLocalServer::newConnection, &server, [this, &server, &loop]() {
+        while (QLocalSocket* socket = server.nextPendingConnection()) {
+            QPointer<QLocalSocket> guard(socket);
+
+            //! NOTE Called from the workers, the socket is only touched on the thread it lives on
+            Reply reply = [&server, guard](const QByteArray& data) {
+                QMetaObject::invokeMethod(&server, [guard, data]() {
+                    if (guard) {
+                        guard->write(data);
+                        guard->write("\n");
+                    }
+                }, Qt::QueuedConnection);
+            };
+
+            QObject::connect(socket, &QLocalSocket::readyRead, socket, [this, socket, reply, &loop]() {
+                //! NOTE Runs in the event loop which also delivers the responses, it must not wait
+                while (socket->canReadLine()) {
+                    if (!handleRequest(socket->readLine(), reply, false)) {
+                        loop.quit();
+                        return;
+                    }
+                }
+            });
+
+            QObject::connect(socket, &QLocalSocket::disconnected, socket, &QObject::deleteLater);
+        }
+    });
+
+    loop.exec();
+
+    server.close();
+    waitForPending();
+
+    //! NOTE Deliver the responses of the last requests before the sockets go away
+    QCoreApplication::sendPostedEvents(&server);
+    for (QLocalSocket* socket : server.findChildren<QLocalSocket*>()) {
+        if (socket->state() == QLocalSocket::ConnectedState) {
+            socket->waitForBytesWritten(1000);
+        }
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
+
+bool ConverterServer::handleRequest(const QByteArray& line, const Reply& reply, bool waitWhenFull)
+{
+    if (line.trimmed().isEmpty()) {
+        return true;
+    }
+
+    auto fail = [&reply](const QJsonValue& id, const QString& text, Err code = Err::ServerRequestFailedParse) {
+        QJsonObject resp;
+        resp["id"] = id;
+        resp["success"] = false;
+        resp["errorCode"] = int(code);
+        resp["errorText"] = text;
+        reply(toLine(resp));
+    };
+
+    QJsonParseError err;
+    QJsonDocument doc = QJsonDocument::fromJson(line, &err);
+    if (err.error != QJsonParseError::NoError || !doc.isObject()) {
+        fail(QJsonValue(), err.errorString());
+        return true;
+    }
+
+    QJsonObject req = doc.object();
+    QJsonValue id = req.value("id");
+    QString cmd = req.value("cmd").toString();
+
+    if (cmd == "stats") {
+        QJsonObject resp = statsObject();
+        resp["id"] = id;
+        resp["success"] = true;
+        reply(toLine(resp));
+        return true;
+    }
+
+    if (cmd == "quit") {
+        QJsonObject resp;
+        resp["id"] = id;
+        resp["success"] = true;
+        reply(toLine(resp));
+        return false;
+    }
+
+    if (!cmd.isEmpty()) {
+        fail(id, "unknown cmd: " + cmd);
+        return true;
+    }
+
+    io::path in = req.value("in").toString();
+    io::path out = req.value("out").toString();
+    if (in.empty() || out.empty()) {
+        fail(id, "both \"in\" and \"out\" are required");
+        return true;
+    }
+
+    if (!submit(id, in, out, reply, waitWhenFull)) {
+        fail(id, QString("too many pending requests, limit: %1").arg(pendingLimit(m_options)), Err::ServerQueueFull);
+    }
+    return true;
+}
+
+bool ConverterServer::submit(const QJsonValue& id, const io::path& in, const io::path& out, const Reply& reply,
+                             bool waitWhenFull)
+{
+    QElapsedTimer received;
+    received.start();
+
+    auto job = [this, id, in, out, reply, received]() {
+        double queueMs = elapsedMs(received);
+
+        JobMetrics metrics = m_convert(in, out);
+
+        double latencyMs = elapsedMs(received);
+        addSample(latencyMs, metrics.success());
+
+        QJsonObject resp;
+        resp["id"] = id;
+        resp["success"] = metrics.success();
+        if (!metrics.success()) {
+            resp["errorCode"] = metrics.errorCode;
+            resp["errorText"] = QString::fromStdString(metrics.errorText);
+        }
+        resp["queueMs"] = queueMs;
+        resp["loadMs"] = metrics.loadMs;
+        resp["exportMs"] = metrics.exportMs;
+        resp["totalMs"] = metrics.totalMs;
+        resp["latencyMs"] = latencyMs;
+        resp["peakRssKb"] = double(metrics.peakRssKb);
+        reply(toLine(resp));
+
+        m_pendingSlots.release();
+    };
+
+    if (waitWhenFull) {
+        //! NOTE The waiting time is a part of the latency
+        m_pendingSlots.acquire();
+    } else if (!m_pendingSlots.tryAcquire()) {
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        ++m_rejected;
+        return false;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        ++m_pending;
+    }
+
+    m_pool.start(job);
+    return true;
+}
+
+void ConverterServer::waitForPending()
+{
+    m_pool.waitForDone();
+}
+
+void ConverterServer::addSample(double latencyMs, bool success)
+{
+    std::lock_guard<std::mutex> lock(m_statsMutex);
+
+    ++m_count;
+    --m_pending;
+    if (!success) {
+        ++m_failed;
+    }
+
+    m_latencies.push_back(latencyMs);
+    while (static_cast<int>(m_latencies.size()) > std::max(1, m_options.latencyWindow)) {
+        m_latencies.pop_front();
+    }
+}
+
+ConverterServer::LatencyStats ConverterServer::stats() const
+{
+    LatencyStats s;
+    std::vector<double> latencies;
+    {
+        std::lock_guard<std::mutex> lock(m_statsMutex);
+        s.count = m_count;
+        s.failed = m_failed;
+        s.rejected = m_rejected;
+        s.pending = m_pending;
+        latencies.assign(m_latencies.begin(), m_latencies.end());
+    }
+
+    if (latencies.empty()) {
+        return s;
+    }
+
+    std::sort(latencies.begin(), latencies.end());
+
+    // nearest rank
+    auto percentile = [&latencies](double p) {
+        size_t rank = static_cast<size_t>(std::ceil(p * latencies.size()));
+        return latencies[std::min(std::max<size_t>(rank, 1), latencies.size()) - 1];
+    };
+
+    double sum = 0.0;
+    for (double ms : latencies) {
+        sum += ms;
+    }
+
+    s.minMs = latencies.front();
+    s.avgMs = sum / latencies.size();
+    s.p50Ms = percentile(0.50);
+    s.p95Ms = percentile(0.95);
+    s.p99Ms = percentile(0.99);
+    s.maxMs = latencies.back();
+
+    return s;
+}
+
+QJsonObject ConverterServer::statsObject() const
+{
+    LatencyStats s = stats();
+
+    QJsonObject latency;
+    latency["min"] = s.minMs;
+    latency["avg"] = s.avgMs;
+    latency["p50"] = s.p50Ms;
+    latency["p95"] = s.p95Ms;
+    latency["p99"] = s.p99Ms;
+    latency["max"] = s.maxMs;
+
+    QJsonObject obj;
+    obj["count"] = s.count;
+    obj["failed"] = s.failed;
+    obj["rejected"] = s.rejected;
+    obj["pending"] = s.pending;
+    obj["workers"] = m_pool.maxThreadCount();
+    obj["maxPendingJobs"] = pendingLimit(m_options);
+    obj["uptimeMs"] = elapsedMs(m_uptime);
+    obj["latencyMs"] = latency;
+    return obj;
+}
@@ -0,0 +1,104 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_CONVERTER_CONVERTERSERVER_H
+#define MU_CONVERTER_CONVERTERSERVER_H
+
+#include <deque>
+#include <functional>
+#include <mutex>
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QJsonObject>
+#include <QSemaphore>
+#include <QThreadPool>
+
+#include "ret.h"
+#include "io/path.h"
+
+#include "../convertertypes.h"
+
+namespace mu::converter {
+//! Long-lived conversion service.
+//! Requests are JSON lines, one object per line:
+//!   { "id": <any>, "in": "score.mscz", "out": "score.pdf" } - converts, the format depends on the suffix of "out"
+//!   { "id": <any>, "cmd": "stats" } - replies with the latency statistics
+//!   { "id": <any>, "cmd": "quit" } - stops reading, answers the pending requests and returns
+//! Every request is answered with one JSON line carrying the same "id".
+//! Responses to conversions come in the order they finish, not in the order of the requests.
+//! A conversion requested over the local socket while maxPendingJobs are pending is
+//! answered at once with the error ServerQueueFull, the client retries it later.
+class ConverterServer
+{
+public:
+    //! Called on the worker threads, several at a time
+    using ConvertFunc = std::function<JobMetrics(const io::path& in, const io::path& out)>;
+
+    ConverterServer(const ServerOptions& options, const ConvertFunc& convert);
+
+    Ret run();
+
+    struct LatencyStats {
+        int count = 0;
+        int failed = 0;
+        int rejected = 0;
+        int pending = 0;
+        //! NOTE Latency is counted from reading the request to writing the response
+        double minMs = 0.0;
+        double avgMs = 0.0;
+        double p50Ms = 0.0;
+        double p95Ms = 0.0;
+        double p99Ms = 0.0;
+        double maxMs = 0.0;
+    };
+
+    LatencyStats stats() const;
+
+private:
+    using Reply = std::function<void (const QByteArray&)>;
+
+    Ret runStdin();
+    Ret runLocalSocket();
+
+    //! Returns false on a quit request.
+    //! If waitWhenFull, waits for a free slot, otherwise rejects the request
+    bool handleRequest(const QByteArray& line, const Reply& reply, bool waitWhenFull);
+    bool submit(const QJsonValue& id, const io::path& in, const io::path& out, const Reply& reply, bool waitWhenFull);
+    void addSample(double latencyMs, bool success);
+    void waitForPending();
+
+    QJsonObject statsObject() const;
+
+    ServerOptions m_options;
+    ConvertFunc m_convert;
+
+    QThreadPool m_pool;
+    QSemaphore m_pendingSlots;
+
+    mutable std::mutex m_statsMutex;
+    std::deque<double> m_latencies;
+    int m_count = 0;
+    int m_failed = 0;
+    int m_rejected = 0;
+    int m_pending = 0;
+    QElapsedTimer m_uptime;
+};
+}
+
+#endif // MU_CONVERTER_CONVERTERSERVER_H
@@ -0,0 +1,205 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <thread>
+
+#include <QCoreApplication>
+#include <QJsonDocument>
+#include <QJsonObject>
+#include <QLocalSocket>
+#include <QSemaphore>
+
+#include "converter/convertercodes.h"
+#include "converter/internal/converterserver.h"
+
+using namespace mu;
+using namespace mu::converter;
+
+class ConverterServerTest : public ::testing::Test
+{
+protected:
+    //! Runs the server on its own thread, as the event loop of the socket mode blocks
+    void startServer(const ServerOptions& options, const ConverterServer::ConvertFunc& convert)
+    {
+        m_server = std::make_unique<ConverterServer>(options, convert);
+        m_thread = std::thread([this]() {
+            m_ret = m_server->run();
+        });
+
+        QString name = QString::fromStdString(options.socketName);
+        for (int attempt = 0; attempt < 100; ++attempt) {
+            m_socket.connectToServer(name);
+            if (m_socket.waitForConnected(100)) {
+                return;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        }
+    }
+
+    void TearDown() override
+    {
+        //! NOTE Only if a test failed before stopping the server, which is then left running
+        if (m_thread.joinable()) {
+            m_thread.detach();
+            m_server.release();
+        }
+    }
+
+    void stopServer()
+    {
+        send(R"({ "id": "quit", "cmd": "quit" })");
+        QJsonObject resp = readReply();
+        EXPECT_EQ(resp.value("id").toString(), "quit");
+
+        m_thread.join();
+        EXPECT_TRUE(m_ret.success());
+    }
+
+    void send(const QByteArray& line)
+    {
+        m_socket.write(line + "\n");
+        m_socket.waitForBytesWritten(1000);
+    }
+
+    QJsonObject readReply()
+    {
+        while (!m_socket.canReadLine()) {
+            if (!m_socket.waitForReadyRead(5000)) {
+                return QJsonObject();
+            }
+        }
+        return QJsonDocument::fromJson(m_socket.readLine()).object();
+    }
+
+    static std::string socketName(const char* test)
+    {
+        return QString("mu_converter_test_%1_%2").arg(QCoreApplication::applicationPid()).arg(test).toStdString();
+    }
+
+    std::unique_ptr<ConverterServer> m_server;
+    std::thread m_thread;
+    Ret m_ret;
+    QLocalSocket m_socket;
+};
+
+TEST_F(ConverterServerTest, RoundTrip)
+{
+    ServerOptions options;
+    options.socketName = socketName("roundtrip");
+    options.workers = 2;
+
+    startServer(options, [](const io::path& in, const io::path& out) {
+        JobMetrics metrics;
+        metrics.in = in;
+        metrics.out = out;
+        if (in == io::path("missing.mscz")) {
+            metrics.errorCode = int(Err::InFileFailedLoad);
+            metrics.errorText = "not found";
+        }
+        metrics.loadMs = 2.0;
+        metrics.exportMs = 3.0;
+        metrics.totalMs = 5.0;
+        return metrics;
+    });
+    ASSERT_EQ(m_socket.state(), QLocalSocket::ConnectedState);
+
+    //! CASE A conversion is answered with the id of the request and the metrics
+    send(R"({ "id": "a", "in": "score.mscz", "out": "score.pdf" })");
+    QJsonObject resp = readReply();
+    EXPECT_EQ(resp.value("id").toString(), "a");
+    EXPECT_TRUE(resp.value("success").toBool());
+    EXPECT_EQ(resp.value("loadMs").toDouble(), 2.0);
+    EXPECT_EQ(resp.value("exportMs").toDouble(), 3.0);
+    EXPECT_EQ(resp.value("totalMs").toDouble(), 5.0);
+    EXPECT_TRUE(resp.contains("latencyMs"));
+
+    //! CASE A failed conversion carries its error
+    send(R"({ "id": 2, "in": "missing.mscz", "out": "missing.pdf" })");
+    resp = readReply();
+    EXPECT_EQ(resp.value("id").toInt(), 2);
+    EXPECT_FALSE(resp.value("success").toBool());
+    EXPECT_EQ(resp.value("errorCode").toInt(), int(Err::InFileFailedLoad));
+    EXPECT_EQ(resp.value("errorText").toString(), "not found");
+
+    //! CASE A request which is not JSON
+    send("not json");
+    resp = readReply();
+    EXPECT_FALSE(resp.value("success").toBool());
+    EXPECT_EQ(resp.value("errorCode").toInt(), int(Err::ServerRequestFailedParse));
+
+    //! CASE The statistics count both conversions
+    send(R"({ "id": "s", "cmd": "stats" })");
+    resp = readReply();
+    EXPECT_EQ(resp.value("id").toString(), "s");
+    EXPECT_EQ(resp.value("count").toInt(), 2);
+    EXPECT_EQ(resp.value("failed").toInt(), 1);
+
+    stopServer();
+}
+
+TEST_F(ConverterServerTest, FullQueue)
+{
+    ServerOptions options;
+    options.socketName = socketName("fullqueue");
+    options.workers = 1;
+    options.maxPendingJobs = 1;
+
+    QSemaphore gate;
+    startServer(options, [&gate](const io::path& in, const io::path& out) {
+        if (in == io::path("slow.mscz")) {
+            gate.acquire();
+        }
+        JobMetrics metrics;
+        metrics.in = in;
+        metrics.out = out;
+        return metrics;
+    });
+    ASSERT_EQ(m_socket.state(), QLocalSocket::ConnectedState);
+
+    //! CASE The slow request takes the only slot, the next one is rejected at once
+    send(R"({ "id": 1, "in": "slow.mscz", "out": "slow.pdf" })"
+         "\n"
+         R"({ "id": 2, "in": "fast.mscz", "out": "fast.pdf" })");
+
+    QJsonObject resp = readReply();
+    EXPECT_EQ(resp.value("id").toInt(), 2);
+    EXPECT_FALSE(resp.value("success").toBool());
+    EXPECT_EQ(resp.value("errorCode").toInt(), int(Err::ServerQueueFull));
+
+    //! CASE The server still answers while the slot is taken
+    send(R"({ "id": "s", "cmd": "stats" })");
+    resp = readReply();
+    EXPECT_EQ(resp.value("id").toString(), "s");
+    EXPECT_EQ(resp.value("pending").toInt(), 1);
+    EXPECT_EQ(resp.value("rejected").toInt(), 1);
+
+    gate.release();
+    resp = readReply();
+    EXPECT_EQ(resp.value("id").toInt(), 1);
+    EXPECT_TRUE(resp.value("success").toBool());
+
+    stopServer();
+
+    ConverterServer::LatencyStats stats = m_server->stats();
+    EXPECT_EQ(stats.count, 1);
+    EXPECT_EQ(stats.rejected, 1);
+    EXPECT_EQ(stats.pending, 0);
+}
@@ -21,6 +21,7 @@
 #define MU_FRAMEWORK_IMODULESETUP_H
 
 #include <string>
+#include <vector>
 #include "../iapplication.h"
 
 namespace mu::framework {
@@ -42,6 +43,17 @@ public:
     virtual void onDeinit() {}
 
     virtual void onStartApp() {}
+
+    //! Called after the first frame of the main window has been shown,
+    //! for work that is not needed to show it
+    virtual void onDelayedInit() {}
+
+    //! Names of the modules whose onInit must be finished before onInit of this module
+    virtual std::vector<std::string> initDependencies() const { return {}; }
+
+    //! onInit of this module does not touch the ui and only uses thread safe services,
+    //! so it may run on a worker thread in parallel with other modules
+    virtual bool isInitThreadSafe() const { return false; }
 };
 }
 
@@ -3,6 +3,8 @@ set (MODULARITY_SRC
     ${CMAKE_CURRENT_LIST_DIR}/imodulesetup.h
     ${CMAKE_CURRENT_LIST_DIR}/modulesioc.cpp
     ${CMAKE_CURRENT_LIST_DIR}/modulesioc.h
+    ${CMAKE_CURRENT_LIST_DIR}/modulessetuprunner.cpp
+    ${CMAKE_CURRENT_LIST_DIR}/modulessetuprunner.h
     ${CMAKE_CURRENT_LIST_DIR}/imoduleexport.h
     ${CMAKE_CURRENT_LIST_DIR}/ioc.h
 )
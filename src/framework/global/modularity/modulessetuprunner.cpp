@@ -0,0 +1,243 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "modulessetuprunner.h"
+
+#include <condition_variable>
+#include <set>
+
+#include <QFile>
+#include <QJsonArray>
+#include <QJsonDocument>
+#include <QJsonObject>
+#ifndef Q_OS_WASM
+#include <QThreadPool>
+#endif
+
+#include "log.h"
+
+using namespace mu::framework;
+
+ModulesSetupRunner::ModulesSetupRunner()
+    : m_ownerThreadId(std::this_thread::get_id())
+{
+    m_timer.start();
+}
+
+//! NOTE Must be called with m_mutex locked
+int ModulesSetupRunner::currentThreadIndex() const
+{
+    std::thread::id id = std::this_thread::get_id();
+    if (id == m_ownerThreadId) {
+        return 0;
+    }
+
+    auto it = m_threadIndexes.find(id);
+    if (it != m_threadIndexes.end()) {
+        return it->second;
+    }
+
+    int index = static_cast<int>(m_threadIndexes.size()) + 1;
+    m_threadIndexes.insert({ id, index });
+    return index;
+}
+
+void ModulesSetupRunner::measure(const std::string& module, const std::string& phase, const std::function<void()>& func)
+{
+    qint64 startUs = m_timer.nsecsElapsed() / 1000;
+    func();
+    qint64 endUs = m_timer.nsecsElapsed() / 1000;
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_timings.push_back({ module, phase, currentThreadIndex(), startUs, endUs - startUs });
+}
+
+void ModulesSetupRunner::run(const std::vector<IModuleSetup*>& modules, const std::string& phase,
+                             const std::function<void(IModuleSetup*)>& func)
+{
+    for (IModuleSetup* m : modules) {
+        measure(m->moduleName(), phase, [m, &func]() { func(m); });
+    }
+}
+
+void ModulesSetupRunner::init(const std::vector<IModuleSetup*>& modules, const IApplication::RunMode& mode)
+{
+    std::map<std::string, IModuleSetup*> byName;
+    for (IModuleSetup* m : modules) {
+        byName[m->moduleName()] = m;
+    }
+
+    std::map<IModuleSetup*, std::vector<IModuleSetup*> > dependencies;
+    for (IModuleSetup* m : modules) {
+        for (const std::string& name : m->initDependencies()) {
+            auto it = byName.find(name);
+            if (it == byName.end()) {
+                LOGW() << m->moduleName() << ": unknown init dependency " << name;
+                continue;
+            }
+            dependencies[m].push_back(it->second);
+        }
+    }
+
+    auto isThreadSafe = [](IModuleSetup* m) {
+#ifndef Q_OS_WASM
+        return m->isInitThreadSafe();
+#else
+        (void)m;
+        return false;
+#endif
+    };
+
+    std::mutex mutex;
+    std::condition_variable finished;
+    std::set<IModuleSetup*> started;
+    std::set<IModuleSetup*> done;
+    int running = 0;
+
+    auto isReady = [&](IModuleSetup* m) {
+        for (IModuleSetup* d : dependencies[m]) {
+            if (done.find(d) == done.end()) {
+                return false;
+            }
+        }
+        return true;
+    };
+
+    auto initModule = [this, mode](IModuleSetup* m) {
+        measure(m->moduleName(), "onInit", [m, mode]() { m->onInit(mode); });
+    };
+
+    // called with the mutex locked
+    auto startReadyThreadSafe = [&]() {
+#ifndef Q_OS_WASM
+        for (IModuleSetup* m : modules) {
+            if (!isThreadSafe(m) || started.count(m) || !isReady(m)) {
+                continue;
+            }
+            started.insert(m);
+            ++running;
+            QThreadPool::globalInstance()->start([&, m]() {
+                initModule(m);
+                std::lock_guard<std::mutex> lock(mutex);
+                done.insert(m);
+                --running;
+                finished.notify_all();
+            });
+        }
+#endif
+    };
+
+    auto initOnCallingThread = [&](std::unique_lock<std::mutex>& lock, IModuleSetup* m) {
+        started.insert(m);
+        lock.unlock();
+        initModule(m);
+        lock.lock();
+        done.insert(m);
+    };
+
+    std::unique_lock<std::mutex> lock(mutex);
+
+    for (IModuleSetup* m : modules) {
+        startReadyThreadSafe();
+        if (isThreadSafe(m)) {
+            continue;
+        }
+
+        while (!isReady(m)) {
+            if (running == 0) {
+                // can not be satisfied: a cycle or a dependency on a module registered later
+                LOGE() << m->moduleName() << ": unresolved init dependencies, init anyway";
+                break;
+            }
+            finished.wait(lock);
+            startReadyThreadSafe();
+        }
+
+        initOnCallingThread(lock, m);
+    }
+
+    while (done.size() < modules.size()) {
+        startReadyThreadSafe();
+        if (running > 0) {
+            finished.wait(lock);
+            continue;
+        }
+
+        for (IModuleSetup* m : modules) {
+            if (!started.count(m)) {
+                LOGE() << m->moduleName() << ": unresolved init dependencies, init anyway";
+                initOnCallingThread(lock, m);
+                break;
+            }
+        }
+    }
+}
+
+std::vector<ModulesSetupRunner::Timing> ModulesSetupRunner::timings() const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_timings;
+}
+
+qint64 ModulesSetupRunner::phaseDurationUs(const std::string& phase) const
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    qint64 begin = -1;
+    qint64 end = 0;
+    for (const Timing& t : m_timings) {
+        if (t.phase != phase) {
+            continue;
+        }
+        if (begin < 0 || t.startUs < begin) {
+            begin = t.startUs;
+        }
+        end = std::max(end, t.startUs + t.durationUs);
+    }
+
+    return begin < 0 ? 0 : end - begin;
+}
+
+bool ModulesSetupRunner::writeTrace(const QString& filePath) const
+{
+    QJsonArray events;
+    for (const Timing& t : timings()) {
+        QJsonObject event;
+        event["name"] = QString::fromStdString(t.module);
+        event["cat"] = QString::fromStdString(t.phase);
+        event["ph"] = "X";
+        event["pid"] = 0;
+        event["tid"] = t.thread;
+        event["ts"] = t.startUs;
+        event["dur"] = t.durationUs;
+        events.append(event);
+    }
+
+    QJsonObject root;
+    root["traceEvents"] = events;
+    root["displayTimeUnit"] = "ms";
+
+    QFile file(filePath);
+    if (!file.open(QIODevice::WriteOnly)) {
+        LOGE() << "failed open file: " << filePath;
+        return false;
+    }
+
+    file.write(QJsonDocument(root).toJson());
+    return true;
+}
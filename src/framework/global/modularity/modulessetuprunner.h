@@ -0,0 +1,76 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_FRAMEWORK_MODULESSETUPRUNNER_H
+#define MU_FRAMEWORK_MODULESSETUPRUNNER_H
+
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <QElapsedTimer>
+#include <QString>
+
+#include "imodulesetup.h"
+
+namespace mu::framework {
+//! Runs the setup phases of modules and records how long
+//! each module spent in each phase (startup trace).
+//! onInit honours IModuleSetup::initDependencies(): modules that
+//! declare their onInit thread safe run on the global thread pool
+//! as soon as their dependencies are initialized, all other modules
+//! run on the calling thread in registration order.
+class ModulesSetupRunner
+{
+public:
+    struct Timing {
+        std::string module;
+        std::string phase;
+        int thread = 0;         // 0: thread that created the runner
+        qint64 startUs = 0;     // since the runner was created
+        qint64 durationUs = 0;
+    };
+
+    ModulesSetupRunner();
+
+    void run(const std::vector<IModuleSetup*>& modules, const std::string& phase,
+             const std::function<void(IModuleSetup*)>& func);
+    void init(const std::vector<IModuleSetup*>& modules, const IApplication::RunMode& mode);
+    void measure(const std::string& module, const std::string& phase, const std::function<void()>& func);
+
+    std::vector<Timing> timings() const;
+    qint64 phaseDurationUs(const std::string& phase) const;
+
+    //! Writes the timings in the Chrome trace event format
+    bool writeTrace(const QString& filePath) const;
+
+private:
+    int currentThreadIndex() const;
+
+    QElapsedTimer m_timer;
+    std::thread::id m_ownerThreadId;
+    mutable std::map<std::thread::id, int> m_threadIndexes;
+    mutable std::mutex m_mutex;
+    std::vector<Timing> m_timings;
+};
+}
+
+#endif // MU_FRAMEWORK_MODULESSETUPRUNNER_H
@@ -0,0 +1,202 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_FRAMEWORK_SEARCHINDEX_H
+#define MU_FRAMEWORK_SEARCHINDEX_H
+
+#include <QHash>
+#include <QMap>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+namespace mu {
+//! In-memory index for type-to-filter searches.
+//! Every entry has one or more texts (for example the translated
+//! and the untranslated name). The texts are case folded and split
+//! into trigrams, so a query only verifies the entries that share all
+//! of its trigrams instead of scanning all of them.
+//! Entries are inserted, replaced and removed one by one, the index
+//! never needs to be rebuilt as a whole.
+template<typename Key>
+class SearchIndex
+{
+public:
+    void insert(const Key& key, const QStringList& texts)
+    {
+        remove(key);
+
+        QStringList normalized;
+        for (const QString& text : texts) {
+            QString n = normalize(text);
+            if (!n.isEmpty() && !normalized.contains(n)) {
+                normalized << n;
+            }
+        }
+
+        m_texts.insert(key, normalized);
+
+        for (const QString& text : normalized) {
+            m_prefixes[text].insert(key);
+            for (quint64 trigram : trigrams(text)) {
+                m_trigrams[trigram].insert(key);
+            }
+        }
+    }
+
+    void remove(const Key& key)
+    {
+        auto it = m_texts.find(key);
+        if (it == m_texts.end()) {
+            return;
+        }
+
+        for (const QString& text : it.value()) {
+            removeFrom(m_prefixes, text, key);
+            for (quint64 trigram : trigrams(text)) {
+                removeFrom(m_trigrams, trigram, key);
+            }
+        }
+
+        m_texts.erase(it);
+    }
+
+    void clear()
+    {
+        m_texts.clear();
+        m_prefixes.clear();
+        m_trigrams.clear();
+    }
+
+    bool contains(const Key& key) const { return m_texts.contains(key); }
+    int size() const { return m_texts.size(); }
+
+    //! Entries with a text that contains the query, case insensitive
+    QSet<Key> findContaining(const QString& query) const
+    {
+        const QString q = normalize(query);
+        if (q.isEmpty()) {
+            return keys();
+        }
+
+        QSet<Key> result;
+
+        if (q.size() < TRIGRAM_SIZE) {
+            for (auto it = m_texts.cbegin(); it != m_texts.cend(); ++it) {
+                if (containsText(it.value(), q)) {
+                    result.insert(it.key());
+                }
+            }
+            return result;
+        }
+
+        //! NOTE Start from the rarest trigram, the others can only narrow it down
+        const QSet<Key>* candidates = nullptr;
+        for (quint64 trigram : trigrams(q)) {
+            auto it = m_trigrams.constFind(trigram);
+            if (it == m_trigrams.cend()) {
+                return result;
+            }
+            if (!candidates || it.value().size() < candidates->size()) {
+                candidates = &it.value();
+            }
+        }
+
+        for (const Key& key : *candidates) {
+            if (containsText(m_texts.value(key), q)) {
+                result.insert(key);
+            }
+        }
+
+        return result;
+    }
+
+    //! Entries with a text that starts with the query, case insensitive
+    QSet<Key> findStartingWith(const QString& query) const
+    {
+        const QString q = normalize(query);
+        if (q.isEmpty()) {
+            return keys();
+        }
+
+        QSet<Key> result;
+        for (auto it = m_prefixes.lowerBound(q); it != m_prefixes.cend() && it.key().startsWith(q); ++it) {
+            result.unite(it.value());
+        }
+
+        return result;
+    }
+
+private:
+    static constexpr int TRIGRAM_SIZE = 3;
+
+    static QString normalize(const QString& text)
+    {
+        return text.simplified().toCaseFolded();
+    }
+
+    static QSet<quint64> trigrams(const QString& text)
+    {
+        QSet<quint64> result;
+        for (int i = 0; i + TRIGRAM_SIZE <= text.size(); ++i) {
+            result.insert((quint64(text[i].unicode()) << 32)
+                          | (quint64(text[i + 1].unicode()) << 16)
+                          | quint64(text[i + 2].unicode()));
+        }
+        return result;
+    }
+
+    static bool containsText(const QStringList& texts, const QString& q)
+    {
+        for (const QString& text : texts) {
+            if (text.contains(q)) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    template<typename Map, typename MapKey>
+    static void removeFrom(Map& map, const MapKey& mapKey, const Key& key)
+    {
+        auto it = map.find(mapKey);
+        if (it == map.end()) {
+            return;
+        }
+        it.value().remove(key);
+        if (it.value().isEmpty()) {
+            map.erase(it);
+        }
+    }
+
+    QSet<Key> keys() const
+    {
+        QSet<Key> result;
+        for (auto it = m_texts.cbegin(); it != m_texts.cend(); ++it) {
+            result.insert(it.key());
+        }
+        return result;
+    }
+
+    QHash<Key, QStringList> m_texts;
+    QMap<QString, QSet<Key> > m_prefixes;
+    QHash<quint64, QSet<Key> > m_trigrams;
+};
+}
+
+#endif // MU_FRAMEWORK_SEARCHINDEX_H
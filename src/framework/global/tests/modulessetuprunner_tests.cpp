@@ -0,0 +1,143 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+#include <thread>
+
+#include <QThreadPool>
+
+#include "modularity/modulessetuprunner.h"
+
+using namespace mu;
+using namespace mu::framework;
+
+class ModulesSetupRunnerTests : public ::testing::Test
+{
+public:
+    class TestModule : public IModuleSetup
+    {
+    public:
+        TestModule(const std::string& name, std::vector<std::string>& log, std::mutex& logMutex,
+                   bool threadSafe = false, std::vector<std::string> deps = {}, int initMs = 0)
+            : m_name(name), m_log(log), m_logMutex(logMutex), m_threadSafe(threadSafe), m_deps(deps),
+            m_initMs(initMs) {}
+
+        std::string moduleName() const override { return m_name; }
+        std::vector<std::string> initDependencies() const override { return m_deps; }
+        bool isInitThreadSafe() const override { return m_threadSafe; }
+
+        void onInit(const IApplication::RunMode&) override
+        {
+            if (m_initMs > 0) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(m_initMs));
+            }
+            std::lock_guard<std::mutex> lock(m_logMutex);
+            m_log.push_back(m_name);
+        }
+
+    private:
+        std::string m_name;
+        std::vector<std::string>& m_log;
+        std::mutex& m_logMutex;
+        bool m_threadSafe = false;
+        std::vector<std::string> m_deps;
+        int m_initMs = 0;
+    };
+
+    int indexOf(const std::string& name) const
+    {
+        auto it = std::find(m_log.begin(), m_log.end(), name);
+        return it == m_log.end() ? -1 : static_cast<int>(it - m_log.begin());
+    }
+
+    std::vector<std::string> m_log;
+    std::mutex m_logMutex;
+};
+
+TEST_F(ModulesSetupRunnerTests, Init_KeepsRegistrationOrder)
+{
+    //! GIVEN Modules without dependencies, all on the main thread
+    TestModule a("a", m_log, m_logMutex);
+    TestModule b("b", m_log, m_logMutex);
+    TestModule c("c", m_log, m_logMutex);
+
+    //! DO
+    ModulesSetupRunner runner;
+    runner.init({ &a, &b, &c }, IApplication::RunMode::Editor);
+
+    //! CHECK Registration order and one timing per module
+    EXPECT_EQ(m_log, std::vector<std::string>({ "a", "b", "c" }));
+    EXPECT_EQ(runner.timings().size(), 3u);
+}
+
+TEST_F(ModulesSetupRunnerTests, Init_RespectsDependencies)
+{
+    //! GIVEN Thread safe modules that depend on each other and on a main thread module
+    TestModule fonts("fonts", m_log, m_logMutex, true, {}, 20);
+    TestModule instruments("instruments", m_log, m_logMutex, true, { "fonts" });
+    TestModule ui("ui", m_log, m_logMutex);
+    TestModule palette("palette", m_log, m_logMutex, false, { "instruments", "ui" });
+
+    //! DO
+    ModulesSetupRunner runner;
+    runner.init({ &fonts, &instruments, &ui, &palette }, IApplication::RunMode::Editor);
+
+    //! CHECK Every module was initialized once, after its dependencies
+    ASSERT_EQ(m_log.size(), 4u);
+    EXPECT_LT(indexOf("fonts"), indexOf("instruments"));
+    EXPECT_LT(indexOf("instruments"), indexOf("palette"));
+    EXPECT_LT(indexOf("ui"), indexOf("palette"));
+}
+
+TEST_F(ModulesSetupRunnerTests, Init_ThreadSafeModulesRunInParallel)
+{
+    if (QThreadPool::globalInstance()->maxThreadCount() < 3) {
+        GTEST_SKIP();
+    }
+
+    //! GIVEN Independent thread safe modules with slow init
+    TestModule a("a", m_log, m_logMutex, true, {}, 100);
+    TestModule b("b", m_log, m_logMutex, true, {}, 100);
+    TestModule c("c", m_log, m_logMutex, true, {}, 100);
+
+    //! DO
+    ModulesSetupRunner runner;
+    runner.init({ &a, &b, &c }, IApplication::RunMode::Converter);
+
+    //! CHECK All are initialized and the phase took less than running them in sequence
+    EXPECT_EQ(m_log.size(), 3u);
+    EXPECT_LT(runner.phaseDurationUs("onInit"), 300 * 1000);
+}
+
+TEST_F(ModulesSetupRunnerTests, Init_CycleDoesNotHang)
+{
+    //! GIVEN Modules with a dependency cycle
+    TestModule a("a", m_log, m_logMutex, false, { "b" });
+    TestModule b("b", m_log, m_logMutex, true, { "a" });
+
+    //! DO
+    ModulesSetupRunner runner;
+    runner.init({ &a, &b }, IApplication::RunMode::Editor);
+
+    //! CHECK Both are still initialized
+    EXPECT_EQ(m_log.size(), 2u);
+}
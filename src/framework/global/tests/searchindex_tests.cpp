@@ -0,0 +1,117 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include <gtest/gtest.h>
+
+#include <iostream>
+
+#include <QElapsedTimer>
+
+#include "searchindex.h"
+
+using namespace mu;
+
+class SearchIndexTests : public ::testing::Test
+{
+public:
+};
+
+TEST_F(SearchIndexTests, FindContaining)
+{
+    //! GIVEN Entries with translated and untranslated texts
+    SearchIndex<int> index;
+    index.insert(1, { "Staccato", "Staccato" });
+    index.insert(2, { "Staccatissimo", "Staccatissimo" });
+    index.insert(3, { "Akzent", "Accent" });
+    index.insert(4, { "Tenuto-Staccato" });
+
+    //! CHECK Case insensitive substring matches, for short and long queries, in any text
+    EXPECT_EQ(index.findContaining("stacc"), QSet<int>({ 1, 2, 4 }));
+    EXPECT_EQ(index.findContaining("ATISS"), QSet<int>({ 2 }));
+    EXPECT_EQ(index.findContaining("ac"), QSet<int>({ 1, 2, 3, 4 }));
+    EXPECT_EQ(index.findContaining("accent"), QSet<int>({ 3 }));
+    EXPECT_EQ(index.findContaining("akz"), QSet<int>({ 3 }));
+    EXPECT_TRUE(index.findContaining("marcato").isEmpty());
+    EXPECT_EQ(index.findContaining("").size(), 4);
+}
+
+TEST_F(SearchIndexTests, FindStartingWith)
+{
+    //! GIVEN Rehearsal marks
+    SearchIndex<int> index;
+    index.insert(1, { "A" });
+    index.insert(2, { "B" });
+    index.insert(3, { "Bridge" });
+
+    //! CHECK Prefix matches
+    EXPECT_EQ(index.findStartingWith("b"), QSet<int>({ 2, 3 }));
+    EXPECT_EQ(index.findStartingWith("bri"), QSet<int>({ 3 }));
+    EXPECT_TRUE(index.findStartingWith("c").isEmpty());
+}
+
+TEST_F(SearchIndexTests, UpdateIncrementally)
+{
+    //! GIVEN An index with an entry
+    SearchIndex<int> index;
+    index.insert(1, { "Fermata" });
+
+    //! DO Replace its text, add and remove entries
+    index.insert(1, { "Breath mark" });
+    index.insert(2, { "Fermata" });
+    index.insert(3, { "Caesura" });
+    index.remove(3);
+
+    //! CHECK Only the current texts are found
+    EXPECT_EQ(index.size(), 2);
+    EXPECT_EQ(index.findContaining("fermata"), QSet<int>({ 2 }));
+    EXPECT_EQ(index.findContaining("breath"), QSet<int>({ 1 }));
+    EXPECT_TRUE(index.findContaining("caesura").isEmpty());
+}
+
+TEST_F(SearchIndexTests, Benchmark_ThousandsOfCells)
+{
+    //! GIVEN An index of as many cells as all palettes together, several times over
+    const QStringList words { "Staccato", "Accent", "Tenuto", "Marcato", "Fermata", "Crescendo hairpin",
+                              "Treble clef", "Bass clef", "Time signature", "Key signature", "Breath mark",
+                              "Glissando", "Arpeggio", "Tremolo", "Fingering", "Rehearsal mark" };
+    constexpr int CELLS = 20000;
+
+    SearchIndex<int> index;
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < CELLS; ++i) {
+        const QString name = words[i % words.size()] + QString(" %1").arg(i);
+        index.insert(i, { name, name.toUpper() });
+    }
+    qint64 buildMs = timer.elapsed();
+
+    //! DO Type a query char by char
+    const QString query = "crescendo";
+    timer.restart();
+    int found = 0;
+    for (int i = 1; i <= query.size(); ++i) {
+        found = index.findContaining(query.left(i)).size();
+    }
+    qint64 typeMs = timer.elapsed();
+
+    std::cout << "SearchIndex: build " << CELLS << " entries: " << buildMs << " ms, "
+              << "typing " << query.size() << " chars: " << typeMs << " ms" << std::endl;
+
+    //! CHECK Correct result, the timings are for information only
+    EXPECT_EQ(found, CELLS / words.size());
+}
@@ -218,49 +218,132 @@ const std::map<QString, QString> GuitarPro6::instrumentMapping = {
 };
 
 //---------------------------------------------------------
-//   readBit
+//   GPXBitReader
+//    reads the BCFZ bit stream; bits are stored most
+//    significant first. Bits are pulled from a 64 bit cache
+//    that is refilled a byte at a time, reading past the
+//    end of the buffer yields zero bits.
 //---------------------------------------------------------
 
-int GuitarPro6::readBit(QByteArray* buffer)
+class GPXBitReader
 {
-    // calculate the byte index by dividing the position in bits by the bits per byte
-    int byteIndex = position / BITS_IN_BYTE;
+    const uchar* _data;
+    int _size;
+    int _bytePos;
+    quint64 _cache   { 0 };
+    int _cacheBits   { 0 };
+
+    void refill()
+    {
+        while (_cacheBits <= 56) {
+            quint64 byte = _bytePos < _size ? _data[_bytePos] : 0;
+            ++_bytePos;
+            _cache |= byte << (56 - _cacheBits);
+            _cacheBits += 8;
+        }
+    }
 
-    // calculate our offset so we know how much to bit shift
-    int byteOffset = ((BITS_IN_BYTE - 1) - (position % BITS_IN_BYTE));
+public:
+    GPXBitReader(const QByteArray& buffer, int byteOffset)
+        : _data(reinterpret_cast<const uchar*>(buffer.constData())), _size(buffer.size()), _bytePos(byteOffset) {}
 
-    // calculate the bit which we want to read
-    int bit = ((((*buffer)[byteIndex] & 0xff) >> byteOffset) & 0x01);
+    //---------------------------------------------------------
+    //   bitPosition
+    //    number of bits consumed from the start of the buffer
+    //---------------------------------------------------------
 
-    // increment our current position so we know this bit has been read
-    position++;
-    return bit;         // return the bit we calculated
-}
+    qint64 bitPosition() const { return qint64(_bytePos) * 8 - _cacheBits; }
 
-//---------------------------------------------------------
-//   readBits
-//---------------------------------------------------------
+    //---------------------------------------------------------
+    //   readBits
+    //    read up to 32 bits, first bit read is the most significant
+    //---------------------------------------------------------
 
-int GuitarPro6::readBits(QByteArray* buffer, int bitsToRead)
-{
-    int bits = 0;
-    for (int i = (bitsToRead - 1); i >= 0; i--) {
-        bits |= (readBit(buffer) << i);
+    int readBits(int n)
+    {
+        if (n == 0) {
+            return 0;
+        }
+        if (_cacheBits < n) {
+            refill();
+        }
+        int bits = int(_cache >> (64 - n));
+        _cache <<= n;
+        _cacheBits -= n;
+        return bits;
     }
-    return bits;
-}
+
+    //---------------------------------------------------------
+    //   readBitsReversed
+    //    read up to 32 bits, first bit read is the least significant
+    //---------------------------------------------------------
+
+    int readBitsReversed(int n)
+    {
+        int bits = readBits(n);
+        int reversed = 0;
+        for (int i = 0; i < n; ++i) {
+            reversed = (reversed << 1) | (bits & 1);
+            bits >>= 1;
+        }
+        return reversed;
+    }
+};
 
 //---------------------------------------------------------
-//   readBitsReversed
+//   decompressBCFZ
+//    decode a compressed (BCFZ) file into the file
+//    container (BCFS) it holds. The header is followed by
+//    the length and the bit stream. The decoder stops
+//    once the input is exhausted: every bit read past the
+//    end of the buffer is zero and would not produce any
+//    more output.
 //---------------------------------------------------------
 
-int GuitarPro6::readBitsReversed(QByteArray* buffer, int bitsToRead)
+QByteArray GuitarPro6::decompressBCFZ(const QByteArray& buffer)
 {
-    int bits = 0;
-    for (int i = 0; i < bitsToRead; i++) {
-        bits |= readBit(buffer) << i;
+    const int headerSize = 2 * sizeof(int);
+    if (buffer.length() < headerSize) {
+        return QByteArray();
     }
-    return bits;
+    const uchar* header = reinterpret_cast<const uchar*>(buffer.constData());
+    const int length = header[4] | (header[5] << 8) | (header[6] << 16) | (header[7] << 24);
+    const qint64 endBit = qint64(qMin(length, buffer.length())) * 8;
+
+    QByteArray bcfsBuffer;
+    if (length > 0) {
+        bcfsBuffer.reserve(length);
+    }
+    GPXBitReader reader(buffer, headerSize);
+    while (reader.bitPosition() < endBit) {
+        // read the bit indicating compression information
+        int flag = reader.readBits(1);
+
+        if (flag) {
+            int bits = reader.readBits(4);
+            int offs = reader.readBitsReversed(bits);
+            int size = reader.readBitsReversed(bits);
+
+            // back-reference into the already decompressed data;
+            // never copies more than offs bytes so source and
+            // destination do not overlap
+            int oldSize = bcfsBuffer.length();
+            int pos     = oldSize - offs;
+            int count   = qMin(size, offs);
+            if (pos < 0 || count <= 0) {
+                continue;
+            }
+            bcfsBuffer.resize(oldSize + count);
+            char* data = bcfsBuffer.data();
+            memcpy(data + oldSize, data + pos, count);
+        } else {
+            int size = reader.readBitsReversed(2);
+            for (int i = 0; i < size; i++) {
+                bcfsBuffer.append(char(reader.readBits(8)));
+            }
+        }
+    }
+    return bcfsBuffer;
 }
 
 //---------------------------------------------------------
@@ -269,14 +352,10 @@ int GuitarPro6::readBitsReversed(QByteArray* buffer, int bitsToRead)
 
 QByteArray GuitarPro6::getBytes(QByteArray* buffer, int offset, int length)
 {
-    QByteArray newBytes;
-    // compute new bytes from our buffer and return byte array
-    for (int i = 0; i < length; i++) {
-        if (buffer->length() > offset + i) {
-            newBytes.insert(i, ((*buffer)[offset + i]));
-        }
+    if (offset < 0 || offset >= buffer->length()) {
+        return QByteArray();
     }
-    return newBytes;
+    return buffer->mid(offset, length);
 }
 
 //---------------------------------------------------------
@@ -2679,35 +2758,9 @@ void GuitarPro6::readGPX(QByteArray* buffer)
 
     if (fileHeader == GPX_HEADER_COMPRESSED) {
         // this is  a compressed file.
-        int length             = readInteger(buffer, position / BITS_IN_BYTE);
-        QByteArray* bcfsBuffer = new QByteArray();
-        int positionCounter    = 0;
-        while (!f->error() && (position / BITS_IN_BYTE) < length) {
-            // read the bit indicating compression information
-            int flag = readBits(buffer, 1);
-
-            if (flag) {
-                int bits = readBits(buffer, 4);
-                int offs = readBitsReversed(buffer, bits);
-                int size = readBitsReversed(buffer, bits);
-
-                QByteArray bcfsBufferCopy = *bcfsBuffer;
-                int pos                   = (bcfsBufferCopy.length() - offs);
-                for (int i = 0; i < (size > offs ? offs : size); i++) {
-                    bcfsBuffer->insert(positionCounter, bcfsBufferCopy[pos + i]);
-                    positionCounter++;
-                }
-            } else {
-                int size = readBitsReversed(buffer, 2);
-                for (int i = 0; i < size; i++) {
-                    bcfsBuffer->insert(positionCounter, readBits(buffer, 8));
-                    positionCounter++;
-                }
-            }
-        }
+        QByteArray bcfsBuffer = decompressBCFZ(*buffer);
         // recurse on the decompressed file stored as a byte array
-        readGPX(bcfsBuffer);
-        delete bcfsBuffer;
+        readGPX(&bcfsBuffer);
     } else if (fileHeader == GPX_HEADER_UNCOMPRESSED) {
         // this is an uncompressed file - strip the header off
         *buffer = buffer->right(buffer->length() - sizeof(int));
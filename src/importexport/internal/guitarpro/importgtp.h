@@ -402,13 +402,10 @@ class GuitarPro6 : public GuitarPro
     // a mapping from identifiers to fret diagrams
     QMap<int, FretDiagram*> fretDiagrams;
     void parseFile(const char* filename, QByteArray* data);
-    int readBit(QByteArray* buffer);
     QByteArray getBytes(QByteArray* buffer, int offset, int length);
     void readGPX(QByteArray* buffer);
     int readInteger(QByteArray* buffer, int offset);
     QByteArray readString(QByteArray* buffer, int offset, int length);
-    int readBits(QByteArray* buffer, int bitsToRead);
-    int readBitsReversed(QByteArray* buffer, int bitsToRead);
     void readScore(QDomNode* metadata);
     void readChord(QDomNode* diagram, int track);
     int findNumMeasures(GPPartInfo* partInfo);
@@ -442,6 +439,8 @@ public:
     GuitarPro6(MasterScore* s, int v)
         : GuitarPro(s, v) {}
     virtual bool read(QFile*);
+
+    static QByteArray decompressBCFZ(const QByteArray& buffer);
 };
 
 class GuitarPro7 : public GuitarPro6
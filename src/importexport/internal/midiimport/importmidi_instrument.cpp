@@ -146,6 +146,7 @@ const InstrumentTemplate* findInstrument(const QString& groupId, const QString&
 {
     const InstrumentTemplate* instr = nullptr;
 
+    loadDeferredInstrumentTemplates();
     for (const InstrumentGroup* group: instrumentGroups) {
         if (group->id == groupId) {
             for (const InstrumentTemplate* templ: group->instrumentTemplates) {
@@ -167,6 +168,7 @@ const InstrumentTemplate* findClosestInstrument(const MTrack& track)
     int maxLessProgram = -1;
     const InstrumentTemplate* closestTemplate = nullptr;
 
+    loadDeferredInstrumentTemplates();
     for (const InstrumentGroup* group: instrumentGroups) {
         for (const InstrumentTemplate* templ: group->instrumentTemplates) {
             if (templ->staffGroup == StaffGroup::TAB) {
@@ -199,6 +201,7 @@ std::vector<const InstrumentTemplate*> findInstrumentsForProgram(const MTrack& t
         trackPitches = findAllPitches(track);
     }
 
+    loadDeferredInstrumentTemplates();
     for (const InstrumentGroup* group: instrumentGroups) {
         for (const InstrumentTemplate* templ: group->instrumentTemplates) {
             if (templ->staffGroup == StaffGroup::TAB) {
@@ -0,0 +1,54 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "pagesrenderer.h"
+
+#include <QElapsedTimer>
+
+#include "log.h"
+
+using namespace mu::importexport;
+
+mu::Ret PagesRenderer::render(const std::string& format, const std::vector<system::IODevice*>& destinationDevices,
+                              const RenderPage& renderPage)
+{
+    const int pageCount = static_cast<int>(destinationDevices.size());
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for (int pageIndex = 0; pageIndex < pageCount; ++pageIndex) {
+        QByteArray data = renderPage(pageIndex);
+        if (data.isEmpty()) {
+            LOGE() << "failed render page: " << pageIndex;
+            return make_ret(Ret::Code::UnknownError);
+        }
+
+        system::IODevice* device = destinationDevices[pageIndex];
+        if (device->write(data) != data.size()) {
+            LOGE() << "failed write page: " << pageIndex;
+            return make_ret(Ret::Code::UnknownError);
+        }
+    }
+
+    double sec = timer.nsecsElapsed() / 1000000000.0;
+    LOGI() << "rendered " << pageCount << " " << format << " pages in " << sec * 1000.0 << " ms, "
+           << (sec > 0.0 ? pageCount / sec : 0.0) << " pages/s";
+
+    return make_ret(Ret::Code::Ok);
+}
@@ -0,0 +1,45 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_IMPORTEXPORT_PAGESRENDERER_H
+#define MU_IMPORTEXPORT_PAGESRENDERER_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include <QByteArray>
+
+#include "ret.h"
+#include "system/iodevice.h"
+
+namespace mu::importexport {
+//! Paints the pages of a laid out score one after another and writes each one
+//! to its device before the next is painted, so the memory in use does not grow with the score.
+//! Pages are not painted concurrently: drawing elements changes global state (e.g. MScore::pdfPrinting).
+class PagesRenderer
+{
+public:
+    using RenderPage = std::function<QByteArray(int pageIndex)>;
+
+    static Ret render(const std::string& format, const std::vector<system::IODevice*>& destinationDevices,
+                      const RenderPage& renderPage);
+};
+}
+
+#endif // MU_IMPORTEXPORT_PAGESRENDERER_H
@@ -21,10 +21,11 @@
 
 #include "log.h"
 
+#include "libmscore/mscore.h"
 #include "libmscore/score.h"
 
+#include <QElapsedTimer>
 #include <QPdfWriter>
-#include <QPainter>
 
 using namespace mu::importexport;
 using namespace mu::system;
@@ -40,42 +41,22 @@ mu::Ret PdfWriter::write(const notation::INotationPtr notation, IODevice& destin
         return make_ret(Ret::Code::UnknownError);
     }
 
-    score->setPrinting(true);
-    MScore::pdfPrinting = true;
-
     QPdfWriter pdfWriter(&destinationDevice);
     pdfWriter.setResolution(configuration()->exportPdfDpiResolution());
     pdfWriter.setCreator("MuseScore Version: " VERSION);
     pdfWriter.setTitle(documentTitle(*score));
     pdfWriter.setPageMargins(QMarginsF());
 
-    QPainter painter;
-    if (!painter.begin(&pdfWriter)) {
-        return false;
-    }
-
-    QSizeF size(score->styleD(Sid::pageWidth), score->styleD(Sid::pageHeight));
-    painter.setRenderHint(QPainter::Antialiasing, true);
-    painter.setRenderHint(QPainter::TextAntialiasing, true);
-    painter.setViewport(QRect(0.0, 0.0, size.width() * pdfWriter.logicalDpiX(),
-                              size.height() * pdfWriter.logicalDpiY()));
-    painter.setWindow(QRect(0.0, 0.0, size.width() * DPI, size.height() * DPI));
+    QElapsedTimer timer;
+    timer.start();
 
-    double pixelRationBackup = MScore::pixelRatio;
-    MScore::pixelRatio = DPI / pdfWriter.logicalDpiX();
-
-    for (int pageNumber = 0; pageNumber < score->npages(); ++pageNumber) {
-        if (pageNumber > 0) {
-            pdfWriter.newPage();
-        }
-
-        score->print(&painter, pageNumber);
+    if (!score->printPdf(pdfWriter)) {
+        return false;
     }
 
-    painter.end();
-    score->setPrinting(false);
-    MScore::pixelRatio = pixelRationBackup;
-    MScore::pdfPrinting = false;
+    double sec = timer.nsecsElapsed() / 1000000000.0;
+    LOGI() << "rendered " << score->npages() << " pdf pages in " << sec * 1000.0 << " ms, "
+           << (sec > 0.0 ? score->npages() / sec : 0.0) << " pages/s";
 
     return true;
 }
@@ -23,9 +23,13 @@
 
 #include "log.h"
 
+#include "libmscore/mscore.h"
 #include "libmscore/score.h"
 #include "libmscore/page.h"
 
+#include "pagesrenderer.h"
+
+#include <QBuffer>
 #include <QImage>
 #include <QPainter>
 
@@ -42,10 +46,6 @@ mu::Ret PngWriter::write(const notation::INotationPtr notation, IODevice& destin
         return make_ret(Ret::Code::UnknownError);
     }
 
-    score->setPrinting(true); // don’t print page break symbols etc.
-
-    double pixelRatioBackup = Ms::MScore::pixelRatio;
-
     const int PAGE_NUMBER = options.value(OptionKey::PAGE_NUMBER, Val(0)).toInt();
     const QList<Ms::Page*>& pages = score->pages();
 
@@ -53,8 +53,58 @@ mu::Ret PngWriter::write(const notation::INotationPtr notation, IODevice& destin
         return false;
     }
 
-    Ms::Page* page = pages[PAGE_NUMBER];
+    score->setPrinting(true); // don’t print page break symbols etc.
+
+    const float CANVAS_DPI = configuration()->exportPngDpiResolution();
+    QImage image;
+    {
+        Ms::PrintingState printingState(Ms::DPI / CANVAS_DPI);
+        image = renderPage(pages[PAGE_NUMBER], CANVAS_DPI, options);
+    }
+    image.save(&destinationDevice, "png");
+
+    score->setPrinting(false);
+
+    return true;
+}
+
+mu::Ret PngWriter::writePages(const notation::INotationPtr notation, const std::vector<IODevice*>& destinationDevices,
+                              const Options& options)
+{
+    IF_ASSERT_FAILED(notation) {
+        return make_ret(Ret::Code::UnknownError);
+    }
+    Ms::Score* score = notation->elements()->msScore();
+    IF_ASSERT_FAILED(score) {
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    const QList<Ms::Page*>& pages = score->pages();
+    if (static_cast<int>(destinationDevices.size()) != pages.size()) {
+        return false;
+    }
+
+    score->setPrinting(true); // don’t print page break symbols etc.
+
+    //! NOTE The global printing state is set once for all pages
+    const float CANVAS_DPI = configuration()->exportPngDpiResolution();
+    Ms::PrintingState printingState(Ms::DPI / CANVAS_DPI);
+
+    Ret ret = PagesRenderer::render("png", destinationDevices, [&pages, CANVAS_DPI, &options](int pageIndex) {
+        QByteArray data;
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::WriteOnly);
+        renderPage(pages[pageIndex], CANVAS_DPI, options).save(&buffer, "png");
+        return data;
+    });
 
+    score->setPrinting(false);
+
+    return ret;
+}
+
+QImage PngWriter::renderPage(Ms::Page* page, float canvasDpi, const Options& options)
+{
     const int TRIM_MARGIN_SIZE = options.value(OptionKey::TRIM_MARGINS_SIZE, Val(0)).toInt();
     QRectF pageRect = page->abbox();
 
@@ -63,19 +113,17 @@ mu::Ret PngWriter::write(const notation::INotationPtr notation, IODevice& destin
         pageRect = page->tbbox() + margins;
     }
 
-    const float CANVAS_DPI = configuration()->exportPngDpiResolution();
-    int width = std::lrint(pageRect.width() * CANVAS_DPI / Ms::DPI);
-    int height = std::lrint(pageRect.height() * CANVAS_DPI / Ms::DPI);
+    int width = std::lrint(pageRect.width() * canvasDpi / Ms::DPI);
+    int height = std::lrint(pageRect.height() * canvasDpi / Ms::DPI);
 
     QImage image(width, height, QImage::Format_ARGB32_Premultiplied);
-    image.setDotsPerMeterX(std::lrint((CANVAS_DPI * 1000) / Ms::INCH));
-    image.setDotsPerMeterY(std::lrint((CANVAS_DPI * 1000) / Ms::INCH));
+    image.setDotsPerMeterX(std::lrint((canvasDpi * 1000) / Ms::INCH));
+    image.setDotsPerMeterY(std::lrint((canvasDpi * 1000) / Ms::INCH));
 
     const bool TRANSPARENT_BACKGROUND = options.value(OptionKey::TRANSPARENT_BACKGROUND, Val(false)).toBool();
     image.fill(TRANSPARENT_BACKGROUND ? 0 : Qt::white);
 
-    double scaling = CANVAS_DPI / Ms::DPI;
-    Ms::MScore::pixelRatio = 1.0 / scaling;
+    double scaling = canvasDpi / Ms::DPI;
 
     QPainter painter(&image);
     painter.setRenderHint(QPainter::Antialiasing, true);
@@ -89,10 +137,7 @@ mu::Ret PngWriter::write(const notation::INotationPtr notation, IODevice& destin
     std::stable_sort(elements.begin(), elements.end(), Ms::elementLessThan);
 
     Ms::paintElements(painter, elements);
-    image.save(&destinationDevice, "png");
+    painter.end();
 
-    score->setPrinting(false);
-    Ms::MScore::pixelRatio = pixelRatioBackup;
-
-    return true;
+    return image;
 }
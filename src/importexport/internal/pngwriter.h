@@ -20,11 +20,17 @@
 #ifndef MU_IMPORTEXPORT_PNGWRITER_H
 #define MU_IMPORTEXPORT_PNGWRITER_H
 
+#include <QImage>
+
 #include "notation/abstractnotationwriter.h"
 
 #include "../iimportexportconfiguration.h"
 #include "modularity/ioc.h"
 
+namespace Ms {
+class Page;
+}
+
 namespace mu::importexport {
 class PngWriter : public notation::AbstractNotationWriter
 {
@@ -32,6 +38,11 @@ class PngWriter : public notation::AbstractNotationWriter
 
 public:
     Ret write(const notation::INotationPtr notation, system::IODevice& destinationDevice, const Options& options = Options()) override;
+    Ret writePages(const notation::INotationPtr notation, const std::vector<system::IODevice*>& destinationDevices,
+                   const Options& options = Options()) override;
+
+private:
+    static QImage renderPage(Ms::Page* page, float canvasDpi, const Options& options);
 };
 }
 
@@ -39,6 +39,7 @@
 **
 ****************************************************************************/
 
+#include <QHash>
 #include <QTextStream>
 #include <QBuffer>
 #include <QTextCodec>
@@ -170,7 +171,9 @@ public:
         size = QSize();
         viewBox = QRectF();
         outputDevice = 0;
+        stream = 0;
         resolution = Ms::DPI;
+        reuseGlyphs = true;
 
         attributes.title = QLatin1String("MuseScore SVG Document");
         attributes.description = QString("Generated by MuseScore %1").arg(VERSION);
@@ -189,9 +192,9 @@ public:
     QTextStream* stream;
     int resolution;
 
-    QString header;
-//    QString defs; // NEEDED FOR GRADIENTS
-    QString body;
+    // Glyph outlines are written once into <defs> and referenced by <use>
+    bool reuseGlyphs;
+    QHash<QString, int> glyphIds;   // outline path data -> id number
 
     QBrush brush;
     QPen pen;
@@ -247,14 +250,20 @@ private:
     qreal _dx { 0.0 };
     qreal _dy { 0.0 };
 
+// Set while QPaintEngine::drawTextItem() fills the glyph outlines
+    bool _drawingGlyphs { false };
+
 protected:
 // The Ms::Element being generated right now
     const Ms::Element* _element = NULL;
 
     void writeImage(const QRectF& r, const QByteArray& imageData, const QString& mimeFormat);
+    void writeGlyphs(const QPainterPath& p);
+    QString pathData(const QPainterPath& p, qreal dx, qreal dy) const;
 
 // SVG strings as constants
 #define SVG_SPACE    ' '
+#define SVG_NEWLINE  '\n'   // not endl, the stream goes to the device and must not flush every line
 #define SVG_QUOTE    "\""
 #define SVG_COMMA    ","
 #define SVG_GT       ">"
@@ -298,6 +307,13 @@ protected:
 #define SVG_IMAGE       "<image"
 #define SVG_PATH        "<path"
 #define SVG_POLYLINE    "<polyline"
+#define SVG_USE         "<use"
+
+#define SVG_DEFS_BEGIN  "<defs>"
+#define SVG_DEFS_END    "</defs>"
+#define SVG_ID          " id=\""
+#define SVG_HREF        " xlink:href=\"#"
+#define SVG_GLYPH_ID    "glyph"
 
 #define SVG_PRESERVE_ASPECT " preserveAspectRatio=\""
 
@@ -337,6 +353,7 @@ public:
     void popGroup();
 
     void drawPath(const QPainterPath& path);
+    void drawTextItem(const QPointF& p, const QTextItem& textItem);
     void drawPixmap(const QRectF& r, const QPixmap& pm, const QRectF& sr);
     void drawPolygon(const QPoint* points, int pointCount, PolygonDrawMode mode) { QPaintEngine::drawPolygon(points,pointCount,mode); }
     void drawPolygon(const QPointF* points, int pointCount, PolygonDrawMode mode);
@@ -384,6 +401,13 @@ public:
         d_func()->resolution = resolution;
     }
 
+    bool reuseGlyphs() const { return d_func()->reuseGlyphs; }
+    void setReuseGlyphs(bool reuse)
+    {
+        Q_ASSERT(!isActive());
+        d_func()->reuseGlyphs = reuse;
+    }
+
 ///////////////////////////////////////////////////////////////////////////////
 // UNUSED GRADIENT CODE:
 //    void saveLinearGradientBrush(const QGradient *g)
@@ -968,6 +992,29 @@ void SvgGenerator::setResolution(int dpi)
     d->engine->setResolution(dpi);
 }
 
+/*!
+    \property SvgGenerator::reuseGlyphs
+    \brief whether glyph outlines are written once and referenced
+
+    If true (the default), the outline of every distinct glyph run is
+    written once into <defs>, each occurrence is a <use> of it.
+*/
+bool SvgGenerator::reuseGlyphs() const
+{
+    Q_D(const SvgGenerator);
+    return d->engine->reuseGlyphs();
+}
+
+void SvgGenerator::setReuseGlyphs(bool reuse)
+{
+    Q_D(SvgGenerator);
+    if (d->engine->isActive()) {
+        qWarning("SvgGenerator::setReuseGlyphs(), cannot change while SVG is being generated");
+        return;
+    }
+    d->engine->setReuseGlyphs(reuse);
+}
+
 /*!
     Returns the paint engine used to render graphics to be converted to SVG
     format information.
@@ -1050,9 +1097,14 @@ bool SvgPaintEngine::begin(QPaintDevice*)
         return false;
     }
 
-    // Stream the headers
-    d->stream = new QTextStream(&d->header);
-    stream() << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>" << Qt::endl << SVG_BEGIN;
+    // Stream straight to the device, nothing is kept in memory
+    d->stream = new QTextStream(d->outputDevice);
+#ifndef QT_NO_TEXTCODEC
+    d->stream->setCodec(QTextCodec::codecForName("UTF-8"));
+#endif
+    d->glyphIds.clear();
+
+    stream() << "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"no\"?>" << SVG_NEWLINE << SVG_BEGIN;
     if (d->viewBox.isValid()) {
         // viewBox has floating point values, size width/height is integer
         stream() << SVG_WIDTH << d->viewBox.width() << SVG_PX << SVG_QUOTE
@@ -1061,24 +1113,19 @@ bool SvgPaintEngine::begin(QPaintDevice*)
         stream() << SVG_VIEW_BOX << d->viewBox.left()
                  << SVG_SPACE << d->viewBox.top()
                  << SVG_SPACE << d->viewBox.width()
-                 << SVG_SPACE << d->viewBox.height() << SVG_QUOTE << Qt::endl;
+                 << SVG_SPACE << d->viewBox.height() << SVG_QUOTE << SVG_NEWLINE;
     }
     stream() << " xmlns=\"http://www.w3.org/2000/svg\""
                 " xmlns:xlink=\"http://www.w3.org/1999/xlink\""
-                " version=\"1.2\" baseProfile=\"tiny\">" << Qt::endl;
+                " version=\"1.2\" baseProfile=\"tiny\">" << SVG_NEWLINE;
     if (!d->attributes.title.isEmpty()) {
-        stream() << SVG_TITLE_BEGIN << d->attributes.title.toHtmlEscaped() << SVG_TITLE_END << Qt::endl;
+        stream() << SVG_TITLE_BEGIN << d->attributes.title.toHtmlEscaped() << SVG_TITLE_END << SVG_NEWLINE;
     }
     if (!d->attributes.description.isEmpty()) {
-        stream() << SVG_DESC_BEGIN << d->attributes.description.toHtmlEscaped() << SVG_DESC_END << Qt::endl;
+        stream() << SVG_DESC_BEGIN << d->attributes.description.toHtmlEscaped() << SVG_DESC_END << SVG_NEWLINE;
     }
 
-// <defs> is currently empty. It's necessary for gradients.
-//    d->stream->setString(&d->defs);
-//    *d->stream << "<defs>\n";
-
-    // Point the stream at the body string, for other functions to populate
-    d->stream->setString(&d->body);
+    // <defs> for glyphs are written in place, right before their first <use>
     return true;
 }
 
@@ -1086,24 +1133,12 @@ bool SvgPaintEngine::end()
 {
     Q_D(SvgPaintEngine);
 
-// <defs> is currently empty
-//    d->stream->setString(&d->defs);
-//    stream() << "</defs>\n";
-
-    // Point the stream at the real output device (the .svg file)
-    d->stream->setDevice(d->outputDevice);
-
-#ifndef QT_NO_TEXTCODEC
-    d->stream->setCodec(QTextCodec::codecForName("UTF-8"));
-#endif
-
-    // Stream our strings out to the device, in order
-    stream() << d->header;
-//    stream() << d->defs;
-    stream() << d->body;
-    stream() << SVG_END << Qt::endl;
+    stream() << SVG_END << SVG_NEWLINE;
+    d->stream->flush();
 
     delete d->stream;
+    d->stream = 0;
+    d->glyphIds.clear();
     return true;
 }
 
@@ -1161,7 +1196,7 @@ void SvgPaintEngine::writeImage(const QRectF& r, const QByteArray& imageData, co
              << SVG_PRESERVE_ASPECT << SVG_NONE << SVG_QUOTE;
 
     stream() << " xlink:href=\"data:" << mimeFormat << ";base64,"
-             << imageData.toBase64() << SVG_QUOTE << SVG_ELEMENT_END << Qt::endl;
+             << imageData.toBase64() << SVG_QUOTE << SVG_ELEMENT_END << SVG_NEWLINE;
 }
 
 void SvgPaintEngine::updateState(const QPaintEngineState& s)
@@ -1218,6 +1253,11 @@ void SvgPaintEngine::updateState(const QPaintEngineState& s)
 
 void SvgPaintEngine::drawPath(const QPainterPath& p)
 {
+    if (_drawingGlyphs && d_func()->reuseGlyphs) {
+        writeGlyphs(p);
+        return;
+    }
+
     stream() << SVG_PATH << stateString;
 
     // fill-rule is here because UpdateState() doesn't have a QPainterPath arg
@@ -1227,26 +1267,33 @@ void SvgPaintEngine::drawPath(const QPainterPath& p)
     }
 
     // Path data
-    stream() << SVG_D;
+    stream() << SVG_D << pathData(p, _dx, _dy) << SVG_QUOTE << SVG_ELEMENT_END << SVG_NEWLINE;
+}
+
+QString SvgPaintEngine::pathData(const QPainterPath& p, qreal dx, qreal dy) const
+{
+    QString data;
+    QTextStream str(&data);
+
     for (int i = 0; i < p.elementCount(); ++i) {
         const QPainterPath::Element& e = p.elementAt(i);
-        qreal x = e.x + _dx;
-        qreal y = e.y + _dy;
+        qreal x = e.x + dx;
+        qreal y = e.y + dy;
         switch (e.type) {
         case QPainterPath::MoveToElement:
-            stream() << SVG_MOVE << x << SVG_COMMA << y;
+            str << SVG_MOVE << x << SVG_COMMA << y;
             break;
         case QPainterPath::LineToElement:
-            stream() << SVG_LINE << x << SVG_COMMA << y;
+            str << SVG_LINE << x << SVG_COMMA << y;
             break;
         case QPainterPath::CurveToElement:
-            stream() << SVG_CURVE << x << SVG_COMMA << y;
+            str << SVG_CURVE << x << SVG_COMMA << y;
             ++i;
             while (i < p.elementCount()) {
                 const QPainterPath::Element& ee = p.elementAt(i);
                 if (ee.type == QPainterPath::CurveToDataElement) {
-                    stream() << SVG_SPACE << ee.x + _dx
-                             << SVG_COMMA << ee.y + _dy;
+                    str << SVG_SPACE << ee.x + dx
+                        << SVG_COMMA << ee.y + dy;
                     ++i;
                 } else {
                     --i;
@@ -1258,10 +1305,49 @@ void SvgPaintEngine::drawPath(const QPainterPath& p)
             break;
         }
         if (i <= p.elementCount() - 1) {
-            stream() << SVG_SPACE;
+            str << SVG_SPACE;
         }
     }
-    stream() << SVG_QUOTE << SVG_ELEMENT_END << Qt::endl;
+
+    str.flush();
+    return data;
+}
+
+void SvgPaintEngine::drawTextItem(const QPointF& p, const QTextItem& textItem)
+{
+    // Qt fills the glyph outlines with the painter translated to p,
+    // so the outline itself does not depend on where the text is
+    _drawingGlyphs = true;
+    QPaintEngine::drawTextItem(p, textItem);
+    _drawingGlyphs = false;
+}
+
+void SvgPaintEngine::writeGlyphs(const QPainterPath& p)
+{
+    Q_D(SvgPaintEngine);
+
+    // The outline is written untranslated, the translation goes to the <use>.
+    // Other transformations are in stateString, they apply to the <use> as well.
+    QString outline;
+    if (p.fillRule() == Qt::OddEvenFill) {
+        outline = QLatin1String(SVG_FILL_RULE);
+    }
+    outline += QLatin1String(SVG_D) + pathData(p, 0.0, 0.0) + QLatin1String(SVG_QUOTE);
+
+    auto it = d->glyphIds.find(outline);
+    if (it == d->glyphIds.end()) {
+        it = d->glyphIds.insert(outline, d->glyphIds.size() + 1);
+
+        stream() << SVG_DEFS_BEGIN << SVG_PATH << SVG_ID << SVG_GLYPH_ID << it.value() << SVG_QUOTE
+                 << outline << SVG_ELEMENT_END << SVG_DEFS_END << SVG_NEWLINE;
+    }
+
+    stream() << SVG_USE << SVG_HREF << SVG_GLYPH_ID << it.value() << SVG_QUOTE << stateString;
+    if (_dx != 0.0 || _dy != 0.0) {
+        stream() << SVG_X << SVG_QUOTE << _dx << SVG_QUOTE
+                 << SVG_Y << SVG_QUOTE << _dy << SVG_QUOTE;
+    }
+    stream() << SVG_ELEMENT_END << SVG_NEWLINE;
 }
 
 void SvgPaintEngine::drawPolygon(const QPointF* points, int pointCount,
@@ -1284,7 +1370,7 @@ void SvgPaintEngine::drawPolygon(const QPointF* points, int pointCount,
                 stream() << SVG_SPACE;
             }
         }
-        stream() << SVG_QUOTE << SVG_ELEMENT_END << Qt::endl;
+        stream() << SVG_QUOTE << SVG_ELEMENT_END << SVG_NEWLINE;
     } else {
         path.closeSubpath();
         drawPath(path);
@@ -64,6 +64,7 @@ class SvgGeneratorPrivate;
 //   @P fileName      QString
 //   @P outputDevice  QIODevice
 //   @P resolution    int
+//   @P reuseGlyphs   bool
 //---------------------------------------------------------
 
 class SvgGenerator : public QPaintDevice
@@ -77,6 +78,7 @@ class SvgGenerator : public QPaintDevice
     Q_PROPERTY(QString fileName READ fileName WRITE setFileName)
     Q_PROPERTY(QIODevice * outputDevice READ outputDevice WRITE setOutputDevice)
     Q_PROPERTY(int resolution READ resolution WRITE setResolution)
+    Q_PROPERTY(bool reuseGlyphs READ reuseGlyphs WRITE setReuseGlyphs)
 public:
     SvgGenerator();
     ~SvgGenerator();
@@ -104,6 +106,9 @@ public:
     void setResolution(int dpi);
     int resolution() const;
 
+    void setReuseGlyphs(bool reuse);
+    bool reuseGlyphs() const;
+
     void setElement(const Ms::Element* e);
 
 protected:
@@ -22,7 +22,9 @@
 #include "log.h"
 
 #include "svggenerator.h"
+#include "pagesrenderer.h"
 
+#include "libmscore/mscore.h"
 #include "libmscore/score.h"
 #include "libmscore/page.h"
 #include "libmscore/system.h"
@@ -30,11 +32,19 @@
 #include "libmscore/measure.h"
 #include "libmscore/stafflines.h"
 
+#include <QBuffer>
 #include <QPainter>
 
 using namespace mu::importexport;
 using namespace mu::system;
 
+//! NOTE SvgGenerator paints at its own resolution
+static double svgPixelRatio()
+{
+    SvgGenerator printer;
+    return Ms::DPI / printer.logicalDpiX();
+}
+
 mu::Ret SvgWriter::write(const notation::INotationPtr notation, IODevice& destinationDevice, const Options& options)
 {
     IF_ASSERT_FAILED(notation) {
@@ -45,24 +55,65 @@ mu::Ret SvgWriter::write(const notation::INotationPtr notation, IODevice& destin
         return make_ret(Ret::Code::UnknownError);
     }
 
+    const int PAGE_NUMBER = options.value(OptionKey::PAGE_NUMBER, Val(0)).toInt();
+    if (PAGE_NUMBER < 0 || PAGE_NUMBER >= score->pages().size()) {
+        return false;
+    }
+
     score->setPrinting(true); // don’t print page break symbols etc.
 
-    Ms::MScore::pdfPrinting = true;
-    Ms::MScore::svgPrinting = true;
+    {
+        Ms::PrintingState printingState(svgPixelRatio(), true, true);
+        renderPage(score, PAGE_NUMBER, destinationDevice, options);
+    }
 
-    const QList<Ms::Page*>& pages = score->pages();
-    double pixelRationBackup = Ms::MScore::pixelRatio;
+    score->setPrinting(false);
 
-    const int PAGE_NUMBER = options.value(OptionKey::PAGE_NUMBER, Val(0)).toInt();
-    if (PAGE_NUMBER < 0 || PAGE_NUMBER >= pages.size()) {
+    return true;
+}
+
+mu::Ret SvgWriter::writePages(const notation::INotationPtr notation, const std::vector<IODevice*>& destinationDevices,
+                              const Options& options)
+{
+    IF_ASSERT_FAILED(notation) {
+        return make_ret(Ret::Code::UnknownError);
+    }
+    Ms::Score* score = notation->elements()->msScore();
+    IF_ASSERT_FAILED(score) {
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    if (static_cast<int>(destinationDevices.size()) != score->pages().size()) {
         return false;
     }
 
-    Ms::Page* page = pages.at(PAGE_NUMBER);
+    score->setPrinting(true); // don’t print page break symbols etc.
+
+    //! NOTE The global printing state is set once for all pages
+    Ms::PrintingState printingState(svgPixelRatio(), true, true);
+
+    Ret ret = PagesRenderer::render("svg", destinationDevices, [this, score, &options](int pageIndex) {
+        QByteArray data;
+        QBuffer buffer(&data);
+        buffer.open(QIODevice::WriteOnly);
+        renderPage(score, pageIndex, buffer, options);
+        return data;
+    });
+
+    score->setPrinting(false);
+
+    return ret;
+}
+
+void SvgWriter::renderPage(Ms::Score* score, int pageNumber, IODevice& destinationDevice, const Options& options) const
+{
+    const QList<Ms::Page*>& pages = score->pages();
+
+    Ms::Page* page = pages.at(pageNumber);
 
     SvgGenerator printer;
     QString title(score->title());
-    printer.setTitle(pages.size() > 1 ? QString("%1 (%2)").arg(title).arg(PAGE_NUMBER + 1) : title);
+    printer.setTitle(pages.size() > 1 ? QString("%1 (%2)").arg(title).arg(pageNumber + 1) : title);
     printer.setOutputDevice(&destinationDevice);
 
     const int TRIM_MARGINS_SIZE = options.value(OptionKey::TRIM_MARGINS_SIZE, Val(0)).toInt();
@@ -85,8 +136,6 @@ mu::Ret SvgWriter::write(const notation::INotationPtr notation, IODevice& destin
         painter.translate(-pageRect.topLeft());
     }
 
-    Ms::MScore::pixelRatio = Ms::DPI / printer.logicalDpiX();
-
     if (!options[OptionKey::TRANSPARENT_BACKGROUND].toBool()) {
         painter.fillRect(pageRect, Qt::white);
     }
@@ -160,7 +209,7 @@ mu::Ret SvgWriter::write(const notation::INotationPtr notation, IODevice& destin
     std::stable_sort(elements.begin(), elements.end(), Ms::elementLessThan);
 
     int lastNoteIndex = -1;
-    for (int i = 0; i < PAGE_NUMBER; ++i) {
+    for (int i = 0; i < pageNumber; ++i) {
         for (const Ms::Element* element: pages[i]->elements()) {
             if (element->type() == Ms::ElementType::NOTE) {
                 lastNoteIndex++;
@@ -207,14 +256,6 @@ mu::Ret SvgWriter::write(const notation::INotationPtr notation, IODevice& destin
     }
 
     painter.end(); // Writes MuseScore SVG file to disk, finally
-
-    // Clean up and return
-    Ms::MScore::pixelRatio = pixelRationBackup;
-    score->setPrinting(false);
-    Ms::MScore::pdfPrinting = false;
-    Ms::MScore::svgPrinting = false;
-
-    return true;
 }
 
 SvgWriter::NotesColors SvgWriter::parseNotesColors(const QVariant& obj) const
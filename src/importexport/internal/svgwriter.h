@@ -22,13 +22,21 @@
 
 #include "notation/abstractnotationwriter.h"
 
+namespace Ms {
+class Score;
+}
+
 namespace mu::importexport {
 class SvgWriter : public notation::AbstractNotationWriter
 {
 public:
     Ret write(const notation::INotationPtr notation, system::IODevice& destinationDevice, const Options& options = Options()) override;
+    Ret writePages(const notation::INotationPtr notation, const std::vector<system::IODevice*>& destinationDevices,
+                   const Options& options = Options()) override;
 
 private:
+    void renderPage(Ms::Score* score, int pageNumber, system::IODevice& destinationDevice, const Options& options) const;
+
     using NotesColors = QHash<int /* noteIndex */, QColor>;
 
     NotesColors parseNotesColors(const QVariant& obj) const;
@@ -0,0 +1,185 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include "testing/qtestsuite.h"
+
+#include <QDir>
+
+#include "testbase.h"
+
+#include "libmscore/score.h"
+#include "importexport/internal/guitarpro/importgtp.h"
+
+using namespace Ms;
+
+namespace Ms {
+extern Score::FileError importGTP(MasterScore*, const QString& name);
+}
+
+//---------------------------------------------------------
+//   TestGuitarProImport
+//---------------------------------------------------------
+
+class TestGuitarProImport : public QObject, public MTest
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+
+    void gpxDecompress();
+    void gpxImport();
+    void gpxImportBenchmark();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestGuitarProImport::initTestCase()
+{
+    initMTest(QString(importexport_guitarpro_tests_DATA_ROOT));
+}
+
+//---------------------------------------------------------
+//   decompressBCFZReference
+//   the decoder as it was before GuitarPro6::decompressBCFZ(),
+//   one bit at a time, kept to check the output of the new one
+//---------------------------------------------------------
+
+static QByteArray decompressBCFZReference(const QByteArray& buffer)
+{
+    int position = 2 * sizeof(int) * 8;
+    auto readBit = [&buffer, &position]() {
+        int byteIndex = position / 8;
+        int byteOffset = 7 - (position % 8);
+        ++position;
+        return byteIndex < buffer.length() ? ((buffer.at(byteIndex) & 0xff) >> byteOffset) & 0x01 : 0;
+    };
+    auto readBits = [&readBit](int n) {
+        int bits = 0;
+        for (int i = n - 1; i >= 0; --i) {
+            bits |= readBit() << i;
+        }
+        return bits;
+    };
+    auto readBitsReversed = [&readBit](int n) {
+        int bits = 0;
+        for (int i = 0; i < n; ++i) {
+            bits |= readBit() << i;
+        }
+        return bits;
+    };
+
+    const uchar* header = reinterpret_cast<const uchar*>(buffer.constData());
+    const int length = header[4] | (header[5] << 8) | (header[6] << 16) | (header[7] << 24);
+
+    QByteArray bcfs;
+    while (position / 8 < length) {
+        if (readBits(1)) {
+            int bits = readBits(4);
+            int offs = readBitsReversed(bits);
+            int size = readBitsReversed(bits);
+            QByteArray copy = bcfs;
+            int pos = copy.length() - offs;
+            for (int i = 0; pos >= 0 && i < (size > offs ? offs : size); ++i) {
+                bcfs.append(copy.at(pos + i));
+            }
+        } else {
+            int size = readBitsReversed(2);
+            for (int i = 0; i < size; ++i) {
+                bcfs.append(char(readBits(8)));
+            }
+        }
+    }
+    return bcfs;
+}
+
+//---------------------------------------------------------
+//   gpxDecompress
+//   the decoder produces the same output as the reference
+//   decoder for every compressed .gpx file of the corpus
+//---------------------------------------------------------
+
+void TestGuitarProImport::gpxDecompress()
+{
+    QDir dir(root);
+    QStringList files = dir.entryList(QStringList("*.gpx"), QDir::Files, QDir::Name);
+    QVERIFY(!files.isEmpty());
+
+    int compressed = 0;
+    for (const QString& file : files) {
+        QFile f(dir.filePath(file));
+        QVERIFY2(f.open(QIODevice::ReadOnly), qPrintable(file));
+        QByteArray data = f.readAll();
+        if (!data.startsWith("BCFZ")) {
+            continue;
+        }
+        ++compressed;
+
+        QByteArray bcfs = GuitarPro6::decompressBCFZ(data);
+        QVERIFY2(bcfs.startsWith("BCFS"), qPrintable(file));
+        QVERIFY2(bcfs == decompressBCFZReference(data), qPrintable(file));
+    }
+    QVERIFY(compressed > 0);
+}
+
+//---------------------------------------------------------
+//   gpxImport
+//   every .gpx file of the corpus is decompressed and parsed
+//---------------------------------------------------------
+
+void TestGuitarProImport::gpxImport()
+{
+    QDir dir(root);
+    QStringList files = dir.entryList(QStringList("*.gpx"), QDir::Files, QDir::Name);
+    QVERIFY(!files.isEmpty());
+
+    for (const QString& file : files) {
+        MasterScore* score = new MasterScore(mscore->baseStyle());
+        Score::FileError rv = importGTP(score, dir.filePath(file));
+        QVERIFY2(rv == Score::FileError::FILE_NO_ERROR, qPrintable(file));
+        QVERIFY2(score->firstMeasure(), qPrintable(file));
+        delete score;
+    }
+}
+
+//---------------------------------------------------------
+//   gpxImportBenchmark
+//   import (decompress and parse) every .gpx file of the corpus,
+//   without layout
+//---------------------------------------------------------
+
+void TestGuitarProImport::gpxImportBenchmark()
+{
+    QDir dir(root);
+    QStringList files = dir.entryList(QStringList("*.gpx"), QDir::Files, QDir::Name);
+    QVERIFY(!files.isEmpty());
+
+    QBENCHMARK {
+        for (const QString& file : files) {
+            MasterScore* score = new MasterScore(mscore->baseStyle());
+            importGTP(score, dir.filePath(file));
+            delete score;
+        }
+    }
+}
+
+QTEST_MAIN(TestGuitarProImport)
+#include "tst_guitarpro_import.moc"
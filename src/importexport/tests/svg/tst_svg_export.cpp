@@ -0,0 +1,279 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include "testing/qtestsuite.h"
+
+#include <memory>
+
+#include <QBuffer>
+#include <QImage>
+#include <QPainter>
+
+#include "testbase.h"
+
+#include "libmscore/score.h"
+#include "libmscore/page.h"
+
+#include "importexport/internal/pngwriter.h"
+#include "importexport/internal/svggenerator.h"
+#include "importexport/internal/svgwriter.h"
+
+#include "importexport/tests/mocks/importexportconfigurationmock.h"
+#include "notation/tests/mocks/notationelementsmock.h"
+#include "notation/tests/mocks/notationmock.h"
+
+static const QString SVG_DIR("data/");
+
+using ::testing::NiceMock;
+using ::testing::Return;
+
+using namespace Ms;
+using namespace mu::importexport;
+using namespace mu::notation;
+
+//---------------------------------------------------------
+//   TestSvgExport
+//---------------------------------------------------------
+
+class TestSvgExport : public QObject, public MTest
+{
+    Q_OBJECT
+
+    QByteArray paintPage(Score* score, bool reuseGlyphs);
+    static INotationPtr notation(Score* score);
+    static std::vector<QByteArray> writePages(AbstractNotationWriter& writer, Score* score, bool sequential);
+
+private slots:
+    void initTestCase();
+
+    void reuseGlyphs();
+    void pngPagesAsSequential();
+    void svgPagesAsSequential();
+    void benchmarkPaths();
+    void benchmarkReusedGlyphs();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestSvgExport::initTestCase()
+{
+    initMTest(QString(importexport_svg_tests_DATA_ROOT));
+}
+
+//---------------------------------------------------------
+//   paintPage
+//    paints the first page the way SvgWriter does
+//---------------------------------------------------------
+
+QByteArray TestSvgExport::paintPage(Score* score, bool reuseGlyphs)
+{
+    QByteArray data;
+    QBuffer buffer(&data);
+
+    Page* page = score->pages().front();
+
+    score->setPrinting(true);
+    MScore::pdfPrinting = true;
+    MScore::svgPrinting = true;
+    double pixelRatioBackup = MScore::pixelRatio;
+
+    SvgGenerator printer;
+    printer.setReuseGlyphs(reuseGlyphs);
+    printer.setOutputDevice(&buffer);
+    printer.setSize(page->abbox().size().toSize());
+    printer.setViewBox(page->abbox());
+
+    MScore::pixelRatio = DPI / printer.logicalDpiX();
+
+    QPainter painter(&printer);
+    for (Element* e : page->elements()) {
+        printer.setElement(e);
+        paintElement(painter, e);
+    }
+    painter.end();
+
+    MScore::pixelRatio = pixelRatioBackup;
+    MScore::pdfPrinting = false;
+    MScore::svgPrinting = false;
+    score->setPrinting(false);
+
+    return data;
+}
+
+//---------------------------------------------------------
+//   notation
+//    only what the writers use of it
+//---------------------------------------------------------
+
+INotationPtr TestSvgExport::notation(Score* score)
+{
+    std::shared_ptr<NotationElementsMock> elements = std::make_shared<NiceMock<NotationElementsMock> >();
+    ON_CALL(*elements, msScore()).WillByDefault(Return(score));
+
+    std::shared_ptr<NotationMock> notation = std::make_shared<NiceMock<NotationMock> >();
+    ON_CALL(*notation, elements()).WillByDefault(Return(elements));
+
+    return notation;
+}
+
+//---------------------------------------------------------
+//   writePages
+//    all pages at once, or one after another as by
+//    AbstractNotationWriter
+//---------------------------------------------------------
+
+std::vector<QByteArray> TestSvgExport::writePages(AbstractNotationWriter& writer, Score* score, bool sequential)
+{
+    const int pageCount = score->pages().size();
+    std::vector<QByteArray> data(pageCount);
+    std::vector<std::unique_ptr<QBuffer> > buffers;
+    std::vector<mu::system::IODevice*> devices;
+    for (QByteArray& ba : data) {
+        buffers.push_back(std::make_unique<QBuffer>(&ba));
+        buffers.back()->open(QIODevice::WriteOnly);
+        devices.push_back(buffers.back().get());
+    }
+
+    mu::Ret ret = sequential
+                  ? writer.AbstractNotationWriter::writePages(notation(score), devices)
+                  : writer.writePages(notation(score), devices);
+    if (!ret) {
+        return {};
+    }
+    return data;
+}
+
+//---------------------------------------------------------
+//   pngPagesAsSequential
+//    the pages written in one pass by writePages() are
+//    the pages written with one write() each
+//---------------------------------------------------------
+
+void TestSvgExport::pngPagesAsSequential()
+{
+    MasterScore* score = readScore(SVG_DIR + "svgPages.mscx");
+    QVERIFY(score);
+    QVERIFY(score->pages().size() >= 3);
+
+    std::shared_ptr<ImportexportConfigurationMock> configuration = std::make_shared<NiceMock<ImportexportConfigurationMock> >();
+    ON_CALL(*configuration, exportPngDpiResolution()).WillByDefault(Return(100.0f));
+
+    PngWriter writer;
+    writer.setconfiguration(configuration);
+
+    std::vector<QByteArray> sequential = writePages(writer, score, true);
+    std::vector<QByteArray> onePass = writePages(writer, score, false);
+
+    QCOMPARE(int(sequential.size()), score->pages().size());
+    QCOMPARE(onePass.size(), sequential.size());
+    for (size_t i = 0; i < sequential.size(); ++i) {
+        QImage expected = QImage::fromData(sequential[i], "png");
+        QImage actual = QImage::fromData(onePass[i], "png");
+        QVERIFY(!expected.isNull());
+        QCOMPARE(actual, expected);
+    }
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   svgPagesAsSequential
+//---------------------------------------------------------
+
+void TestSvgExport::svgPagesAsSequential()
+{
+    MasterScore* score = readScore(SVG_DIR + "svgPages.mscx");
+    QVERIFY(score);
+    QVERIFY(score->pages().size() >= 3);
+
+    SvgWriter writer;
+
+    std::vector<QByteArray> sequential = writePages(writer, score, true);
+    std::vector<QByteArray> onePass = writePages(writer, score, false);
+
+    QCOMPARE(int(sequential.size()), score->pages().size());
+    QCOMPARE(onePass.size(), sequential.size());
+    for (size_t i = 0; i < sequential.size(); ++i) {
+        QVERIFY(sequential[i].endsWith("</svg>\n"));
+        QCOMPARE(onePass[i], sequential[i]);
+    }
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   reuseGlyphs
+//    every glyph outline is defined once, occurrences are <use>
+//---------------------------------------------------------
+
+void TestSvgExport::reuseGlyphs()
+{
+    MasterScore* score = readScore(SVG_DIR + "svgGlyphs.mscx");
+    QVERIFY(score);
+
+    QByteArray paths = paintPage(score, false);
+    QByteArray reused = paintPage(score, true);
+
+    QVERIFY(!paths.contains("<use"));
+    QVERIFY(reused.contains("<use"));
+    QVERIFY(reused.count("<defs>") < reused.count("<use"));
+    QVERIFY(reused.size() < paths.size());
+    QVERIFY(reused.endsWith("</svg>\n"));
+
+    qDebug("svg size: %d bytes with paths, %d bytes with reused glyphs", paths.size(), reused.size());
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   benchmarkPaths
+//---------------------------------------------------------
+
+void TestSvgExport::benchmarkPaths()
+{
+    MasterScore* score = readScore(SVG_DIR + "svgGlyphs.mscx");
+    QVERIFY(score);
+
+    QBENCHMARK {
+        paintPage(score, false);
+    }
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   benchmarkReusedGlyphs
+//---------------------------------------------------------
+
+void TestSvgExport::benchmarkReusedGlyphs()
+{
+    MasterScore* score = readScore(SVG_DIR + "svgGlyphs.mscx");
+    QVERIFY(score);
+
+    QBENCHMARK {
+        paintPage(score, true);
+    }
+
+    delete score;
+}
+
+QTEST_MAIN(TestSvgExport)
+#include "tst_svg_export.moc"
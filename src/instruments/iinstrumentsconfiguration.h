@@ -33,6 +33,7 @@ public:
     virtual ~IInstrumentsConfiguration() = default;
 
     virtual io::paths instrumentPaths() const = 0;
+    virtual io::path instrumentsCachePath() const = 0;
 };
 }
 
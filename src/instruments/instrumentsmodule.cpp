@@ -96,3 +96,10 @@ void InstrumentsModule::onInit(const IApplication::RunMode&)
 {
     m_instrumentsRepository->init();
 }
+
+void InstrumentsModule::onDelayedInit()
+{
+    //! NOTE The catalogue is only needed by the instruments dialogs and panel,
+    //! it is read after the first frame or when first requested
+    m_instrumentsRepository->loadMeta();
+}
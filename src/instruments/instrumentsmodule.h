@@ -31,6 +31,7 @@ public:
     void registerResources() override;
     void registerUiTypes() override;
     void onInit(const framework::IApplication::RunMode& mode) override;
+    void onDelayedInit() override;
 };
 }
 
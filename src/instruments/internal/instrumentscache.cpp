@@ -0,0 +1,452 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "instrumentscache.h"
+
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QLocale>
+#include <QSaveFile>
+
+#include "log.h"
+
+#include "libmscore/stafftype.h"
+#include "libmscore/xml.h"
+
+using namespace mu;
+using namespace mu::instruments;
+
+static constexpr quint32 CACHE_MAGIC = 0x4d534943;   // "MSIC"
+static constexpr quint32 CACHE_VERSION = 1;
+
+namespace {
+// Channel has no public access to all of its state, it is
+// stored as the same XML fragment that is used in score files
+void writeChannel(QDataStream& out, const Channel& channel)
+{
+    QBuffer buffer;
+    buffer.open(QIODevice::WriteOnly);
+    Ms::XmlWriter xml(nullptr, &buffer);
+    channel.write(xml, nullptr);
+    xml.flush();
+    out << buffer.data();
+}
+
+Channel readChannel(QDataStream& in)
+{
+    QByteArray data;
+    in >> data;
+
+    Channel channel;
+    Ms::XmlReader xml(data);
+    if (xml.readNextStartElement()) {
+        channel.read(xml, nullptr);
+    }
+    return channel;
+}
+
+void writeStaffNames(QDataStream& out, const StaffNameList& names)
+{
+    out << qint32(names.size());
+    for (const StaffName& name : names) {
+        out << name.name() << qint32(name.pos());
+    }
+}
+
+StaffNameList readStaffNames(QDataStream& in)
+{
+    StaffNameList names;
+    qint32 count = 0;
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString name;
+        qint32 pos = 0;
+        in >> name >> pos;
+        names << StaffName(name, pos);
+    }
+    return names;
+}
+
+void writeArticulation(QDataStream& out, const MidiArticulation& articulation)
+{
+    out << articulation.name << articulation.descr << qint32(articulation.velocity) << qint32(articulation.gateTime);
+}
+
+MidiArticulation readArticulation(QDataStream& in)
+{
+    MidiArticulation articulation;
+    qint32 velocity = 0;
+    qint32 gateTime = 0;
+    in >> articulation.name >> articulation.descr >> velocity >> gateTime;
+    articulation.velocity = velocity;
+    articulation.gateTime = gateTime;
+    return articulation;
+}
+
+void writeDrumset(QDataStream& out, const Drumset* drumset)
+{
+    out << bool(drumset);
+    if (!drumset) {
+        return;
+    }
+
+    for (int pitch = 0; pitch < Ms::DRUM_INSTRUMENTS; ++pitch) {
+        const Ms::DrumInstrument& drum = drumset->drum(pitch);
+        out << drum.name << qint32(drum.notehead);
+        for (Ms::SymId sym : drum.noteheads) {
+            out << qint32(sym);
+        }
+        out << qint32(drum.line) << qint32(drum.stemDirection) << qint32(drum.voice) << qint8(drum.shortcut);
+        out << qint32(drum.variants.size());
+        for (const Ms::DrumInstrumentVariant& variant : drum.variants) {
+            out << qint32(variant.pitch) << variant.articulationName << qint32(variant.tremolo);
+        }
+    }
+}
+
+const Drumset* readDrumset(QDataStream& in)
+{
+    bool hasDrumset = false;
+    in >> hasDrumset;
+    if (!hasDrumset) {
+        return nullptr;
+    }
+
+    Drumset* drumset = new Drumset();
+    for (int pitch = 0; pitch < Ms::DRUM_INSTRUMENTS; ++pitch) {
+        Ms::DrumInstrument& drum = drumset->drum(pitch);
+        qint32 notehead = 0;
+        in >> drum.name >> notehead;
+        drum.notehead = Ms::NoteHead::Group(notehead);
+        for (Ms::SymId& sym : drum.noteheads) {
+            qint32 id = 0;
+            in >> id;
+            sym = Ms::SymId(id);
+        }
+        qint32 line = 0;
+        qint32 stemDirection = 0;
+        qint32 voice = 0;
+        qint8 shortcut = 0;
+        qint32 variants = 0;
+        in >> line >> stemDirection >> voice >> shortcut >> variants;
+        drum.line = line;
+        drum.stemDirection = Ms::Direction(stemDirection);
+        drum.voice = voice;
+        drum.shortcut = char(shortcut);
+        drum.variants.clear();
+        for (qint32 i = 0; i < variants && in.status() == QDataStream::Ok; ++i) {
+            Ms::DrumInstrumentVariant variant;
+            qint32 variantPitch = 0;
+            qint32 tremolo = 0;
+            in >> variantPitch >> variant.articulationName >> tremolo;
+            variant.pitch = variantPitch;
+            variant.tremolo = Ms::TremoloType(tremolo);
+            drum.variants.append(variant);
+        }
+    }
+    return drumset;
+}
+
+void writeInstrument(QDataStream& out, const Instrument& instrument)
+{
+    out << instrument.id;
+    writeStaffNames(out, instrument.longNames);
+    writeStaffNames(out, instrument.shortNames);
+    out << instrument.name << instrument.description << instrument.extended << qint32(instrument.staves);
+    out << instrument.groupId << instrument.genreIds;
+    out << qint32(instrument.amateurPitchRange.min) << qint32(instrument.amateurPitchRange.max);
+    out << qint32(instrument.professionalPitchRange.min) << qint32(instrument.professionalPitchRange.max);
+
+    for (int i = 0; i < MAX_STAVES; ++i) {
+        out << qint32(instrument.clefs[i]._concertClef) << qint32(instrument.clefs[i]._transposingClef);
+        out << qint32(instrument.staffLines[i]) << qint32(instrument.bracket[i]) << qint32(instrument.bracketSpan[i]);
+        out << qint32(instrument.barlineSpan[i]) << instrument.smallStaff[i];
+    }
+
+    out << qint32(instrument.transpose.diatonic) << qint32(instrument.transpose.chromatic);
+    out << qint32(instrument.staffGroup);
+    out << (instrument.staffTypePreset ? instrument.staffTypePreset->xmlName() : QString());
+
+    out << instrument.useDrumset;
+    writeDrumset(out, instrument.drumset);
+
+    out << qint32(instrument.stringData.frets()) << qint32(instrument.stringData.stringList().size());
+    for (const Ms::instrString& string : instrument.stringData.stringList()) {
+        out << qint32(string.pitch) << string.open;
+    }
+
+    out << instrument.singleNoteDynamics;
+
+    out << qint32(instrument.midiActions.size());
+    for (const MidiAction& action : instrument.midiActions) {
+        out << action.name << action.description << quint32(action.events.size());
+        for (const midi::Event& event : action.events) {
+            out << quint32(event.to_MIDI10Package());
+        }
+    }
+
+    out << qint32(instrument.midiArticulations.size());
+    for (const MidiArticulation& articulation : instrument.midiArticulations) {
+        writeArticulation(out, articulation);
+    }
+
+    out << qint32(instrument.channels.size());
+    for (const Channel& channel : instrument.channels) {
+        writeChannel(out, channel);
+    }
+}
+
+Instrument readInstrument(QDataStream& in)
+{
+    Instrument instrument;
+    qint32 staves = 0;
+
+    in >> instrument.id;
+    instrument.longNames = readStaffNames(in);
+    instrument.shortNames = readStaffNames(in);
+    in >> instrument.name >> instrument.description >> instrument.extended >> staves;
+    instrument.staves = staves;
+    in >> instrument.groupId >> instrument.genreIds;
+
+    qint32 min = 0;
+    qint32 max = 0;
+    in >> min >> max;
+    instrument.amateurPitchRange = PitchRange(min, max);
+    in >> min >> max;
+    instrument.professionalPitchRange = PitchRange(min, max);
+
+    for (int i = 0; i < MAX_STAVES; ++i) {
+        qint32 concertClef = 0;
+        qint32 transposingClef = 0;
+        qint32 staffLines = 0;
+        qint32 bracket = 0;
+        qint32 bracketSpan = 0;
+        qint32 barlineSpan = 0;
+        in >> concertClef >> transposingClef >> staffLines >> bracket >> bracketSpan >> barlineSpan >> instrument.smallStaff[i];
+        instrument.clefs[i]._concertClef = ClefType(concertClef);
+        instrument.clefs[i]._transposingClef = ClefType(transposingClef);
+        instrument.staffLines[i] = staffLines;
+        instrument.bracket[i] = BracketType(bracket);
+        instrument.bracketSpan[i] = bracketSpan;
+        instrument.barlineSpan[i] = barlineSpan;
+    }
+
+    qint32 diatonic = 0;
+    qint32 chromatic = 0;
+    qint32 staffGroup = 0;
+    QString staffTypePreset;
+    in >> diatonic >> chromatic >> staffGroup >> staffTypePreset;
+    instrument.transpose = Interval(diatonic, chromatic);
+    instrument.staffGroup = StaffGroup(staffGroup);
+    if (!staffTypePreset.isEmpty()) {
+        instrument.staffTypePreset = StaffType::presetFromXmlName(staffTypePreset);
+    }
+
+    in >> instrument.useDrumset;
+    instrument.drumset = readDrumset(in);
+
+    qint32 frets = 0;
+    qint32 strings = 0;
+    in >> frets >> strings;
+    QList<Ms::instrString> stringList;
+    for (qint32 i = 0; i < strings && in.status() == QDataStream::Ok; ++i) {
+        qint32 pitch = 0;
+        bool open = false;
+        in >> pitch >> open;
+        stringList << Ms::instrString { pitch, open };
+    }
+    instrument.stringData = StringData(frets, stringList);
+
+    in >> instrument.singleNoteDynamics;
+
+    qint32 actions = 0;
+    in >> actions;
+    for (qint32 i = 0; i < actions && in.status() == QDataStream::Ok; ++i) {
+        MidiAction action;
+        quint32 events = 0;
+        in >> action.name >> action.description >> events;
+        for (quint32 j = 0; j < events && in.status() == QDataStream::Ok; ++j) {
+            quint32 package = 0;
+            in >> package;
+            action.events.push_back(midi::Event::fromMIDI10Package(package));
+        }
+        instrument.midiActions << action;
+    }
+
+    qint32 articulations = 0;
+    in >> articulations;
+    for (qint32 i = 0; i < articulations && in.status() == QDataStream::Ok; ++i) {
+        instrument.midiArticulations << readArticulation(in);
+    }
+
+    qint32 channels = 0;
+    in >> channels;
+    for (qint32 i = 0; i < channels && in.status() == QDataStream::Ok; ++i) {
+        instrument.channels << readChannel(in);
+    }
+
+    return instrument;
+}
+
+void writeMeta(QDataStream& out, const InstrumentsMeta& meta)
+{
+    out << qint32(meta.instrumentTemplates.size());
+    for (const InstrumentTemplate& instrumentTemplate : meta.instrumentTemplates) {
+        out << instrumentTemplate.id;
+        writeInstrument(out, instrumentTemplate.instrument);
+    }
+
+    out << qint32(meta.groups.size());
+    for (const InstrumentGroup& group : meta.groups) {
+        out << group.id << group.name << group.extended << qint32(group.sequenceOrder);
+    }
+
+    out << qint32(meta.genres.size());
+    for (const InstrumentGenre& genre : meta.genres) {
+        out << genre.id << genre.name;
+    }
+
+    out << qint32(meta.articulations.size());
+    for (auto it = meta.articulations.cbegin(); it != meta.articulations.cend(); ++it) {
+        out << it.key();
+        writeArticulation(out, it.value());
+    }
+}
+
+InstrumentsMeta readMeta(QDataStream& in)
+{
+    InstrumentsMeta meta;
+
+    qint32 count = 0;
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        InstrumentTemplate instrumentTemplate;
+        in >> instrumentTemplate.id;
+        instrumentTemplate.instrument = readInstrument(in);
+        meta.instrumentTemplates.insert(instrumentTemplate.id, instrumentTemplate);
+    }
+
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        InstrumentGroup group;
+        qint32 sequenceOrder = 0;
+        in >> group.id >> group.name >> group.extended >> sequenceOrder;
+        group.sequenceOrder = sequenceOrder;
+        meta.groups.insert(group.id, group);
+    }
+
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        InstrumentGenre genre;
+        in >> genre.id >> genre.name;
+        meta.genres.insert(genre.id, genre);
+    }
+
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString key;
+        in >> key;
+        meta.articulations.insert(key, readArticulation(in));
+    }
+
+    return meta;
+}
+}
+
+QByteArray InstrumentsCache::sourcesKey(const io::paths& files)
+{
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(QLocale().name().toUtf8());
+
+    for (const io::path& file : files) {
+        QFileInfo info(file.toQString());
+        hash.addData(info.absoluteFilePath().toUtf8());
+        hash.addData(QByteArray::number(info.size()));
+        hash.addData(QByteArray::number(info.lastModified().toMSecsSinceEpoch()));
+    }
+
+    return hash.result();
+}
+
+RetVal<InstrumentsMeta> InstrumentsCache::read(const io::path& cachePath, const QByteArray& key)
+{
+    RetVal<InstrumentsMeta> result;
+
+    QFile file(cachePath.toQString());
+    if (!file.open(QIODevice::ReadOnly)) {
+        result.ret = make_ret(Ret::Code::UnknownError);
+        return result;
+    }
+
+    // the snapshot is mapped and deserialised in place,
+    // fall back to reading it if mapping is not possible
+    QByteArray data;
+    uchar* mapped = file.map(0, file.size());
+    if (mapped) {
+        data = QByteArray::fromRawData(reinterpret_cast<const char*>(mapped), int(file.size()));
+    } else {
+        data = file.readAll();
+    }
+
+    QDataStream in(data);
+    in.setVersion(QDataStream::Qt_5_12);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    QByteArray cacheKey;
+    in >> magic >> version >> cacheKey;
+
+    if (magic != CACHE_MAGIC || version != CACHE_VERSION || cacheKey != key) {
+        result.ret = make_ret(Ret::Code::UnknownError);
+        return result;
+    }
+
+    result.val = readMeta(in);
+    if (in.status() != QDataStream::Ok) {
+        LOGE() << "corrupted instruments cache: " << cachePath;
+        result.val = InstrumentsMeta();
+        result.ret = make_ret(Ret::Code::UnknownError);
+        return result;
+    }
+
+    result.ret = make_ret(Ret::Code::Ok);
+    return result;
+}
+
+Ret InstrumentsCache::write(const io::path& cachePath, const QByteArray& key, const InstrumentsMeta& meta)
+{
+    QSaveFile file(cachePath.toQString());
+    if (!file.open(QIODevice::WriteOnly)) {
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_12);
+    out << CACHE_MAGIC << CACHE_VERSION << key;
+    writeMeta(out, meta);
+
+    if (out.status() != QDataStream::Ok || !file.commit()) {
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    return make_ret(Ret::Code::Ok);
+}
@@ -0,0 +1,44 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_INSTRUMENTS_INSTRUMENTSCACHE_H
+#define MU_INSTRUMENTS_INSTRUMENTSCACHE_H
+
+#include <QByteArray>
+
+#include "retval.h"
+#include "io/path.h"
+
+#include "instrumentstypes.h"
+
+namespace mu::instruments {
+//! Binary snapshot of the parsed instruments catalogue.
+//! The snapshot is tied to a key built from the source files
+//! (path, size, modification time) and the UI language, because
+//! names are translated while reading the XML files.
+class InstrumentsCache
+{
+public:
+    static QByteArray sourcesKey(const io::paths& files);
+
+    static RetVal<InstrumentsMeta> read(const io::path& cachePath, const QByteArray& key);
+    static Ret write(const io::path& cachePath, const QByteArray& key, const InstrumentsMeta& meta);
+};
+}
+
+#endif // MU_INSTRUMENTS_INSTRUMENTSCACHE_H
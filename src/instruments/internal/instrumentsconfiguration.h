@@ -33,6 +33,7 @@ class InstrumentsConfiguration : public IInstrumentsConfiguration
 
 public:
     io::paths instrumentPaths() const override;
+    io::path instrumentsCachePath() const override;
 
 private:
     io::paths extensionsPaths() const;
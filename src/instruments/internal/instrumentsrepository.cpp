@@ -18,11 +18,15 @@
 //=============================================================================
 #include "instrumentsrepository.h"
 
+#include <QElapsedTimer>
+
 #include "log.h"
 #include "translation.h"
 
 #include "libmscore/instrtemplate.h"
 
+#include "instrumentscache.h"
+
 using namespace mu;
 using namespace mu::instruments;
 using namespace mu::extensions;
@@ -39,12 +43,25 @@ void InstrumentsRepository::init()
         });
     }
 
-    load();
+    QMutexLocker locker(&m_instrumentsMutex);
+    deferTemplates();
+}
+
+void InstrumentsRepository::loadMeta()
+{
+    QMutexLocker locker(&m_instrumentsMutex);
+    if (!m_instrumentsMetaLoaded) {
+        readMeta();
+    }
 }
 
 RetValCh<InstrumentsMeta> InstrumentsRepository::instrumentsMeta()
 {
     QMutexLocker locker(&m_instrumentsMutex);
+    if (!m_instrumentsMetaLoaded) {
+        readMeta();
+    }
+
     RetValCh<InstrumentsMeta> result;
     result.ret = make_ret(Ret::Code::Ok);
     result.val = m_instrumentsMeta;
@@ -58,9 +75,14 @@ void InstrumentsRepository::load()
     QMutexLocker locker(&m_instrumentsMutex);
 
     clear();
+    deferTemplates();
+    readMeta();
+}
 
+io::paths InstrumentsRepository::instrumentsFiles() const
+{
     std::vector<io::path> instrumentsPaths = configuration()->instrumentPaths();
-    std::vector<io::path> instrumentsFiles;
+    io::paths instrumentsFiles;
 
     for (const io::path& path: instrumentsPaths) {
         RetVal<io::paths> files = fileSystem()->scanFiles(path, { QString("*.xml") });
@@ -73,6 +95,62 @@ void InstrumentsRepository::load()
         }
     }
 
+    return instrumentsFiles;
+}
+
+void InstrumentsRepository::deferTemplates()
+{
+    // the legacy template list is only used by importers and
+    // plugins, it is read on first use
+    m_instrumentsFiles = instrumentsFiles();
+    for (const io::path& filePath: m_instrumentsFiles) {
+        Ms::deferInstrumentTemplates(filePath.toQString());
+    }
+}
+
+void InstrumentsRepository::readMeta()
+{
+    QElapsedTimer timer;
+    timer.start();
+
+    // the parsed catalogue is taken from the binary snapshot
+    // as long as none of the source files has changed
+    const io::path cachePath = configuration()->instrumentsCachePath();
+    const QByteArray cacheKey = InstrumentsCache::sourcesKey(m_instrumentsFiles);
+
+    RetVal<InstrumentsMeta> cached;
+    if (!cachePath.empty()) {
+        cached = InstrumentsCache::read(cachePath, cacheKey);
+    }
+
+    if (cached.ret) {
+        m_instrumentsMeta = cached.val;
+    } else {
+        m_instrumentsMeta = readInstrumentsMeta(m_instrumentsFiles);
+
+        if (!cachePath.empty()) {
+            Ret ret = InstrumentsCache::write(cachePath, cacheKey, m_instrumentsMeta);
+            if (!ret) {
+                LOGE() << "failed write instruments cache: " << cachePath;
+            }
+        }
+    }
+
+    for (InstrumentTemplate& instrumentTemplate: m_instrumentsMeta.instrumentTemplates) {
+        instrumentTemplate.transposition = transposition(instrumentTemplate.id);
+    }
+
+    m_instrumentsMetaLoaded = true;
+
+    LOGI() << "instruments loaded " << (cached.ret ? "from cache" : "from xml") << " in " << timer.elapsed() << " ms";
+
+    m_instrumentsMetaChannel.send(m_instrumentsMeta);
+}
+
+InstrumentsMeta InstrumentsRepository::readInstrumentsMeta(const io::paths& instrumentsFiles) const
+{
+    InstrumentsMeta result;
+
     int globalGroupsSequenceOrder = 0;
     auto correctGroupSequenceOrder = [&globalGroupsSequenceOrder](const InstrumentGroup& group) {
         InstrumentGroup correctedGroup = group;
@@ -90,34 +168,28 @@ void InstrumentsRepository::load()
 
         const InstrumentTemplateMap& templates = metaInstrument.val.instrumentTemplates;
         for (auto it = templates.cbegin(); it != templates.cend(); ++it) {
-            m_instrumentsMeta.instrumentTemplates.insert(it.key(), it.value());
+            result.instrumentTemplates.insert(it.key(), it.value());
         }
 
         const MidiArticulationMap& acticulations = metaInstrument.val.articulations;
         for (auto it = acticulations.cbegin(); it != acticulations.cend(); ++it) {
-            m_instrumentsMeta.articulations.insert(it.key(), it.value());
+            result.articulations.insert(it.key(), it.value());
         }
 
         const InstrumentGenreMap& genres = metaInstrument.val.genres;
         for (auto it = genres.cbegin(); it != genres.cend(); ++it) {
-            m_instrumentsMeta.genres.insert(it.key(), it.value());
+            result.genres.insert(it.key(), it.value());
         }
 
         const InstrumentGroupMap& groups = metaInstrument.val.groups;
         for (auto it = groups.cbegin(); it != groups.cend(); ++it) {
             InstrumentGroup group = correctGroupSequenceOrder(it.value());
-            m_instrumentsMeta.groups.insert(it.key(), group);
+            result.groups.insert(it.key(), group);
         }
         globalGroupsSequenceOrder += groups.size();
-
-        Ms::loadInstrumentTemplates(filePath.toQString());
     }
 
-    for (InstrumentTemplate& instrumentTemplate: m_instrumentsMeta.instrumentTemplates) {
-        instrumentTemplate.transposition = transposition(instrumentTemplate.id);
-    }
-
-    m_instrumentsMetaChannel.send(m_instrumentsMeta);
+    return result;
 }
 
 void InstrumentsRepository::clear()
@@ -128,6 +200,7 @@ void InstrumentsRepository::clear()
     m_instrumentsMeta.genres.clear();
     m_instrumentsMeta.groups.clear();
     m_instrumentsMeta.articulations.clear();
+    m_instrumentsMetaLoaded = false;
 }
 
 Transposition InstrumentsRepository::transposition(const QString& instrumentTemplateId) const
@@ -45,16 +45,27 @@ class InstrumentsRepository : public IInstrumentsRepository, public async::Async
 public:
     void init();
 
+    //! Reads the instruments catalogue, if it was not already requested
+    void loadMeta();
+
     RetValCh<InstrumentsMeta> instrumentsMeta() override;
 
 private:
     void load();
     void clear();
 
+    io::paths instrumentsFiles() const;
+    void deferTemplates();
+    void readMeta();
+
+    InstrumentsMeta readInstrumentsMeta(const io::paths& instrumentsFiles) const;
+
     Transposition transposition(const QString& instrumentTemplateId) const;
 
     QMutex m_instrumentsMutex;
+    io::paths m_instrumentsFiles;
     InstrumentsMeta m_instrumentsMeta;
+    bool m_instrumentsMetaLoaded = false;
 
     async::Channel<InstrumentsMeta> m_instrumentsMetaChannel;
 };
@@ -0,0 +1,243 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <future>
+#include <thread>
+
+#include <QBuffer>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "instruments/internal/instrumentscache.h"
+#include "instruments/internal/instrumentsreader.h"
+
+#include "system/tests/mocks/filesystemmock.h"
+
+#include "libmscore/drumset.h"
+#include "libmscore/instrtemplate.h"
+#include "libmscore/mscore.h"
+#include "libmscore/xml.h"
+
+using ::testing::Return;
+
+using namespace mu;
+using namespace mu::instruments;
+using namespace mu::system;
+
+class InstrumentsCacheTest : public ::testing::Test
+{
+protected:
+    static void SetUpTestCase()
+    {
+        Ms::MScore::init();
+    }
+
+    void SetUp() override
+    {
+        m_reader = std::make_shared<InstrumentsReader>();
+        m_fileSystem = std::make_shared<FileSystemMock>();
+
+        m_reader->setfileSystem(m_fileSystem);
+    }
+
+    static QByteArray channelXml(const Channel& channel)
+    {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        Ms::XmlWriter xml(nullptr, &buffer);
+        channel.write(xml, nullptr);
+        xml.flush();
+        return buffer.data();
+    }
+
+    static void expectEqual(const Instrument& expected, const Instrument& actual)
+    {
+        EXPECT_EQ(expected.id, actual.id);
+        EXPECT_EQ(expected.longNames, actual.longNames);
+        EXPECT_EQ(expected.shortNames, actual.shortNames);
+        EXPECT_EQ(expected.name, actual.name);
+        EXPECT_EQ(expected.description, actual.description);
+        EXPECT_EQ(expected.extended, actual.extended);
+        EXPECT_EQ(expected.staves, actual.staves);
+        EXPECT_EQ(expected.groupId, actual.groupId);
+        EXPECT_EQ(expected.genreIds, actual.genreIds);
+        EXPECT_EQ(expected.amateurPitchRange, actual.amateurPitchRange);
+        EXPECT_EQ(expected.professionalPitchRange, actual.professionalPitchRange);
+
+        for (int i = 0; i < MAX_STAVES; ++i) {
+            EXPECT_EQ(expected.clefs[i], actual.clefs[i]);
+            EXPECT_EQ(expected.staffLines[i], actual.staffLines[i]);
+            EXPECT_EQ(expected.bracket[i], actual.bracket[i]);
+            EXPECT_EQ(expected.bracketSpan[i], actual.bracketSpan[i]);
+            EXPECT_EQ(expected.barlineSpan[i], actual.barlineSpan[i]);
+            EXPECT_EQ(expected.smallStaff[i], actual.smallStaff[i]);
+        }
+
+        EXPECT_EQ(expected.transpose, actual.transpose);
+        EXPECT_EQ(expected.staffGroup, actual.staffGroup);
+        EXPECT_EQ(expected.staffTypePreset, actual.staffTypePreset);
+        EXPECT_EQ(expected.useDrumset, actual.useDrumset);
+
+        ASSERT_EQ(bool(expected.drumset), bool(actual.drumset));
+        if (expected.drumset) {
+            for (int pitch = 0; pitch < Ms::DRUM_INSTRUMENTS; ++pitch) {
+                const Ms::DrumInstrument& expectedDrum = expected.drumset->drum(pitch);
+                const Ms::DrumInstrument& actualDrum = actual.drumset->drum(pitch);
+                EXPECT_EQ(expectedDrum.name, actualDrum.name);
+                EXPECT_EQ(expectedDrum.notehead, actualDrum.notehead);
+                EXPECT_EQ(expectedDrum.line, actualDrum.line);
+                EXPECT_EQ(expectedDrum.stemDirection, actualDrum.stemDirection);
+                EXPECT_EQ(expectedDrum.voice, actualDrum.voice);
+                EXPECT_EQ(expectedDrum.shortcut, actualDrum.shortcut);
+                EXPECT_EQ(expectedDrum.variants.size(), actualDrum.variants.size());
+            }
+        }
+
+        EXPECT_EQ(expected.stringData, actual.stringData);
+        EXPECT_EQ(expected.singleNoteDynamics, actual.singleNoteDynamics);
+
+        ASSERT_EQ(expected.midiActions.size(), actual.midiActions.size());
+        for (int i = 0; i < expected.midiActions.size(); ++i) {
+            EXPECT_EQ(expected.midiActions[i].name, actual.midiActions[i].name);
+            EXPECT_EQ(expected.midiActions[i].description, actual.midiActions[i].description);
+            EXPECT_EQ(expected.midiActions[i].events.size(), actual.midiActions[i].events.size());
+        }
+
+        EXPECT_EQ(expected.midiArticulations, actual.midiArticulations);
+
+        ASSERT_EQ(expected.channels.size(), actual.channels.size());
+        for (int i = 0; i < expected.channels.size(); ++i) {
+            EXPECT_EQ(channelXml(expected.channels[i]), channelXml(actual.channels[i]));
+        }
+    }
+
+    std::shared_ptr<InstrumentsReader> m_reader;
+    std::shared_ptr<FileSystemMock> m_fileSystem;
+};
+
+TEST_F(InstrumentsCacheTest, RoundTrip)
+{
+    // [GIVEN] The instruments catalogue read from XML
+    io::path instrumentsPath = INSTRUMENTS_XML_PATH;
+
+    QFile file(instrumentsPath.toQString());
+    ASSERT_TRUE(file.open(QIODevice::ReadOnly));
+
+    ON_CALL(*m_fileSystem, readFile(instrumentsPath))
+    .WillByDefault(Return(RetVal<QByteArray>::make_ok(file.readAll())));
+
+    RetVal<InstrumentsMeta> fromXml = m_reader->readMeta(instrumentsPath);
+    ASSERT_TRUE(fromXml.ret);
+    ASSERT_FALSE(fromXml.val.instrumentTemplates.isEmpty());
+
+    // [WHEN] The catalogue is written to a snapshot and read back
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    io::path cachePath = dir.filePath("instruments.cache");
+    QByteArray key = InstrumentsCache::sourcesKey({ instrumentsPath });
+
+    ASSERT_TRUE(InstrumentsCache::write(cachePath, key, fromXml.val));
+    RetVal<InstrumentsMeta> fromCache = InstrumentsCache::read(cachePath, key);
+
+    // [THEN] It is the same catalogue
+    ASSERT_TRUE(fromCache.ret);
+
+    const InstrumentsMeta& expected = fromXml.val;
+    const InstrumentsMeta& actual = fromCache.val;
+
+    ASSERT_EQ(expected.instrumentTemplates.keys(), actual.instrumentTemplates.keys());
+    for (const InstrumentTemplate& expectedTemplate : expected.instrumentTemplates) {
+        const InstrumentTemplate& actualTemplate = actual.instrumentTemplates[expectedTemplate.id];
+        EXPECT_EQ(expectedTemplate.id, actualTemplate.id);
+        expectEqual(expectedTemplate.instrument, actualTemplate.instrument);
+    }
+
+    ASSERT_EQ(expected.groups.keys(), actual.groups.keys());
+    for (const InstrumentGroup& group : expected.groups) {
+        EXPECT_EQ(group.name, actual.groups[group.id].name);
+        EXPECT_EQ(group.extended, actual.groups[group.id].extended);
+        EXPECT_EQ(group.sequenceOrder, actual.groups[group.id].sequenceOrder);
+    }
+
+    ASSERT_EQ(expected.genres.keys(), actual.genres.keys());
+    for (const InstrumentGenre& genre : expected.genres) {
+        EXPECT_EQ(genre.name, actual.genres[genre.id].name);
+    }
+
+    EXPECT_EQ(expected.articulations, actual.articulations);
+}
+
+TEST_F(InstrumentsCacheTest, StaleKey)
+{
+    // [GIVEN] A snapshot written for some sources
+    QTemporaryDir dir;
+    ASSERT_TRUE(dir.isValid());
+    io::path cachePath = dir.filePath("instruments.cache");
+
+    InstrumentsMeta meta;
+    InstrumentGenre genre;
+    genre.id = "common";
+    genre.name = "Common";
+    meta.genres.insert(genre.id, genre);
+
+    ASSERT_TRUE(InstrumentsCache::write(cachePath, "key", meta));
+
+    // [THEN] It is used for the same sources only
+    EXPECT_TRUE(InstrumentsCache::read(cachePath, "key").ret);
+    EXPECT_FALSE(InstrumentsCache::read(cachePath, "other key").ret);
+}
+
+TEST_F(InstrumentsCacheTest, DeferredTemplates)
+{
+    // [GIVEN] The templates file is read on first use, as with a valid snapshot
+    Ms::clearInstrumentTemplates();
+    Ms::deferInstrumentTemplates(INSTRUMENTS_XML_PATH);
+
+    // [WHEN] Templates are looked up on two threads at once
+    //! NOTE Reading the file looks up the templates named by <init> and <ref>,
+    //! a deadlock there must fail the test instead of hanging it
+    auto search = [](const QString& id) {
+        auto found = std::make_shared<std::promise<Ms::InstrumentTemplate*> >();
+        std::thread([found, id]() {
+            found->set_value(Ms::searchTemplate(id));
+        }).detach();
+        return found->get_future();
+    };
+    std::future<Ms::InstrumentTemplate*> banjo = search("banjo");
+    std::future<Ms::InstrumentTemplate*> violin = search("violin");
+
+    // [THEN] Both find their template once the file is read
+    ASSERT_EQ(banjo.wait_for(std::chrono::seconds(60)), std::future_status::ready);
+    ASSERT_EQ(violin.wait_for(std::chrono::seconds(60)), std::future_status::ready);
+
+    Ms::InstrumentTemplate* banjoTemplate = banjo.get();
+    ASSERT_TRUE(banjoTemplate);
+    EXPECT_EQ(banjoTemplate->id, "banjo");
+
+    Ms::InstrumentTemplate* violinTemplate = violin.get();
+    ASSERT_TRUE(violinTemplate);
+    EXPECT_EQ(violinTemplate->id, "violin");
+
+    // [THEN] Later lookups on this thread do not read the file again
+    EXPECT_EQ(Ms::searchTemplate("banjo"), banjoTemplate);
+
+    Ms::clearInstrumentTemplates();
+}
@@ -13,6 +13,8 @@
 #include "audio.h"
 #include "xml.h"
 
+#include "thirdparty/qzip/qzipreader_p.h"
+
 namespace Ms {
 //---------------------------------------------------------
 //   Audio
@@ -22,6 +24,21 @@ Audio::Audio()
 {
 }
 
+//---------------------------------------------------------
+//   load
+//    read audio.ogg from the score archive on first use
+//---------------------------------------------------------
+
+void Audio::load() const
+{
+    if (_archivePath.isEmpty()) {
+        return;
+    }
+    MQZipReader uz(_archivePath);
+    _data = uz.fileData("audio.ogg");
+    _archivePath.clear();
+}
+
 //---------------------------------------------------------
 //   read
 //---------------------------------------------------------
@@ -27,15 +27,20 @@ class XmlReader;
 class Audio
 {
     QString _path;
-    QByteArray _data;
+    mutable QByteArray _data;
+    mutable QString _archivePath;   // .mscz the data is read from on first use
+
+    void load() const;
 
 public:
     Audio();
     const QString& path() const { return _path; }
     void setPath(const QString& s) { _path = s; }
-    const QByteArray& data() const { return _data; }
-    QByteArray data() { return _data; }
-    void setData(const QByteArray& ba) { _data = ba; }
+    const QByteArray& data() const { load(); return _data; }
+    QByteArray data() { load(); return _data; }
+    void setData(const QByteArray& ba) { _data = ba; _archivePath.clear(); }
+    void setArchive(const QString& archivePath) { _data.clear(); _archivePath = archivePath; }
+    const QString& archivePath() const { return _archivePath; }
 
     void read(XmlReader&);
     void write(XmlWriter&) const;
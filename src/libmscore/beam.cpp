@@ -51,6 +51,12 @@ static const ElementStyle beamStyle {
 struct BeamFragment {
     qreal py1[2];
     qreal py2[2];
+
+    // inputs and result of the last computeStemLen() for this fragment,
+    // see Beam::stemLenKey()
+    std::vector<qreal> stemLenKey;
+    qreal stemLenPy1   { 0.0 };
+    qreal stemLenSlope { 0.0 };
 };
 
 //---------------------------------------------------------
@@ -1605,6 +1611,54 @@ void Beam::computeStemLen(const std::vector<ChordRest*>& cl, qreal& py1, int bea
     }
 }
 
+//---------------------------------------------------------
+//   stemLenKey
+//    everything computeStemLen() depends on, in page
+//    coordinates; if it did not change since the last
+//    layout, the stored result is reused
+//    returns an empty key if the result can not be reused
+//---------------------------------------------------------
+
+std::vector<qreal> Beam::stemLenKey(const std::vector<ChordRest*>& cl, qreal py1, int beamLevels)
+{
+    std::vector<qreal> key;
+    for (const ChordRest* cr : cl) {
+        // minAbsStemLength() lays out the tremolo
+        if (cr->isChord() && toChord(cr)->tremolo()) {
+            return std::vector<qreal>();
+        }
+    }
+
+    const Staff* st = staff();
+    key.reserve(16 + cl.size() * 7);
+    key.push_back(py1);
+    key.push_back(beamLevels);
+    key.push_back(_up);
+    key.push_back(_isGrace);
+    key.push_back(_isGrace && cl.front()->isChord() && toChord(cl.front())->underBeam());
+    key.push_back(hasNoSlope());
+    key.push_back(elements().size());
+    key.push_back(spatium());
+    key.push_back(_beamDist);
+    key.push_back(score()->styleP(Sid::beamWidth));
+    key.push_back(st->isTabStaff(Fraction(0,1)));
+    key.push_back(st->lineDistance(Fraction(0,1)));
+    key.push_back(cl.front()->pagePos().x());
+    key.push_back(cl.back()->pagePos().x());
+
+    for (const ChordRest* cr : cl) {
+        const QPointF p = cr->stemPosBeam();
+        key.push_back(cr->isChord());
+        key.push_back(cr->up());
+        key.push_back(cr->small());
+        key.push_back(cr->line(true));
+        key.push_back(cr->line(false));
+        key.push_back(p.x());
+        key.push_back(p.y());
+    }
+    return key;
+}
+
 //---------------------------------------------------------
 //   layout2
 //---------------------------------------------------------
@@ -1777,7 +1831,16 @@ void Beam::layout2(std::vector<ChordRest*> crl, SpannerSegmentType, int frag)
         } else {
             py1 = c1->stemPos().y();
             py2 = c2->stemPos().y();            // for debug
-            computeStemLen(crl, py1, beamLevels);
+            std::vector<qreal> key = stemLenKey(crl, py1, beamLevels);
+            if (!key.empty() && key == f->stemLenKey) {
+                py1   = f->stemLenPy1;
+                slope = f->stemLenSlope;
+            } else {
+                computeStemLen(crl, py1, beamLevels);
+                f->stemLenKey   = std::move(key);
+                f->stemLenPy1   = py1;
+                f->stemLenSlope = slope;
+            }
         }
         py2  = (px2 - px1) * slope + py1;       // for debug
         py2 -= _pagePos.y();
@@ -64,6 +64,7 @@ class Beam final : public Element
     void layout2(std::vector<ChordRest*>, SpannerSegmentType, int frag);
     bool twoBeamedNotes();
     void computeStemLen(const std::vector<ChordRest*>& crl, qreal& py1, int beamLevels);
+    std::vector<qreal> stemLenKey(const std::vector<ChordRest*>& crl, qreal py1, int beamLevels);
     bool slopeZero(const std::vector<ChordRest*>& crl);
     bool hasNoSlope();
     void addChordRest(ChordRest* a);
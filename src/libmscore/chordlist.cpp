@@ -1560,6 +1560,28 @@ const QList<RenderAction>& ParsedChord::renderList(const ChordList* cl)
     return _renderList;
 }
 
+//---------------------------------------------------------
+//   parsedChord
+//    parse name against this chord list, or return the
+//    result of an earlier parse of the same name;
+//    the render list of the parsed chord is generated
+//---------------------------------------------------------
+
+std::shared_ptr<const ParsedChord> ChordList::parsedChord(const QString& name, bool syntaxOnly, bool preferMinor) const
+{
+    const QPair<QString, int> key(name, (syntaxOnly ? 1 : 0) | (preferMinor ? 2 : 0));
+    auto i = _parsedChords.constFind(key);
+    if (i != _parsedChords.constEnd()) {
+        return i.value();
+    }
+
+    std::shared_ptr<ParsedChord> pc = std::make_shared<ParsedChord>();
+    pc->parse(name, this, syntaxOnly, preferMinor);
+    pc->renderList(this);
+    _parsedChords.insert(key, pc);
+    return pc;
+}
+
 //---------------------------------------------------------
 //   addToken
 //---------------------------------------------------------
@@ -1613,21 +1635,22 @@ ChordDescription::ChordDescription(const QString& name)
 //    generate missing renderList and semantic (Xml) info
 //---------------------------------------------------------
 
-void ChordDescription::complete(ParsedChord* pc, const ChordList* cl)
+void ChordDescription::complete(const ParsedChord* pc, const ChordList* cl)
 {
     ParsedChord tempPc;
     if (!pc) {
         // generate parsed chord for its rendering & semantic (xml) info
-        pc = &tempPc;
+        // (not from the parsed chord cache: cl may still be read)
         QString n;
         if (!names.empty()) {
             n = names.front();
         }
-        pc->parse(n, cl);
+        tempPc.parse(n, cl);
+        pc = &tempPc;
     }
     parsedChords.append(*pc);
     if (renderList.empty() || renderListGenerated) {
-        renderList = pc->renderList(cl);
+        renderList = parsedChords.last().renderList(cl);
         renderListGenerated = true;
     }
     if (xmlKind == "") {
@@ -1716,6 +1739,7 @@ void ChordList::configureAutoAdjust(qreal emag, qreal eadjust, qreal mmag, qreal
     _eadjust = eadjust;
     _mmag = mmag;
     _madjust = madjust;
+    clearParsedChords();
 #if 0
     // TODO: regenerate all chord descriptions
     // currently we always reload the entire chordlist
@@ -1737,6 +1761,7 @@ void ChordList::configureAutoAdjust(qreal emag, qreal eadjust, qreal mmag, qreal
 
 void ChordList::read(XmlReader& e)
 {
+    clearParsedChords();
     int fontIdx = 0;
     _autoAdjust = false;
     while (e.readNextStartElement()) {
@@ -2003,6 +2028,7 @@ void ChordList::unload()
     renderListBase.clear();
     chordTokenList.clear();
     _autoAdjust = false;
+    clearParsedChords();
 }
 
 //---------------------------------------------------------
@@ -13,6 +13,9 @@
 #ifndef __CHORDLIST_H__
 #define __CHORDLIST_H__
 
+#include <memory>
+
+#include <QHash>
 #include <QMap>
 
 namespace Ms {
@@ -138,6 +141,7 @@ public:
     bool parse(const QString&, const ChordList*, bool syntaxOnly = false, bool preferMinor = false);
     QString fromXml(const QString&, const QString&, const QString&, const QString&, const QList<HDegree>&,const ChordList*);
     const QList<RenderAction>& renderList(const ChordList*);
+    const QList<RenderAction>& renderList() const { return _renderList; }
     bool parseable() const { return _parseable; }
     bool understandable() const { return _understandable; }
     const QString& name() const { return _name; }
@@ -208,7 +212,7 @@ public:
     ChordDescription(int);
     ChordDescription(const QString&);
     QString quality() const { return _quality; }
-    void complete(ParsedChord* pc, const ChordList*);
+    void complete(const ParsedChord* pc, const ChordList*);
     void read(XmlReader&);
     void write(XmlWriter&) const;
 };
@@ -249,6 +253,9 @@ class ChordList : public QMap<int, ChordDescription>
     qreal _emag = 1.0, _eadjust = 0.0;
     qreal _mmag = 1.0, _madjust = 0.0;
 
+    // parsed chord names, shared by all Harmony elements using this list
+    mutable QHash<QPair<QString, int>, std::shared_ptr<const ParsedChord> > _parsedChords;
+
 public:
     QList<ChordFont> fonts;
     QList<RenderAction> renderListRoot;
@@ -270,6 +277,9 @@ public:
     bool loaded() const;
     void unload();
     ChordSymbol symbol(const QString& s) const { return symbols.value(s); }
+
+    std::shared_ptr<const ParsedChord> parsedChord(const QString& name, bool syntaxOnly = false, bool preferMinor = false) const;
+    void clearParsedChords() { _parsedChords.clear(); }
 };
 }     // namespace Ms
 #endif
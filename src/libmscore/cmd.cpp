@@ -251,10 +251,30 @@ void Score::undoRedo(bool undo, EditData* ed)
         undoStack()->redo(ed);
     }
     update(false);
+    recordChangesWithoutLayout();
     masterScore()->setPlaylistDirty();    // TODO: flag all individual operations
+    masterScore()->updateSnapshot();
     updateSelection();
 }
 
+//---------------------------------------------------------
+//   recordChangesWithoutLayout
+//    update() records the changes of commands with a
+//    layout range, record the ones that only asked for
+//    a redraw
+//---------------------------------------------------------
+
+void Score::recordChangesWithoutLayout()
+{
+    MasterScore* ms = masterScore();
+    if (ms->cmdState().layoutRange()) {
+        return;
+    }
+    for (Score* s : ms->scoreList()) {
+        s->recordContentChange(ms->cmdState(), false);
+    }
+}
+
 //---------------------------------------------------------
 //   endCmd
 ///   End a GUI command by (if \a undo) ending a user-visble undo
@@ -283,11 +303,15 @@ void Score::endCmd(const bool isCmdFromInspector, bool rollback)
     }
     const bool noUndo = undoStack()->current()->empty();         // nothing to undo?
     undoStack()->endMacro(noUndo);
+    if (!noUndo) {
+        recordChangesWithoutLayout();
+    }
 
     if (dirty()) {
         masterScore()->setPlaylistDirty();      // TODO: flag individual operations
         masterScore()->setAutosaveDirty(true);
     }
+    masterScore()->updateSnapshot();
     MuseScoreCore::mscoreCore->endCmd(isCmdFromInspector, rollback);
     cmdState().reset();
 }
@@ -319,6 +343,7 @@ void Score::update(bool resetCmdState)
         ms->deletePostponed();
         if (cs.layoutRange()) {
             for (Score* s : ms->scoreList()) {
+                s->recordContentChange(cs, s == ms);
                 s->doLayoutRange(cs.startTick(), cs.endTick());
             }
             updateAll = true;
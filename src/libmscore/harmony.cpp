@@ -182,7 +182,6 @@ Harmony::Harmony(Score* s)
     _rootRenderCase = NoteCaseType::CAPITAL;
     _baseRenderCase = NoteCaseType::CAPITAL;
     _id         = -1;
-    _parsedForm = 0;
     _harmonyType = HarmonyType::STANDARD;
     _leftParen  = false;
     _rightParen = false;
@@ -205,7 +204,7 @@ Harmony::Harmony(const Harmony& h)
     _leftParen  = h._leftParen;
     _rightParen = h._rightParen;
     _degreeList = h._degreeList;
-    _parsedForm = h._parsedForm ? new ParsedChord(*h._parsedForm) : 0;
+    _parsedForm = h._parsedForm;
     _harmonyType = h._harmonyType;
     _textName   = h._textName;
     _userName   = h._userName;
@@ -229,9 +228,6 @@ Harmony::~Harmony()
     for (const TextSegment* ts : textList) {
         delete ts;
     }
-    if (_parsedForm) {
-        delete _parsedForm;
-    }
 }
 
 //---------------------------------------------------------
@@ -492,9 +488,7 @@ void Harmony::determineRootBaseSpelling(NoteSpellingType& rootSpelling, NoteCase
             // for chord symbols that have not been edited since the score was loaded
             // we need to parse this chord for now to determine quality
             // but don't keep the parsed form around as we're not ready for it yet
-            quality = parsedForm()->quality();
-            delete _parsedForm;
-            _parsedForm = 0;
+            quality = score()->style().chordList()->parsedChord(_textName)->quality();
         }
         if (quality == "minor" || quality == "diminished" || quality == "half-diminished") {
             rootCase = NoteCaseType::LOWER;
@@ -678,10 +672,7 @@ static int convertNote(const QString& s, NoteSpellingType noteSpelling, NoteCase
 const ChordDescription* Harmony::parseHarmony(const QString& ss, int* root, int* base, bool syntaxOnly)
 {
     _id = -1;
-    if (_parsedForm) {
-        delete _parsedForm;
-        _parsedForm = 0;
-    }
+    _parsedForm.reset();
     _textName.clear();
     bool useLiteral = false;
     if (ss.endsWith(' ')) {
@@ -771,15 +762,14 @@ const ChordDescription* Harmony::parseHarmony(const QString& ss, int* root, int*
     if (useLiteral) {
         cd = descr(s);
     } else {
-        _parsedForm = new ParsedChord();
-        _parsedForm->parse(s, cl, syntaxOnly, preferMinor);
+        _parsedForm = cl->parsedChord(s, syntaxOnly, preferMinor);
         // parser prepends "=" to name of implied minor chords
         // use this here as well
         if (preferMinor) {
             s = _parsedForm->name();
         }
         // look up to see if we already have a descriptor (chord has been used before)
-        cd = descr(s, _parsedForm);
+        cd = descr(s, _parsedForm.get());
     }
     if (cd) {
         // descriptor found; use its information
@@ -1212,10 +1202,10 @@ const ChordDescription* Harmony::fromXml(const QString& kind)
 const ChordDescription* Harmony::fromXml(const QString& kind, const QString& kindText, const QString& symbols,
                                          const QString& parens, const QList<HDegree>& dl)
 {
-    ParsedChord* pc = new ParsedChord;
+    std::shared_ptr<ParsedChord> pc = std::make_shared<ParsedChord>();
     _textName = pc->fromXml(kind, kindText, symbols, parens, dl, score()->style().chordList());
     _parsedForm = pc;
-    const ChordDescription* cd = getDescription(_textName,pc);
+    const ChordDescription* cd = getDescription(_textName, pc.get());
     return cd;
 }
 
@@ -1359,7 +1349,7 @@ const ChordDescription* Harmony::generateDescription()
 {
     ChordList* cl = score()->style().chordList();
     ChordDescription cd(_textName);
-    cd.complete(_parsedForm, cl);
+    cd.complete(_parsedForm.get(), cl);
     // remove parsed chord from description
     // so we will only match it literally in the future
     cd.parsedChords.clear();
@@ -1997,11 +1987,9 @@ const QList<HDegree>& Harmony::degreeList() const
 const ParsedChord* Harmony::parsedForm()
 {
     if (!_parsedForm) {
-        ChordList* cl = score()->style().chordList();
-        _parsedForm = new ParsedChord();
-        _parsedForm->parse(_textName, cl, false);
+        _parsedForm = score()->style().chordList()->parsedChord(_textName);
     }
-    return _parsedForm;
+    return _parsedForm.get();
 }
 
 //---------------------------------------------------------
@@ -13,6 +13,8 @@
 #ifndef __HARMONY_H__
 #define __HARMONY_H__
 
+#include <memory>
+
 #include "text.h"
 #include "pitchspelling.h"
 #include "realizedharmony.h"
@@ -77,7 +79,7 @@ class Harmony final : public TextBase
     QString _function;                    // numeric representation of root for RNA or Nashville
     QString _userName;                    // name as typed by user if applicable
     QString _textName;                    // name recognized from chord list, read from score file, or constructed from imported source
-    ParsedChord* _parsedForm;             // parsed form of chord
+    std::shared_ptr<const ParsedChord> _parsedForm;   // parsed form of chord, shared with the chord list
     bool showSpell = false;               // show spell check warning
     HarmonyType _harmonyType;             // used to control rendering, transposition, export, etc.
     qreal _harmonyHeight;                 // used for calculating the the height is frame while editing.
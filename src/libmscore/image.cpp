@@ -106,6 +106,7 @@ void Image::setImageType(ImageType t)
 
 QSizeF Image::imageSize() const
 {
+    loadDoc();
     if (!isValid()) {
         return QSizeF();
     }
@@ -118,6 +119,7 @@ QSizeF Image::imageSize() const
 
 void Image::draw(QPainter* painter) const
 {
+    loadDoc();
     bool emptyImage = false;
     if (imageType == ImageType::SVG) {
         if (!svgDoc) {
@@ -513,25 +515,37 @@ QSizeF Image::size2pixel(const QSizeF& s) const
 }
 
 //---------------------------------------------------------
-//   layout
+//   loadDoc
+//    create the image document from the store item;
+//    this reads the picture from its archive if it was
+//    not used since loading
 //---------------------------------------------------------
 
-void Image::layout()
+void Image::loadDoc() const
 {
-    setPos(0.0, 0.0);
+    if (!_storeItem) {
+        return;
+    }
     if (imageType == ImageType::SVG && !svgDoc) {
-        if (_storeItem) {
-            svgDoc = new QSvgRenderer(_storeItem->buffer());
-        }
+        svgDoc = new QSvgRenderer(_storeItem->buffer());
     } else if (imageType == ImageType::RASTER && !rasterDoc) {
-        if (_storeItem) {
-            rasterDoc = new QImage;
-            rasterDoc->loadFromData(_storeItem->buffer());
-            if (!rasterDoc->isNull()) {
-                _dirty = true;
-            }
+        rasterDoc = new QImage;
+        rasterDoc->loadFromData(_storeItem->buffer());
+        if (!rasterDoc->isNull()) {
+            _dirty = true;
         }
     }
+}
+
+//---------------------------------------------------------
+//   layout
+//---------------------------------------------------------
+
+void Image::layout()
+{
+    setPos(0.0, 0.0);
+    // the image data is only needed here if the size is unknown,
+    // otherwise it is read on first draw
     if (_size.isNull()) {
         _size = pixel2size(imageSize());
     }
@@ -30,7 +30,7 @@ enum class ImageType : char {
 
 class Image final : public BSymbol
 {
-    union {
+    mutable union {
         QImage* rasterDoc;
         QSvgRenderer* svgDoc;
     };
@@ -38,6 +38,7 @@ class Image final : public BSymbol
 
     QSizeF pixel2size(const QSizeF& s) const;
     QSizeF size2pixel(const QSizeF& s) const;
+    void loadDoc() const;
 
 protected:
     ImageStoreItem* _storeItem;
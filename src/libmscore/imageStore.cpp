@@ -15,6 +15,8 @@
 #include "score.h"
 #include "image.h"
 
+#include "thirdparty/qzip/qzipreader_p.h"
+
 namespace Ms {
 ImageStore imageStore;  // the global image store
 
@@ -71,6 +73,16 @@ void ImageStoreItem::load()
     if (!_buffer.isEmpty()) {
         return;
     }
+    if (!_archivePath.isEmpty()) {
+        // the hash is known from the entry name, only the data is missing
+        MQZipReader uz(_archivePath);
+        _buffer = uz.fileData(_path);
+        if (_buffer.isEmpty()) {
+            qDebug("Cannot read picture <%s> from <%s>", qPrintable(_path), qPrintable(_archivePath));
+        }
+        _archivePath.clear();
+        return;
+    }
     QFile inFile(_path);
     if (!inFile.open(QIODevice::ReadOnly)) {
         qDebug("Cannot open picture file");
@@ -122,6 +134,20 @@ inline static int toInt(char c)
     return c - 'a' + 10;
 }
 
+//---------------------------------------------------------
+//   hashFromName
+//    images are stored under their hex encoded hash
+//---------------------------------------------------------
+
+static QByteArray hashFromName(const QString& s)
+{
+    QByteArray hash(16, 0);
+    for (int i = 0; i < 16; ++i) {
+        hash[i] = toInt(s[i * 2].toLatin1()) * 16 + toInt(s[i * 2 + 1].toLatin1());
+    }
+    return hash;
+}
+
 #if 0
 //---------------------------------------------------------
 //   dumpHash
@@ -174,10 +200,7 @@ ImageStoreItem* ImageStore::getImage(const QString& path) const
 
         return 0;
     }
-    QByteArray hash(16, 0);
-    for (int i = 0; i < 16; ++i) {
-        hash[i] = toInt(s[i * 2].toLatin1()) * 16 + toInt(s[i * 2 + 1].toLatin1());
-    }
+    QByteArray hash = hashFromName(s);
     for (ImageStoreItem* item : _items) {
         if (item->hash() == hash) {
             return item;
@@ -207,6 +230,52 @@ ImageStoreItem* ImageStore::add(const QString& path, const QByteArray& ba)
     return item;
 }
 
+//---------------------------------------------------------
+//   addFromArchive
+//    add an image of a .mscz without reading it; the data
+//    is read from the archive on first use. Returns 0 if
+//    the image is not stored under its hash name.
+//---------------------------------------------------------
+
+ImageStoreItem* ImageStore::addFromArchive(const QString& path, const QString& archivePath)
+{
+    QString s = QFileInfo(path).completeBaseName();
+    if (s.size() != 32) {
+        return 0;
+    }
+    for (const QChar& c : s) {
+        if (!((c >= '0' && c <= '9') || (c >= 'a' && c <= 'f'))) {
+            return 0;
+        }
+    }
+    QByteArray hash = hashFromName(s);
+    for (ImageStoreItem* item : _items) {
+        if (item->hash() == hash) {
+            return item;
+        }
+    }
+    ImageStoreItem* item = new ImageStoreItem(path);
+    item->setArchive(archivePath, hash);
+    _items.push_back(item);
+    return item;
+}
+
+//---------------------------------------------------------
+//   loadUsed
+//    read the images used by score that are still in the
+//    archive archivePath, e.g. before the archive is
+//    overwritten
+//---------------------------------------------------------
+
+void ImageStore::loadUsed(Score* score, const QString& archivePath)
+{
+    for (ImageStoreItem* item : _items) {
+        if (item->archivePath() == archivePath && item->isUsed(score)) {
+            item->load();
+        }
+    }
+}
+
 //---------------------------------------------------------
 //   clearUnused
 //---------------------------------------------------------
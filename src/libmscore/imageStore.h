@@ -32,6 +32,7 @@ class ImageStoreItem
     QString _type;                  // image type (file extension)
     QByteArray _buffer;
     QByteArray _hash;               // 16 byte md4 hash of _buffer
+    QString _archivePath;           // .mscz the image is read from on first use
 
 public:
     ImageStoreItem(const QString& p);
@@ -39,8 +40,8 @@ public:
     void reference(Image*);
 
     const QString& path() const { return _path; }
-    QByteArray& buffer() { return _buffer; }
-    const QByteArray& buffer() const { return _buffer; }
+    QByteArray& buffer() { load(); return _buffer; }
+    const QByteArray& buffer() const { const_cast<ImageStoreItem*>(this)->load(); return _buffer; }
     bool loaded() const { return !_buffer.isEmpty(); }
     void setPath(const QString& val);
     bool isUsed(Score*) const;
@@ -49,6 +50,8 @@ public:
     QString hashName() const;
     const QByteArray& hash() const { return _hash; }
     void set(const QByteArray& b, const QByteArray& h) { _buffer = b; _hash = h; }
+    void setArchive(const QString& archivePath, const QByteArray& h) { _archivePath = archivePath; _hash = h; }
+    const QString& archivePath() const { return _archivePath; }
 };
 
 //---------------------------------------------------------
@@ -68,6 +71,8 @@ public:
 
     ImageStoreItem* getImage(const QString& path) const;
     ImageStoreItem* add(const QString& path, const QByteArray&);
+    ImageStoreItem* addFromArchive(const QString& path, const QString& archivePath);
+    void loadUsed(Score*, const QString& archivePath);
     void clearUnused();
 
     typedef ItemList::iterator iterator;
@@ -10,6 +10,8 @@
 //  the file LICENCE.GPL
 //=============================================================================
 
+#include <QMutex>
+
 #include "instrtemplate.h"
 #include "bracket.h"
 #include "drumset.h"
@@ -25,6 +27,10 @@ QList<InstrumentGroup*> instrumentGroups;
 QList<MidiArticulation> articulation;                // global articulations
 QList<InstrumentGenre*> instrumentGenres;
 
+static QMutex deferredMutex;
+static QStringList deferredFiles;                    // read on first use
+static QRecursiveMutex deferredLoadMutex;            // held while they are read
+
 //---------------------------------------------------------
 //   searchGenre
 //---------------------------------------------------------
@@ -571,6 +577,10 @@ void InstrumentTemplate::setPitchRange(const QString& s, char* a, char* b) const
 
 void clearInstrumentTemplates()
 {
+    {
+        QMutexLocker locker(&deferredMutex);
+        deferredFiles.clear();
+    }
     for (InstrumentGroup* g : instrumentGroups) {
         g->clear();
     }
@@ -630,12 +640,45 @@ bool loadInstrumentTemplates(const QString& instrTemplates)
     return true;
 }
 
+//---------------------------------------------------------
+//   deferInstrumentTemplates
+//    the file is read by loadDeferredInstrumentTemplates()
+//    when the templates are first needed
+//---------------------------------------------------------
+
+void deferInstrumentTemplates(const QString& instrTemplates)
+{
+    QMutexLocker locker(&deferredMutex);
+    deferredFiles.append(instrTemplates);
+}
+
+//---------------------------------------------------------
+//   loadDeferredInstrumentTemplates
+//    reading the templates looks up other templates, which
+//    comes back here on the same thread and finds the list
+//    already taken; other threads wait until all are read
+//---------------------------------------------------------
+
+void loadDeferredInstrumentTemplates()
+{
+    QMutexLocker loadLocker(&deferredLoadMutex);
+    QStringList files;
+    {
+        QMutexLocker locker(&deferredMutex);
+        files.swap(deferredFiles);
+    }
+    for (const QString& file : files) {
+        loadInstrumentTemplates(file);
+    }
+}
+
 //---------------------------------------------------------
 //   searchTemplate
 //---------------------------------------------------------
 
 InstrumentTemplate* searchTemplate(const QString& name)
 {
+    loadDeferredInstrumentTemplates();
     for (InstrumentGroup* g : instrumentGroups) {
         for (InstrumentTemplate* it : g->instrumentTemplates) {
             if (it->id == name) {
@@ -652,6 +695,7 @@ InstrumentTemplate* searchTemplate(const QString& name)
 
 InstrumentTemplate* searchTemplateForMusicXmlId(const QString& mxmlId)
 {
+    loadDeferredInstrumentTemplates();
     for (InstrumentGroup* g : instrumentGroups) {
         for (InstrumentTemplate* it : g->instrumentTemplates) {
             if (it->musicXMLid == mxmlId) {
@@ -746,6 +790,7 @@ ClefType defaultClef(int program)
         return ClefType::F8_VB;
     }
 
+    loadDeferredInstrumentTemplates();
     for (InstrumentGroup* g : instrumentGroups) {
         for (InstrumentTemplate* it : g->instrumentTemplates) {
             if (it->channel[0].bank() == 0 && it->channel[0].program() == program) {
@@ -124,6 +124,8 @@ extern QList<MidiArticulation> articulation;
 extern QList<InstrumentGroup*> instrumentGroups;
 extern void clearInstrumentTemplates();
 extern bool loadInstrumentTemplates(const QString& instrTemplates);
+extern void deferInstrumentTemplates(const QString& instrTemplates);
+extern void loadDeferredInstrumentTemplates();
 extern InstrumentTemplate* searchTemplate(const QString& name);
 extern InstrumentTemplate* searchTemplateForMusicXmlId(const QString& mxmlId);
 extern ClefType defaultClef(int patch);
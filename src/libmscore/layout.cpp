@@ -3153,37 +3153,28 @@ bool notTopTuplet(ChordRest* cr)
 //   findLyricsMaxY
 //---------------------------------------------------------
 
-static qreal findLyricsMaxY(Segment& s, int staffIdx)
+static qreal findLyricsMaxY(ChordRest* cr, int staffIdx)
 {
     qreal yMax = 0.0;
-    if (!s.isChordRestType()) {
-        return yMax;
-    }
-
-    qreal lyricsMinTopDistance = s.score()->styleP(Sid::lyricsMinTopDistance);
-
-    for (int voice = 0; voice < VOICES; ++voice) {
-        ChordRest* cr = s.cr(staffIdx * VOICES + voice);
-        if (cr && !cr->lyrics().empty()) {
-            SkylineLine sk(true);
+    qreal lyricsMinTopDistance = cr->score()->styleP(Sid::lyricsMinTopDistance);
+    Segment* s = cr->segment();
+    SkylineLine sk(true);
 
-            for (Lyrics* l : cr->lyrics()) {
-                if (l->autoplace() && l->placeBelow()) {
-                    qreal yOff = l->offset().y();
-                    QPointF offset = l->pos() + cr->pos() + s.pos() + s.measure()->pos();
-                    QRectF r = l->bbox().translated(offset);
-                    r.translate(0.0, -yOff);
-                    sk.add(r.x(), r.top(), r.width());
-                }
-            }
-            SysStaff* ss = s.measure()->system()->staff(staffIdx);
-            for (Lyrics* l : cr->lyrics()) {
-                if (l->autoplace() && l->placeBelow()) {
-                    qreal y = ss->skyline().south().minDistance(sk);
-                    if (y > -lyricsMinTopDistance) {
-                        yMax = qMax(yMax, y + lyricsMinTopDistance);
-                    }
-                }
+    for (Lyrics* l : cr->lyrics()) {
+        if (l->autoplace() && l->placeBelow()) {
+            qreal yOff = l->offset().y();
+            QPointF offset = l->pos() + cr->pos() + s->pos() + s->measure()->pos();
+            QRectF r = l->bbox().translated(offset);
+            r.translate(0.0, -yOff);
+            sk.add(r.x(), r.top(), r.width());
+        }
+    }
+    SysStaff* ss = s->measure()->system()->staff(staffIdx);
+    for (Lyrics* l : cr->lyrics()) {
+        if (l->autoplace() && l->placeBelow()) {
+            qreal y = ss->skyline().south().minDistance(sk);
+            if (y > -lyricsMinTopDistance) {
+                yMax = qMax(yMax, y + lyricsMinTopDistance);
             }
         }
     }
@@ -3194,54 +3185,29 @@ static qreal findLyricsMaxY(Segment& s, int staffIdx)
 //   findLyricsMinY
 //---------------------------------------------------------
 
-static qreal findLyricsMinY(Segment& s, int staffIdx)
+static qreal findLyricsMinY(ChordRest* cr, int staffIdx)
 {
     qreal yMin = 0.0;
-    if (!s.isChordRestType()) {
-        return yMin;
-    }
-    qreal lyricsMinTopDistance = s.score()->styleP(Sid::lyricsMinTopDistance);
-    for (int voice = 0; voice < VOICES; ++voice) {
-        ChordRest* cr = s.cr(staffIdx * VOICES + voice);
-        if (cr && !cr->lyrics().empty()) {
-            SkylineLine sk(false);
+    qreal lyricsMinTopDistance = cr->score()->styleP(Sid::lyricsMinTopDistance);
+    Segment* s = cr->segment();
+    SkylineLine sk(false);
 
-            for (Lyrics* l : cr->lyrics()) {
-                if (l->autoplace() && l->placeAbove()) {
-                    qreal yOff = l->offset().y();
-                    QRectF r = l->bbox().translated(l->pos() + cr->pos() + s.pos() + s.measure()->pos());
-                    r.translate(0.0, -yOff);
-                    sk.add(r.x(), r.bottom(), r.width());
-                }
-            }
-            SysStaff* ss = s.measure()->system()->staff(staffIdx);
-            for (Lyrics* l : cr->lyrics()) {
-                if (l->autoplace() && l->placeAbove()) {
-                    qreal y = sk.minDistance(ss->skyline().north());
-                    if (y > -lyricsMinTopDistance) {
-                        yMin = qMin(yMin, -y - lyricsMinTopDistance);
-                    }
-                }
-            }
+    for (Lyrics* l : cr->lyrics()) {
+        if (l->autoplace() && l->placeAbove()) {
+            qreal yOff = l->offset().y();
+            QRectF r = l->bbox().translated(l->pos() + cr->pos() + s->pos() + s->measure()->pos());
+            r.translate(0.0, -yOff);
+            sk.add(r.x(), r.bottom(), r.width());
         }
     }
-    return yMin;
-}
-
-static qreal findLyricsMaxY(Measure* m, int staffIdx)
-{
-    qreal yMax = 0.0;
-    for (Segment& s : m->segments()) {
-        yMax = qMax(yMax, findLyricsMaxY(s, staffIdx));
-    }
-    return yMax;
-}
-
-static qreal findLyricsMinY(Measure* m, int staffIdx)
-{
-    qreal yMin = 0.0;
-    for (Segment& s : m->segments()) {
-        yMin = qMin(yMin, findLyricsMinY(s, staffIdx));
+    SysStaff* ss = s->measure()->system()->staff(staffIdx);
+    for (Lyrics* l : cr->lyrics()) {
+        if (l->autoplace() && l->placeAbove()) {
+            qreal y = sk.minDistance(ss->skyline().north());
+            if (y > -lyricsMinTopDistance) {
+                yMin = qMin(yMin, -y - lyricsMinTopDistance);
+            }
+        }
     }
     return yMin;
 }
@@ -3250,36 +3216,22 @@ static qreal findLyricsMinY(Measure* m, int staffIdx)
 //   applyLyricsMax
 //---------------------------------------------------------
 
-static void applyLyricsMax(Segment& s, int staffIdx, qreal yMax)
+static void applyLyricsMax(ChordRest* cr, int staffIdx, qreal yMax)
 {
-    if (!s.isChordRestType()) {
-        return;
-    }
-    Skyline& sk = s.measure()->system()->staff(staffIdx)->skyline();
-    for (int voice = 0; voice < VOICES; ++voice) {
-        ChordRest* cr = s.cr(staffIdx * VOICES + voice);
-        if (cr && !cr->lyrics().empty()) {
-            qreal lyricsMinBottomDistance = s.score()->styleP(Sid::lyricsMinBottomDistance);
-            for (Lyrics* l : cr->lyrics()) {
-                if (l->autoplace() && l->placeBelow()) {
-                    l->rypos() += yMax - l->propertyDefault(Pid::OFFSET).toPointF().y();
-                    if (l->addToSkyline()) {
-                        QPointF offset = l->pos() + cr->pos() + s.pos() + s.measure()->pos();
-                        sk.add(l->bbox().translated(offset).adjusted(0.0, 0.0, 0.0, lyricsMinBottomDistance));
-                    }
-                }
+    Segment* s = cr->segment();
+    Skyline& sk = s->measure()->system()->staff(staffIdx)->skyline();
+    qreal lyricsMinBottomDistance = cr->score()->styleP(Sid::lyricsMinBottomDistance);
+    for (Lyrics* l : cr->lyrics()) {
+        if (l->autoplace() && l->placeBelow()) {
+            l->rypos() += yMax - l->propertyDefault(Pid::OFFSET).toPointF().y();
+            if (l->addToSkyline()) {
+                QPointF offset = l->pos() + cr->pos() + s->pos() + s->measure()->pos();
+                sk.add(l->bbox().translated(offset).adjusted(0.0, 0.0, 0.0, lyricsMinBottomDistance));
             }
         }
     }
 }
 
-static void applyLyricsMax(Measure* m, int staffIdx, qreal yMax)
-{
-    for (Segment& s : m->segments()) {
-        applyLyricsMax(s, staffIdx, yMax);
-    }
-}
-
 //---------------------------------------------------------
 //   applyLyricsMin
 //---------------------------------------------------------
@@ -3298,18 +3250,66 @@ static void applyLyricsMin(ChordRest* cr, int staffIdx, qreal yMin)
     }
 }
 
-static void applyLyricsMin(Measure* m, int staffIdx, qreal yMin)
+//---------------------------------------------------------
+//   LyricsIterator
+//    ranges of the chordrests with lyrics of one staff
+//---------------------------------------------------------
+
+typedef std::vector<ChordRest*>::const_iterator LyricsIterator;
+
+static qreal findLyricsMaxY(LyricsIterator begin, LyricsIterator end, int staffIdx)
 {
-    for (Segment& s : m->segments()) {
-        if (s.isChordRestType()) {
-            for (int voice = 0; voice < VOICES; ++voice) {
-                ChordRest* cr = s.cr(staffIdx * VOICES + voice);
-                if (cr) {
-                    applyLyricsMin(cr, staffIdx, yMin);
-                }
-            }
+    qreal yMax = 0.0;
+    for (LyricsIterator i = begin; i != end; ++i) {
+        yMax = qMax(yMax, findLyricsMaxY(*i, staffIdx));
+    }
+    return yMax;
+}
+
+static qreal findLyricsMinY(LyricsIterator begin, LyricsIterator end, int staffIdx)
+{
+    qreal yMin = 0.0;
+    for (LyricsIterator i = begin; i != end; ++i) {
+        yMin = qMin(yMin, findLyricsMinY(*i, staffIdx));
+    }
+    return yMin;
+}
+
+static void applyLyricsMax(LyricsIterator begin, LyricsIterator end, int staffIdx, qreal yMax)
+{
+    for (LyricsIterator i = begin; i != end; ++i) {
+        applyLyricsMax(*i, staffIdx, yMax);
+    }
+}
+
+static void applyLyricsMin(LyricsIterator begin, LyricsIterator end, int staffIdx, qreal yMin)
+{
+    for (LyricsIterator i = begin; i != end; ++i) {
+        applyLyricsMin(*i, staffIdx, yMin);
+    }
+}
+
+//---------------------------------------------------------
+//   nextLyricsRange
+//    end of the range starting at begin whose chordrests
+//    are in the same measure (or segment)
+//---------------------------------------------------------
+
+static LyricsIterator nextLyricsRange(LyricsIterator begin, LyricsIterator end, bool bySegment)
+{
+    LyricsIterator i = begin;
+    if (bySegment) {
+        Segment* s = (*begin)->segment();
+        while (i != end && (*i)->segment() == s) {
+            ++i;
+        }
+    } else {
+        Measure* m = (*begin)->measure();
+        while (i != end && (*i)->measure() == m) {
+            ++i;
         }
     }
+    return i;
 }
 
 //---------------------------------------------------------
@@ -3342,9 +3342,39 @@ static void restoreBeams(Measure* m)
 void Score::layoutLyrics(System* system)
 {
     std::vector<int> visibleStaves;
+    std::vector<bool> visible(nstaves(), false);
     for (int staffIdx = system->firstVisibleStaff(); staffIdx < nstaves();
          staffIdx = system->nextVisibleStaff(staffIdx)) {
         visibleStaves.push_back(staffIdx);
+        visible[staffIdx] = true;
+    }
+
+    //
+    // collect the chordrests with lyrics once, per staff in score order;
+    // the passes below only visit these
+    //
+    std::vector<std::vector<ChordRest*> > lyricsChordRests(nstaves());
+    bool hasLyrics = false;
+    for (MeasureBase* mb : system->measures()) {
+        if (!mb->isMeasure()) {
+            continue;
+        }
+        Measure* m = toMeasure(mb);
+        for (Segment* s = m->first(SegmentType::ChordRest); s; s = s->next(SegmentType::ChordRest)) {
+            for (Element* e : s->elist()) {
+                if (!e || toChordRest(e)->lyrics().empty()) {
+                    continue;
+                }
+                int staffIdx = e->track() / VOICES;
+                if (visible[staffIdx]) {
+                    lyricsChordRests[staffIdx].push_back(toChordRest(e));
+                    hasLyrics = true;
+                }
+            }
+        }
+    }
+    if (!hasLyrics) {
+        return;
     }
 
     //int nAbove[nstaves()];
@@ -3352,111 +3382,67 @@ void Score::layoutLyrics(System* system)
 
     for (int staffIdx : visibleStaves) {
         VnAbove[staffIdx] = 0;
-        for (MeasureBase* mb : system->measures()) {
-            if (!mb->isMeasure()) {
-                continue;
-            }
-            Measure* m = toMeasure(mb);
-            for (Segment& s : m->segments()) {
-                if (s.isChordRestType()) {
-                    for (int voice = 0; voice < VOICES; ++voice) {
-                        ChordRest* cr = s.cr(staffIdx * VOICES + voice);
-                        if (cr) {
-                            int nA = 0;
-                            for (Lyrics* l : cr->lyrics()) {
-                                // user adjusted offset can possibly change placement
-                                if (l->offsetChanged() != OffsetChange::NONE) {
-                                    Placement p = l->placement();
-                                    l->rebaseOffset();
-                                    if (l->placement() != p) {
-                                        l->undoResetProperty(Pid::AUTOPLACE);
-                                        //l->undoResetProperty(Pid::OFFSET);
-                                        //l->layout();
-                                    }
-                                }
-                                l->setOffsetChanged(false);
-                                if (l->placeAbove()) {
-                                    ++nA;
-                                }
-                            }
-                            VnAbove[staffIdx] = qMax(VnAbove[staffIdx], nA);
-                        }
+        for (ChordRest* cr : lyricsChordRests[staffIdx]) {
+            int nA = 0;
+            for (Lyrics* l : cr->lyrics()) {
+                // user adjusted offset can possibly change placement
+                if (l->offsetChanged() != OffsetChange::NONE) {
+                    Placement p = l->placement();
+                    l->rebaseOffset();
+                    if (l->placement() != p) {
+                        l->undoResetProperty(Pid::AUTOPLACE);
+                        //l->undoResetProperty(Pid::OFFSET);
+                        //l->layout();
                     }
                 }
+                l->setOffsetChanged(false);
+                if (l->placeAbove()) {
+                    ++nA;
+                }
             }
+            VnAbove[staffIdx] = qMax(VnAbove[staffIdx], nA);
         }
     }
 
     for (int staffIdx : visibleStaves) {
-        for (MeasureBase* mb : system->measures()) {
-            if (!mb->isMeasure()) {
-                continue;
-            }
-            Measure* m = toMeasure(mb);
-            for (Segment& s : m->segments()) {
-                if (s.isChordRestType()) {
-                    for (int voice = 0; voice < VOICES; ++voice) {
-                        ChordRest* cr = s.cr(staffIdx * VOICES + voice);
-                        if (cr) {
-                            for (Lyrics* l : cr->lyrics()) {
-                                l->layout2(VnAbove[staffIdx]);
-                            }
-                        }
-                    }
-                }
+        for (ChordRest* cr : lyricsChordRests[staffIdx]) {
+            for (Lyrics* l : cr->lyrics()) {
+                l->layout2(VnAbove[staffIdx]);
             }
         }
     }
 
+    // every staff has its own skyline, so the staves can be aligned one after the other
+
     VerticalAlignRange ar = VerticalAlignRange(styleI(Sid::autoplaceVerticalAlignRange));
 
-    switch (ar) {
-    case VerticalAlignRange::MEASURE:
-        for (MeasureBase* mb : system->measures()) {
-            if (!mb->isMeasure()) {
-                continue;
-            }
-            Measure* m = toMeasure(mb);
-            for (int staffIdx : visibleStaves) {
-                qreal yMax = findLyricsMaxY(m, staffIdx);
-                applyLyricsMax(m, staffIdx, yMax);
-            }
+    for (int staffIdx : visibleStaves) {
+        const std::vector<ChordRest*>& crs = lyricsChordRests[staffIdx];
+        if (crs.empty()) {
+            continue;
         }
-        break;
-    case VerticalAlignRange::SYSTEM:
-        for (int staffIdx : visibleStaves) {
-            qreal yMax = 0.0;
-            qreal yMin = 0.0;
-            for (MeasureBase* mb : system->measures()) {
-                if (!mb->isMeasure()) {
-                    continue;
-                }
-                yMax = qMax<qreal>(yMax, findLyricsMaxY(toMeasure(mb), staffIdx));
-                yMin = qMin(yMin, findLyricsMinY(toMeasure(mb), staffIdx));
+        switch (ar) {
+        case VerticalAlignRange::MEASURE:
+        case VerticalAlignRange::SEGMENT:
+            for (LyricsIterator i = crs.begin(); i != crs.end();) {
+                LyricsIterator end = nextLyricsRange(i, crs.end(), ar == VerticalAlignRange::SEGMENT);
+                qreal yMax = findLyricsMaxY(i, end, staffIdx);
+                applyLyricsMax(i, end, staffIdx, yMax);
+                i = end;
             }
-            for (MeasureBase* mb : system->measures()) {
-                if (!mb->isMeasure()) {
-                    continue;
-                }
-                applyLyricsMax(toMeasure(mb), staffIdx, yMax);
-                applyLyricsMin(toMeasure(mb), staffIdx, yMin);
+            break;
+        case VerticalAlignRange::SYSTEM: {
+            qreal yMax = findLyricsMaxY(crs.begin(), crs.end(), staffIdx);
+            qreal yMin = findLyricsMinY(crs.begin(), crs.end(), staffIdx);
+            for (LyricsIterator i = crs.begin(); i != crs.end();) {
+                LyricsIterator end = nextLyricsRange(i, crs.end(), false);
+                applyLyricsMax(i, end, staffIdx, yMax);
+                applyLyricsMin(i, end, staffIdx, yMin);
+                i = end;
             }
         }
         break;
-    case VerticalAlignRange::SEGMENT:
-        for (MeasureBase* mb : system->measures()) {
-            if (!mb->isMeasure()) {
-                continue;
-            }
-            Measure* m = toMeasure(mb);
-            for (int staffIdx : visibleStaves) {
-                for (Segment& s : m->segments()) {
-                    qreal yMax = findLyricsMaxY(s, staffIdx);
-                    applyLyricsMax(s, staffIdx, yMax);
-                }
-            }
         }
-        break;
     }
 }
 
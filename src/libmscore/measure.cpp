@@ -1963,6 +1963,65 @@ void Measure::write(XmlWriter& xml, int staff, bool writeSystemElements, bool fo
     xml.etag();
 }
 
+//---------------------------------------------------------
+//   staffMscx
+//    What is saved for the staff of this measure, written
+//    on its own.
+//---------------------------------------------------------
+
+QString Measure::staffMscx(int staffIdx) const
+{
+    QString mscx;
+    XmlWriter xml(score());
+    xml.setString(&mscx, QIODevice::WriteOnly);
+    write(xml, staffIdx, staffIdx == 0, false);
+    xml.flush();
+    return mscx;
+}
+
+//---------------------------------------------------------
+//   contentHash
+//    Hash of what is saved for the staff of this measure.
+//    It does not depend on the position of the measure in
+//    the score or on layout, and is cached until the
+//    measure is invalidated by a command changing it
+//    (see Score::recordContentChange()).
+//---------------------------------------------------------
+
+uint Measure::contentHash(int staffIdx) const
+{
+    MStaff* ms = m_mstaves[staffIdx];
+    if (!ms->contentHashValid()) {
+        ms->setContentHash(qHash(staffMscx(staffIdx)));
+    }
+    return ms->contentHash();
+}
+
+//---------------------------------------------------------
+//   contentHash
+//    combined hash of all staves
+//---------------------------------------------------------
+
+uint Measure::contentHash() const
+{
+    uint h = 0;
+    for (int staffIdx = 0; staffIdx < int(m_mstaves.size()); ++staffIdx) {
+        h = qHash(qMakePair(h, contentHash(staffIdx)));
+    }
+    return h;
+}
+
+//---------------------------------------------------------
+//   invalidateContentHash
+//---------------------------------------------------------
+
+void Measure::invalidateContentHash()
+{
+    for (MStaff* ms : m_mstaves) {
+        ms->invalidateContentHash();
+    }
+}
+
 //---------------------------------------------------------
 //   Measure::read
 //---------------------------------------------------------
@@ -96,6 +96,11 @@ public:
     int measureRepeatCount() const { return m_measureRepeatCount; }
     void setMeasureRepeatCount(int n) { m_measureRepeatCount = n; }
 
+    bool contentHashValid() const { return m_contentHashValid; }
+    uint contentHash() const { return m_contentHash; }
+    void setContentHash(uint h) { m_contentHash = h; m_contentHashValid = true; }
+    void invalidateContentHash() { m_contentHashValid = false; }
+
 private:
     MeasureNumber* m_noText { nullptr };      ///< Measure number text object
     StaffLines* m_lines     { nullptr };
@@ -109,6 +114,8 @@ private:
     bool m_corrupted        { false };
 #endif
     int m_measureRepeatCount { 0 };
+    uint m_contentHash       { 0 };
+    bool m_contentHashValid  { false };
 };
 
 //---------------------------------------------------------
@@ -142,6 +149,11 @@ public:
     void write(XmlWriter& xml) const override { Element::write(xml); }
     void write(XmlWriter&, int, bool writeSystemElements, bool forceTimeSig) const override;
     void writeBox(XmlWriter&) const;
+
+    QString staffMscx(int staffIdx) const;
+    uint contentHash(int staffIdx) const;
+    uint contentHash() const;
+    void invalidateContentHash();
     void readBox(XmlReader&);
     bool isEditable() const override { return false; }
     void checkMeasure(int idx);
@@ -13,12 +13,15 @@
 #include <QDir>
 #include <QSettings>
 #include <QFontDatabase>
+#include <QGuiApplication>
+#include <QMutex>
 
 #include "config.h"
 #include "musescoreCore.h"
 #include "style.h"
 #include "mscore.h"
 #include "sequencer.h"
+#include "textlayoutcache.h"
 #include "element.h"
 #include "dynamic.h"
 #include "accidental.h"
@@ -81,6 +84,7 @@ bool MScore::saveTemplateMode = false;
 bool MScore::noGui = false;
 
 MStyle* MScore::_defaultStyleForParts;
+QAtomicInt MScore::_renderCacheGeneration;
 
 QString MScore::_globalShare;
 int MScore::_vRaster;
@@ -105,6 +109,7 @@ qreal MScore::nudgeStep;
 qreal MScore::nudgeStep10;
 qreal MScore::nudgeStep50;
 int MScore::defaultPlayDuration;
+size_t MScore::undoMemoryLimit = 0;
 
 QString MScore::lastError;
 int MScore::division    = 480;     // 3840;   // pulses per quarter note (PPQ) // ticks per beat
@@ -115,11 +120,14 @@ bool MScore::noExcerpts = false;
 bool MScore::noImages = false;
 bool MScore::pdfPrinting = false;
 bool MScore::svgPrinting = false;
+bool MScore::printGlyphRuns = true;
 
 double MScore::pixelRatio  = 0.8;         // DPI / logicalDPI
 
 MPaintDevice* MScore::_paintDevice;
 
+static QRecursiveMutex printingMutex;
+
 Sequencer* MScore::seq = 0;
 MuseScoreCore* MuseScoreCore::mscoreCore;
 
@@ -264,6 +272,13 @@ void MScore::init()
         return;
     }
 
+    // covers fonts added outside of libmscore, e.g. at startup
+    if (qGuiApp) {
+        QObject::connect(qGuiApp, &QGuiApplication::fontDatabaseChanged, []() {
+            MScore::invalidateRenderCaches();
+        });
+    }
+
 #ifdef Q_OS_WIN
     QDir dir(QCoreApplication::applicationDirPath() + QString("/../" INSTALL_NAME));
     _globalShare = dir.absolutePath() + "/";
@@ -421,6 +436,19 @@ bool MScore::readDefaultStyle(QString file)
     return rv;
 }
 
+//---------------------------------------------------------
+//   invalidateRenderCaches
+//    called when the default style or the installed fonts
+//    change; the shaped text is dropped, the images of
+//    other caches are made stale by the generation
+//---------------------------------------------------------
+
+void MScore::invalidateRenderCaches()
+{
+    _renderCacheGeneration.fetchAndAddRelaxed(1);
+    TextLayoutCache::clear();
+}
+
 //---------------------------------------------------------
 //   defaultStyleForPartsHasChanged
 //---------------------------------------------------------
@@ -472,6 +500,29 @@ MPaintDevice* MScore::paintDevice()
     return _paintDevice;
 }
 
+//---------------------------------------------------------
+//   PrintingState
+//---------------------------------------------------------
+
+PrintingState::PrintingState(double pixelRatio, bool pdfPrinting, bool svgPrinting)
+{
+    printingMutex.lock();
+    _pixelRatio  = MScore::pixelRatio;
+    _pdfPrinting = MScore::pdfPrinting;
+    _svgPrinting = MScore::svgPrinting;
+    MScore::pixelRatio  = pixelRatio;
+    MScore::pdfPrinting = pdfPrinting;
+    MScore::svgPrinting = svgPrinting;
+}
+
+PrintingState::~PrintingState()
+{
+    MScore::pixelRatio  = _pixelRatio;
+    MScore::pdfPrinting = _pdfPrinting;
+    MScore::svgPrinting = _svgPrinting;
+    printingMutex.unlock();
+}
+
 //---------------------------------------------------------
 //   metric
 //---------------------------------------------------------
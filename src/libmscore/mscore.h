@@ -13,6 +13,7 @@
 #ifndef __MSCORE_H__
 #define __MSCORE_H__
 
+#include <QAtomicInt>
 #include <QPaintEngine>
 
 #include "config.h"
@@ -306,6 +307,8 @@ class MScore
 
     static MPaintDevice* _paintDevice;
 
+    static QAtomicInt _renderCacheGeneration;
+
 public:
     enum class DirectionH : char {   /**.\{*/
         AUTO, LEFT, RIGHT                                       /**\}*/
@@ -327,9 +330,14 @@ public:
     static const MStyle* defaultStyleForParts() { return _defaultStyleForParts; }
 
     static bool readDefaultStyle(QString file);
-    static void setDefaultStyle(const MStyle& s) { _defaultStyle = s; }
+    static void setDefaultStyle(const MStyle& s) { _defaultStyle = s; invalidateRenderCaches(); }
     static void defaultStyleForPartsHasChanged();
 
+    // caches of rendered content compare against this, it changes
+    // when the default style or the available fonts change
+    static int renderCacheGeneration() { return _renderCacheGeneration.loadRelaxed(); }
+    static void invalidateRenderCaches();
+
     static const QString& globalShare() { return _globalShare; }
     static qreal hRaster() { return _hRaster; }
     static qreal vRaster() { return _vRaster; }
@@ -357,6 +365,7 @@ public:
     static qreal nudgeStep10;
     static qreal nudgeStep50;
     static int defaultPlayDuration;
+    static size_t undoMemoryLimit;      // bytes kept in undo history, 0: unlimited
     static QString lastError;
 
 // #ifndef NDEBUG
@@ -386,6 +395,7 @@ public:
 
     static bool pdfPrinting;
     static bool svgPrinting;
+    static bool printGlyphRuns;         // pdf/svg: draw symbols as glyph runs instead of text
     static double pixelRatio;
 
     static qreal verticalPageGap;
@@ -399,6 +409,26 @@ public:
     static const char* errorGroup();
 };
 
+//---------------------------------------------------------
+//   PrintingState
+//    Sets MScore::pixelRatio and the printing flags for
+//    one export and restores them when it goes out of
+//    scope. An export on another thread waits until the
+//    state is released, so exports can not paint with the
+//    settings of each other. It may be nested on one thread.
+//---------------------------------------------------------
+
+class PrintingState
+{
+    double _pixelRatio;
+    bool _pdfPrinting;
+    bool _svgPrinting;
+
+public:
+    PrintingState(double pixelRatio, bool pdfPrinting = false, bool svgPrinting = false);
+    ~PrintingState();
+};
+
 //---------------------------------------------------------
 //   center
 //---------------------------------------------------------
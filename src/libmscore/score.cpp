@@ -73,6 +73,7 @@
 #include "breath.h"
 #include "instrchange.h"
 #include "synthesizerstate.h"
+#include "scoresnapshot.h"
 
 namespace Ms {
 MasterScore* gscore;                 ///< system score, used for palettes etc.
@@ -775,6 +776,63 @@ ScoreContentState Score::state() const
     return ScoreContentState(this, undoStack()->state());
 }
 
+//---------------------------------------------------------
+//   recordContentChange
+//    Called after each command with the layout range of
+//    the command. Invalidates the content hashes of the
+//    measures in the range and appends the range to the
+//    content journal. Staff numbers are only known for
+//    the score the command was executed on. A command
+//    without a layout range is recorded for the whole
+//    score.
+//---------------------------------------------------------
+
+void Score::recordContentChange(const CmdState& cs, bool staffRangeValid)
+{
+    static constexpr size_t maxContentJournalSize = 1024;
+
+    ContentChange change;
+    if (!cs.layoutRange()) {
+        change.startTick = Fraction(0, 1);
+        change.endTick = lastMeasure() ? lastMeasure()->endTick() : Fraction(0, 1);
+    } else {
+        change.startTick = cs.startTick();
+        change.endTick = cs.endTick();
+    }
+    if (cs.layoutRange() && staffRangeValid && cs.startStaff() != -1) {
+        change.startStaff = cs.startStaff();
+        change.endStaff = cs.endStaff();
+    }
+
+    // all staves are invalidated as the staff range is not reliable
+    for (Measure* m = tick2measure(change.startTick); m && m->tick() <= change.endTick; m = m->nextMeasure()) {
+        m->invalidateContentHash();
+    }
+
+    _contentJournal.push_back(change);
+    if (_contentJournal.size() > maxContentJournalSize) {
+        _contentJournal.pop_front();
+        ++_contentJournalOffset;
+    }
+}
+
+//---------------------------------------------------------
+//   contentChangesSince
+//    Collects the changes recorded after the given
+//    contentRevision(). Returns false if the journal does
+//    not reach back that far, the whole score has to be
+//    considered changed then.
+//---------------------------------------------------------
+
+bool Score::contentChangesSince(int revision, std::vector<ContentChange>& changes) const
+{
+    if (revision < _contentJournalOffset || revision > contentRevision()) {
+        return false;
+    }
+    changes.insert(changes.end(), _contentJournal.begin() + (revision - _contentJournalOffset), _contentJournal.end());
+    return true;
+}
+
 //---------------------------------------------------------
 //   playlistDirty
 //---------------------------------------------------------
@@ -793,6 +851,61 @@ void Score::setPlaylistDirty()
     masterScore()->setPlaylistDirty();
 }
 
+//---------------------------------------------------------
+//   setSnapshotsEnabled
+//    While enabled, snapshots of the tempo map and the
+//    repeats follow the changes of the score. withMeasures
+//    also serializes the changed measures after each
+//    command, only enable it for a reader that needs them.
+//---------------------------------------------------------
+
+void MasterScore::setSnapshotsEnabled(bool val, bool withMeasures)
+{
+    _snapshotsEnabled = val;
+    _snapshotMeasures = val && withMeasures;
+    _snapshotOutdated = false;
+    if (val) {
+        std::atomic_store(&_snapshot, ScoreSnapshot::take(this, nullptr, _snapshotMeasures));
+    } else {
+        std::atomic_store(&_snapshot, std::shared_ptr<const ScoreSnapshot>());
+    }
+}
+
+//---------------------------------------------------------
+//   updateSnapshot
+//    force: retake even if the content did not change,
+//    e.g. when only the repeats are played differently.
+//    Without measures the snapshot is only retaken when
+//    the repeat list is unwound the next time, an edit
+//    does not unwind it just for the snapshot.
+//---------------------------------------------------------
+
+void MasterScore::updateSnapshot(bool force)
+{
+    if (!_snapshotsEnabled) {
+        return;
+    }
+    std::shared_ptr<const ScoreSnapshot> previous = std::atomic_load(&_snapshot);
+    if (!force && previous && previous->revision() == contentRevision()) {
+        return;
+    }
+    if (_snapshotMeasures) {
+        std::atomic_store(&_snapshot, ScoreSnapshot::take(this, previous, true));
+    } else {
+        _snapshotOutdated = true;
+    }
+}
+
+//---------------------------------------------------------
+//   snapshot
+//    the latest snapshot, may be called from any thread
+//---------------------------------------------------------
+
+std::shared_ptr<const ScoreSnapshot> MasterScore::snapshot() const
+{
+    return std::atomic_load(&_snapshot);
+}
+
 //---------------------------------------------------------
 //   setPlaylistDirty
 //---------------------------------------------------------
@@ -810,41 +923,41 @@ void MasterScore::setPlaylistDirty()
 
 void Score::spell()
 {
-    for (int i = 0; i < nstaves(); ++i) {
-        std::vector<Note*> notes;
-        for (Segment* s = firstSegment(SegmentType::All); s; s = s->next1()) {
-            int strack = i * VOICES;
-            int etrack = strack + VOICES;
-            for (int track = strack; track < etrack; ++track) {
-                Element* e = s->element(track);
-                if (e && e->type() == ElementType::CHORD) {
-                    notes.insert(notes.end(),
-                                 toChord(e)->notes().begin(),
-                                 toChord(e)->notes().end());
-                }
+    // collect the notes of all staves in one pass over the score
+    std::vector<std::vector<Note*> > notes(nstaves());
+    for (Segment* s = firstSegment(SegmentType::All); s; s = s->next1()) {
+        for (int track = 0; track < ntracks(); ++track) {
+            Element* e = s->element(track);
+            if (e && e->type() == ElementType::CHORD) {
+                std::vector<Note*>& nl = notes[track / VOICES];
+                nl.insert(nl.end(), toChord(e)->notes().begin(), toChord(e)->notes().end());
             }
         }
-        spellNotelist(notes);
+    }
+    for (std::vector<Note*>& nl : notes) {
+        spellNotelist(nl);
     }
 }
 
 void Score::spell(int startStaff, int endStaff, Segment* startSegment, Segment* endSegment)
 {
-    for (int i = startStaff; i < endStaff; ++i) {
-        std::vector<Note*> notes;
-        for (Segment* s = startSegment; s && s != endSegment; s = s->next()) {
-            int strack = i * VOICES;
-            int etrack = strack + VOICES;
-            for (int track = strack; track < etrack; ++track) {
-                Element* e = s->element(track);
-                if (e && e->type() == ElementType::CHORD) {
-                    notes.insert(notes.end(),
-                                 toChord(e)->notes().begin(),
-                                 toChord(e)->notes().end());
-                }
+    if (startStaff >= endStaff) {
+        return;
+    }
+    std::vector<std::vector<Note*> > notes(endStaff - startStaff);
+    int strack = startStaff * VOICES;
+    int etrack = endStaff * VOICES;
+    for (Segment* s = startSegment; s && s != endSegment; s = s->next()) {
+        for (int track = strack; track < etrack; ++track) {
+            Element* e = s->element(track);
+            if (e && e->type() == ElementType::CHORD) {
+                std::vector<Note*>& nl = notes[track / VOICES - startStaff];
+                nl.insert(nl.end(), toChord(e)->notes().begin(), toChord(e)->notes().end());
             }
         }
-        spellNotelist(notes);
+    }
+    for (std::vector<Note*>& nl : notes) {
+        spellNotelist(nl);
     }
 }
 
@@ -1888,6 +2001,7 @@ void MasterScore::setExpandRepeats(bool expand)
     }
     _expandRepeats = expand;
     setPlaylistDirty();
+    updateSnapshot(true);
 }
 
 //---------------------------------------------------------
@@ -1899,6 +2013,7 @@ void MasterScore::updateRepeatListTempo()
 {
     _repeatList->updateTempo();
     _repeatList2->updateTempo();
+    updateSnapshot(true);
 }
 
 //---------------------------------------------------------
@@ -1908,6 +2023,10 @@ void MasterScore::updateRepeatListTempo()
 const RepeatList& MasterScore::repeatList() const
 {
     _repeatList->update(_expandRepeats);
+    if (_snapshotOutdated) {
+        _snapshotOutdated = false;
+        std::atomic_store(&_snapshot, ScoreSnapshot::take(this, std::atomic_load(&_snapshot)));
+    }
     return *_repeatList;
 }
 
@@ -2833,6 +2952,8 @@ void Score::cmdConcertPitchChanged(bool flag)
 {
     undoChangeStyleVal(Sid::concertPitch, flag);         // change style flag
 
+    std::vector<bool> transposed(nstaves(), false);
+    bool anyTransposed = false;
     for (Staff* staff : _staves) {
         if (staff->staffType(Fraction(0,1))->group() == StaffGroup::PERCUSSION) {         // TODO
             continue;
@@ -2847,35 +2968,38 @@ void Score::cmdConcertPitchChanged(bool flag)
         }
 
         int staffIdx   = staff->idx();
-        int startTrack = staffIdx * VOICES;
-        int endTrack   = startTrack + VOICES;
-
         transposeKeys(staffIdx, staffIdx + 1, Fraction(0,1), lastSegment()->tick(), interval, true, !flag);
+        transposed[staffIdx] = true;
+        anyTransposed = true;
+    }
+    if (!anyTransposed) {
+        return;
+    }
 
-        for (Segment* segment = firstSegment(SegmentType::ChordRest); segment;
-             segment = segment->next1(SegmentType::ChordRest)) {
-            interval = staff->part()->instrument(segment->tick())->transpose();
+    // transpose the chord symbols of all transposed staves in one pass over the score
+    for (Segment* segment = firstSegment(SegmentType::ChordRest); segment;
+         segment = segment->next1(SegmentType::ChordRest)) {
+        for (Element* e : segment->annotations()) {
+            if (!e->isHarmony() || (e->track() < 0) || (e->track() >= ntracks()) || !transposed[e->staffIdx()]) {
+                continue;
+            }
+            Interval interval = e->staff()->part()->instrument(segment->tick())->transpose();
             if (!flag) {
                 interval.flip();
             }
-            for (Element* e : segment->annotations()) {
-                if (!e->isHarmony() || (e->track() < startTrack) || (e->track() >= endTrack)) {
-                    continue;
-                }
-                Harmony* h  = toHarmony(e);
-                int rootTpc = transposeTpc(h->rootTpc(), interval, true);
-                int baseTpc = transposeTpc(h->baseTpc(), interval, true);
-                for (ScoreElement* se : h->linkList()) {
-                    // don't transpose all links
-                    // just ones resulting from mmrests
-                    Harmony* he = toHarmony(se);              // toHarmony() does not work as e is an ScoreElement
-                    if (he->staff() == h->staff()) {
-                        undoTransposeHarmony(he, rootTpc, baseTpc);
-                    }
+            Harmony* h  = toHarmony(e);
+            int rootTpc = transposeTpc(h->rootTpc(), interval, true);
+            int baseTpc = transposeTpc(h->baseTpc(), interval, true);
+            for (ScoreElement* se : h->linkList()) {
+                // don't transpose all links
+                // just ones resulting from mmrests
+                Harmony* he = toHarmony(se);              // toHarmony() does not work as e is an ScoreElement
+                if (he->staff() == h->staff()) {
+                    undoTransposeHarmony(he, rootTpc, baseTpc);
                 }
-                //realized harmony should be invalid after a transpose command
-                Q_ASSERT(!h->realizedHarmony().valid());
             }
+            //realized harmony should be invalid after a transpose command
+            Q_ASSERT(!h->realizedHarmony().valid());
         }
     }
 }
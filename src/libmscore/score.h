@@ -18,11 +18,15 @@
  Definition of Score class.
 */
 
+#include <deque>
 #include <set>
 #include <QFileInfo>
+#include <QImage>
 #include <QQueue>
 #include <QSet>
 
+class QPdfWriter;
+
 #include "config.h"
 #include "input.h"
 #include "instrument.h"
@@ -80,6 +84,7 @@ class Part;
 class RepeatList;
 class Rest;
 class Revisions;
+class ScoreSnapshot;
 class ScoreFont;
 class Segment;
 class Selection;
@@ -359,6 +364,59 @@ public:
     bool isNewerThan(const ScoreContentState& s2) const { return score == s2.score && num > s2.num; }
 };
 
+//---------------------------------------------------------
+//   ContentChange
+//    Entry of the score content journal: the range
+//    changed by one command (or undo/redo).
+//---------------------------------------------------------
+
+struct ContentChange {
+    Fraction startTick;
+    Fraction endTick;             // inclusive
+    int startStaff { -1 };        // -1: all staves
+    int endStaff   { -1 };
+};
+
+//---------------------------------------------------------
+//   CompressedSaveData
+//    snapshot of everything that goes into a .mscz file,
+//    taken on the thread that owns the score. Writing it
+//    does not access the score and can be done on any thread.
+//---------------------------------------------------------
+
+struct CompressedSaveData {
+    struct ArchivedFile {
+        QString name;             // name in the new archive
+        QString archivePath;      // archive that still holds the file
+        QString sourceName;       // name in that archive
+    };
+
+    QByteArray container;
+    QString rootFileName;
+    QByteArray rootFile;
+    QList<QPair<QString, QByteArray> > files;   // pictures and audio
+    QList<ArchivedFile> archivedFiles;           // copied without being decompressed
+    QImage thumbnail;
+};
+
+//---------------------------------------------------------
+//   FileSaveData
+//    a save of a MasterScore to its file, see
+//    MasterScore::prepareSaveFile()
+//---------------------------------------------------------
+
+struct FileSaveData {
+    QFileInfo info;
+    bool msczFormat { true };
+    CompressedSaveData compressed;    // if msczFormat
+    QByteArray mscx;                  // otherwise
+    QString backupSubdir;             // empty: do not back up the previous file
+    int revision { 0 };               // Score::contentRevision() when prepared
+
+    QFileInfo backupInfo;             // set by writeSaveFile()
+    QString error;
+};
+
 class MasterScore;
 
 //-----------------------------------------------------------------------------
@@ -459,6 +517,9 @@ private:
 
     UpdateState _updateState;
 
+    std::deque<ContentChange> _contentJournal;
+    int _contentJournalOffset { 0 };      ///< number of changes dropped from the journal
+
     MeasureBaseList _measures;            // here are the notes
     QList<Part*> _parts;
     QList<Staff*> _staves;
@@ -853,8 +914,12 @@ public:
     bool saveFile(QIODevice* f, bool msczFormat, bool onlySelection = false);
     bool saveCompressedFile(QFileInfo&, bool onlySelection, bool createThumbnail = true);
     bool saveCompressedFile(QIODevice*, const QString& fileName, bool onlySelection, bool createThumbnail = true);
+    CompressedSaveData prepareCompressedSave(const QString& fileName, bool onlySelection, bool createThumbnail = true);
+    static bool writeCompressedFile(QIODevice*, const CompressedSaveData&, QString* error = 0);
+    void loadArchivedData(const QString& archivePath);
 
     void print(QPainter* printer, int page);
+    bool printPdf(QPdfWriter& pdfWriter);
     ChordRest* getSelectedChordRest() const;
     QSet<ChordRest*> getSelectedChordRests() const;
     void getSelectedChordRest2(ChordRest** cr1, ChordRest** cr2) const;
@@ -901,6 +966,11 @@ public:
 
     bool dirty() const;
     ScoreContentState state() const;
+
+    void recordContentChange(const CmdState&, bool staffRangeValid);
+    void recordChangesWithoutLayout();
+    int contentRevision() const { return _contentJournalOffset + int(_contentJournal.size()); }
+    bool contentChangesSince(int revision, std::vector<ContentChange>& changes) const;
     void setCreated(bool val) { _created = val; }
     bool created() const { return _created; }
     void setStartedEmpty(bool val) { _startedEmpty = val; }
@@ -1355,6 +1425,11 @@ class MasterScore : public Score
 
     CmdState _cmdState;       // modified during cmd processing
 
+    bool _snapshotsEnabled  { false };
+    bool _snapshotMeasures  { false };
+    mutable bool _snapshotOutdated { false };           // retaken when the repeat list is unwound
+    mutable std::shared_ptr<const ScoreSnapshot> _snapshot;   // accessed atomically
+
     Omr* _omr               { 0 };
     bool _showOmr           { false };
 
@@ -1435,10 +1510,18 @@ public:
 
     Revisions* revisions() { return _revisions; }
 
+    void setSnapshotsEnabled(bool val, bool withMeasures = false);
+    bool snapshotsEnabled() const { return _snapshotsEnabled; }
+    void updateSnapshot(bool force = false);
+    std::shared_ptr<const ScoreSnapshot> snapshot() const;
+
     bool isSavable() const;
     void setTempomap(TempoMap* tm);
 
     bool saveFile(bool generateBackup = true);
+    bool prepareSaveFile(FileSaveData&, bool generateBackup = true);
+    static bool writeSaveFile(FileSaveData&);
+    void finishSaveFile(const FileSaveData&);
     FileError read1(XmlReader&, bool ignoreVersionError);
     FileError loadCompressedMsc(QIODevice*, bool ignoreVersionError);
     FileError loadMsc(QString name, bool ignoreVersionError);
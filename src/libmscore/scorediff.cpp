@@ -15,12 +15,15 @@
 #include "duration.h"
 #include "measure.h"
 #include "score.h"
+#include "segment.h"
+#include "spanner.h"
 #include "staff.h"
 #include "xml.h"
 
 #include "dtl/dtl.hpp"
 
 #include <algorithm>
+#include <map>
 #include <utility>
 
 namespace Ms {
@@ -763,7 +766,13 @@ static QString scoreToMscx(Score* s, XmlWriter& xml)
 //---------------------------------------------------------
 
 ScoreDiff::ScoreDiff(Score* s1, Score* s2, bool textDiffOnly)
-    : _s1(s1), _s2(s2), _textDiffOnly(textDiffOnly)
+    : _s1(s1), _s2(s2), _textDiffOnly(textDiffOnly), _engine(DiffEngine::MSCX)
+{
+    update();
+}
+
+ScoreDiff::ScoreDiff(Score* s1, Score* s2, DiffEngine engine)
+    : _s1(s1), _s2(s2), _textDiffOnly(false), _engine(engine)
 {
     update();
 }
@@ -832,6 +841,14 @@ void ScoreDiff::update()
     qDeleteAll(_mergedTextDiffs);
     _mergedTextDiffs.clear();
 
+    if (_engine == DiffEngine::STRUCTURAL) {
+        structuralDiff();
+        std::stable_sort(_diffs.begin(), _diffs.end(), positionSort);
+        _scoreState1 = _s1->state();
+        _scoreState2 = _s2->state();
+        return;
+    }
+
     XmlWriter xml1(_s1);
     XmlWriter xml2(_s2);
     QString mscx1(scoreToMscx(_s1, xml1));
@@ -994,6 +1011,513 @@ void ScoreDiff::processMarkupDiffs()
     deleteDiffs(_diffs, abandonedDiffs);
 }
 
+//---------------------------------------------------------
+//   elementToMscx
+//---------------------------------------------------------
+
+static QString elementToMscx(const Element* e)
+{
+    QString mscx;
+    XmlWriter xml(e->score());
+    xml.setString(&mscx, QIODevice::WriteOnly);
+    e->write(xml);
+    xml.flush();
+    return mscx;
+}
+
+//---------------------------------------------------------
+//   StructuralDiffer
+//    Walks the trees of measures which content differs
+//    and creates ElementDiff and PropertyDiff items.
+//---------------------------------------------------------
+
+class StructuralDiffer
+{
+    std::vector<BaseDiff*>& _diffs;
+
+    static bool isLayoutOnly(const ScoreElement* se);
+    static bool skipProperty(Pid pid);
+    static std::vector<const Element*> treeChildren(const Element* e);
+
+    void addElementDiff(DiffType type, const Element* e1, const Element* e2, const ScoreElement* ctx1,
+                        const ScoreElement* ctx2);
+    void addPropertyDiff(Pid pid, const ScoreElement* e1, const ScoreElement* e2);
+    void diffProperties(const Element* e1, const Element* e2);
+    void diffElements(const Element* e1, const Element* e2, const Measure* m1, const Measure* m2);
+    void diffElementLists(const std::vector<const Element*>& l1, const std::vector<const Element*>& l2,
+                          const Measure* m1, const Measure* m2);
+    void diffMeasureStaff(const Measure* m1, const Measure* m2, int staff);
+
+public:
+    StructuralDiffer(std::vector<BaseDiff*>& diffs)
+        : _diffs(diffs) {}
+
+    void diffMeasures(const Measure* m1, const Measure* m2, const std::vector<uint>& h1, const std::vector<uint>& h2);
+    void measureInserted(const Measure* m, const Measure* before, int score);
+};
+
+//---------------------------------------------------------
+//   StructuralDiffer::isLayoutOnly
+//    Children which are created by layout and do not
+//    carry any content of their own.
+//---------------------------------------------------------
+
+bool StructuralDiffer::isLayoutOnly(const ScoreElement* se)
+{
+    if (!se->isElement() || toElement(se)->generated()) {
+        return true;
+    }
+    switch (se->type()) {
+    case ElementType::STEM:
+    case ElementType::HOOK:
+    case ElementType::STEM_SLASH:
+    case ElementType::LEDGER_LINE:
+    case ElementType::NOTEDOT:
+    case ElementType::BEAM:
+        return true;
+    default:
+        return false;
+    }
+}
+
+//---------------------------------------------------------
+//   StructuralDiffer::skipProperty
+//    Position is matched by the walk itself, the other
+//    properties are not part of the content or are set
+//    by layout (note line).
+//---------------------------------------------------------
+
+bool StructuralDiffer::skipProperty(Pid pid)
+{
+    switch (pid) {
+    case Pid::SELECTED:
+    case Pid::GENERATED:
+    case Pid::Z:
+    case Pid::LINE:
+    case Pid::TICK:
+    case Pid::TRACK:
+    case Pid::POSITION:
+    case Pid::SPANNER_TICK:
+    case Pid::SPANNER_TICKS:
+    case Pid::SPANNER_TRACK2:
+        return true;
+    default:
+        return false;
+    }
+}
+
+//---------------------------------------------------------
+//   StructuralDiffer::treeChildren
+//---------------------------------------------------------
+
+std::vector<const Element*> StructuralDiffer::treeChildren(const Element* e)
+{
+    std::vector<const Element*> children;
+    for (int i = 0; i < e->treeChildCount(); ++i) {
+        const ScoreElement* child = e->treeChild(i);
+        if (child && !isLayoutOnly(child)) {
+            children.push_back(toElement(child));
+        }
+    }
+    return children;
+}
+
+//---------------------------------------------------------
+//   StructuralDiffer::addElementDiff
+//---------------------------------------------------------
+
+void StructuralDiffer::addElementDiff(DiffType type, const Element* e1, const Element* e2, const ScoreElement* ctx1,
+                                      const ScoreElement* ctx2)
+{
+    ElementDiff* d = new ElementDiff;
+    d->type = type;
+    d->textDiff = nullptr;
+    d->el[0] = e1;
+    d->el[1] = e2;
+    d->ctx[0] = ctx1;
+    d->ctx[1] = ctx2;
+    d->before[0] = nullptr;
+    d->before[1] = nullptr;
+    _diffs.push_back(d);
+}
+
+//---------------------------------------------------------
+//   StructuralDiffer::addPropertyDiff
+//---------------------------------------------------------
+
+void StructuralDiffer::addPropertyDiff(Pid pid, const ScoreElement* e1, const ScoreElement* e2)
+{
+    PropertyDiff* d = new PropertyDiff;
+    d->type = DiffType::REPLACE;
+    d->textDiff = nullptr;
+    d->pid = pid;
+    d->ctx[0] = e1;
+    d->ctx[1] = e2;
+    d->before[0] = nullptr;
+    d->before[1] = nullptr;
+    _diffs.push_back(d);
+}
+
+//---------------------------------------------------------
+//   StructuralDiffer::diffProperties
+//    Properties which both elements take from their
+//    parents are reported on the parents.
+//---------------------------------------------------------
+
+void StructuralDiffer::diffProperties(const Element* e1, const Element* e2)
+{
+    for (int i = 0; i < int(Pid::END); ++i) {
+        const Pid pid = Pid(i);
+        if (skipProperty(pid)) {
+            continue;
+        }
+        const QVariant v1 = e1->getProperty(pid);
+        const QVariant v2 = e2->getProperty(pid);
+        if (v1 == v2 || !v1.isValid() || !v2.isValid()) {
+            continue;
+        }
+        if (e1->parent() && e2->parent()
+            && e1->parent()->getProperty(pid) == v1 && e2->parent()->getProperty(pid) == v2) {
+            continue;
+        }
+        addPropertyDiff(pid, e1, e2);
+    }
+}
+
+//---------------------------------------------------------
+//   StructuralDiffer::diffElements
+//    Either element may be null.
+//---------------------------------------------------------
+
+void StructuralDiffer::diffElements(const Element* e1, const Element* e2, const Measure* m1, const Measure* m2)
+{
+    if (!e1 && !e2) {
+        return;
+    }
+    if (!e1) {
+        addElementDiff(DiffType::INSERT, nullptr, e2, m1, m2);
+        return;
+    }
+    if (!e2) {
+        addElementDiff(DiffType::DELETE, e1, nullptr, m1, m2);
+        return;
+    }
+    if (e1->type() != e2->type()) {
+        addElementDiff(DiffType::REPLACE, e1, e2, m1, m2);
+        return;
+    }
+    if (elementToMscx(e1) == elementToMscx(e2)) {
+        return;
+    }
+
+    const size_t n = _diffs.size();
+    diffProperties(e1, e2);
+    diffElementLists(treeChildren(e1), treeChildren(e2), m1, m2);
+
+    if (_diffs.size() == n) {
+        // the difference is in something not exposed as a property or a child
+        addElementDiff(DiffType::REPLACE, e1, e2, m1, m2);
+    }
+}
+
+//---------------------------------------------------------
+//   StructuralDiffer::diffElementLists
+//    Elements of the same type are paired in order.
+//---------------------------------------------------------
+
+void StructuralDiffer::diffElementLists(const std::vector<const Element*>& l1, const std::vector<const Element*>& l2,
+                                        const Measure* m1, const Measure* m2)
+{
+    std::map<ElementType, std::pair<std::vector<const Element*>, std::vector<const Element*> > > byType;
+    for (const Element* e : l1) {
+        byType[e->type()].first.push_back(e);
+    }
+    for (const Element* e : l2) {
+        byType[e->type()].second.push_back(e);
+    }
+
+    for (const auto& p : byType) {
+        const std::vector<const Element*>& v1 = p.second.first;
+        const std::vector<const Element*>& v2 = p.second.second;
+        const size_t n = std::max(v1.size(), v2.size());
+        for (size_t i = 0; i < n; ++i) {
+            diffElements(i < v1.size() ? v1[i] : nullptr, i < v2.size() ? v2[i] : nullptr, m1, m2);
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   staffSpanners
+//    Spanners of the staff starting in the measure.
+//---------------------------------------------------------
+
+static std::vector<const Element*> staffSpanners(const Measure* m, int staff)
+{
+    std::vector<const Element*> spanners;
+    const auto& intervals = m->score()->spannerMap().findOverlapping(m->tick().ticks(), m->endTick().ticks() - 1);
+    for (const auto& interval : intervals) {
+        const Spanner* sp = interval.value;
+        if (!sp->generated() && sp->staffIdx() == staff && sp->tick() >= m->tick() && sp->tick() < m->endTick()) {
+            spanners.push_back(sp);
+        }
+    }
+    std::sort(spanners.begin(), spanners.end(), [](const Element* a, const Element* b) {
+        return toSpanner(a)->tick() < toSpanner(b)->tick();
+    });
+    return spanners;
+}
+
+//---------------------------------------------------------
+//   segmentStaffElements
+//---------------------------------------------------------
+
+static void segmentStaffElements(const Segment* s, int staff, std::vector<const Element*>& elements,
+                                 std::vector<const Element*>& annotations)
+{
+    const int strack = staff * VOICES;
+    for (int track = strack; track < strack + VOICES; ++track) {
+        elements.push_back(s->element(track));
+    }
+    for (const Element* a : s->annotations()) {
+        if (a->staffIdx() == staff && !a->generated()) {
+            annotations.push_back(a);
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   StructuralDiffer::diffMeasureStaff
+//---------------------------------------------------------
+
+void StructuralDiffer::diffMeasureStaff(const Measure* m1, const Measure* m2, int staff)
+{
+    const bool hasStaff1 = staff < m1->score()->nstaves();
+    const bool hasStaff2 = staff < m2->score()->nstaves();
+
+    // measure elements: layout breaks, spacers, images...
+    std::vector<const Element*> l1;
+    std::vector<const Element*> l2;
+    for (const Element* e : m1->el()) {
+        if (hasStaff1 && e->staffIdx() == staff && !e->generated()) {
+            l1.push_back(e);
+        }
+    }
+    for (const Element* e : m2->el()) {
+        if (hasStaff2 && e->staffIdx() == staff && !e->generated()) {
+            l2.push_back(e);
+        }
+    }
+    diffElementLists(l1, l2, m1, m2);
+
+    // segments are matched by type and position in the measure
+    std::map<std::pair<int, int>, const Segment*> segments2;
+    if (hasStaff2) {
+        for (const Segment* s = m2->first(); s; s = s->next()) {
+            segments2[{ s->rtick().ticks(), int(s->segmentType()) }] = s;
+        }
+    }
+
+    std::vector<const Element*> none(VOICES, nullptr);
+    auto diffSegments = [&](const Segment* s1, const Segment* s2) {
+        std::vector<const Element*> e1;
+        std::vector<const Element*> e2;
+        std::vector<const Element*> a1;
+        std::vector<const Element*> a2;
+        if (s1) {
+            segmentStaffElements(s1, staff, e1, a1);
+        } else {
+            e1 = none;
+        }
+        if (s2) {
+            segmentStaffElements(s2, staff, e2, a2);
+        } else {
+            e2 = none;
+        }
+        for (int voice = 0; voice < VOICES; ++voice) {
+            diffElements(e1[voice], e2[voice], m1, m2);
+        }
+        diffElementLists(a1, a2, m1, m2);
+    };
+
+    if (hasStaff1) {
+        for (const Segment* s1 = m1->first(); s1; s1 = s1->next()) {
+            auto it = segments2.find({ s1->rtick().ticks(), int(s1->segmentType()) });
+            if (it == segments2.end()) {
+                diffSegments(s1, nullptr);
+            } else {
+                diffSegments(s1, it->second);
+                segments2.erase(it);
+            }
+        }
+    }
+    for (const auto& p : segments2) {
+        diffSegments(nullptr, p.second);
+    }
+
+    diffElementLists(hasStaff1 ? staffSpanners(m1, staff) : std::vector<const Element*>(),
+                     hasStaff2 ? staffSpanners(m2, staff) : std::vector<const Element*>(), m1, m2);
+}
+
+//---------------------------------------------------------
+//   StructuralDiffer::diffMeasures
+//    h1, h2 are the content hashes of the measures staves.
+//---------------------------------------------------------
+
+void StructuralDiffer::diffMeasures(const Measure* m1, const Measure* m2, const std::vector<uint>& h1,
+                                    const std::vector<uint>& h2)
+{
+    static const Pid measurePids[] {
+        Pid::TIMESIG_NOMINAL, Pid::TIMESIG_ACTUAL, Pid::REPEAT_START, Pid::REPEAT_END, Pid::REPEAT_COUNT,
+        Pid::IRREGULAR, Pid::BREAK_MMR, Pid::USER_STRETCH, Pid::NO_OFFSET, Pid::MEASURE_NUMBER_MODE
+    };
+    for (Pid pid : measurePids) {
+        if (m1->getProperty(pid) != m2->getProperty(pid)) {
+            addPropertyDiff(pid, m1, m2);
+        }
+    }
+
+    const size_t nstaves = std::max(h1.size(), h2.size());
+    for (size_t staff = 0; staff < nstaves; ++staff) {
+        if (staff < h1.size() && staff < h2.size() && h1[staff] == h2[staff]) {
+            continue;
+        }
+        diffMeasureStaff(m1, m2, int(staff));
+    }
+}
+
+//---------------------------------------------------------
+//   StructuralDiffer::measureInserted
+//    m exists only in the given score, before is the
+//    preceding measure in the other score.
+//---------------------------------------------------------
+
+void StructuralDiffer::measureInserted(const Measure* m, const Measure* before, int score)
+{
+    if (score == 1) {
+        addElementDiff(DiffType::INSERT, nullptr, m, before, m);
+    } else {
+        addElementDiff(DiffType::DELETE, m, nullptr, m, before);
+    }
+}
+
+//---------------------------------------------------------
+//   alignMeasures
+//    Returns pairs of measures with equal hashes along the
+//    longest common subsequence of both hash sequences.
+//    Common head and tail are matched without a search.
+//---------------------------------------------------------
+
+static std::vector<std::pair<int, int> > alignMeasures(const std::vector<uint>& h1, const std::vector<uint>& h2)
+{
+    static constexpr size_t maxLcsCells = 16 * 1024 * 1024;
+
+    const int n1 = int(h1.size());
+    const int n2 = int(h2.size());
+    int head = 0;
+    while (head < n1 && head < n2 && h1[head] == h2[head]) {
+        ++head;
+    }
+    int tail = 0;
+    while (tail < n1 - head && tail < n2 - head && h1[n1 - 1 - tail] == h2[n2 - 1 - tail]) {
+        ++tail;
+    }
+
+    std::vector<std::pair<int, int> > pairs;
+    for (int i = 0; i < head; ++i) {
+        pairs.push_back({ i, i });
+    }
+
+    const int r1 = n1 - head - tail;
+    const int r2 = n2 - head - tail;
+    if (r1 > 0 && r2 > 0 && size_t(r1 + 1) * size_t(r2 + 1) <= maxLcsCells) {
+        // lcs[i][j]: length of the common subsequence of the rest from i, j
+        std::vector<int> lcs(size_t(r1 + 1) * size_t(r2 + 1), 0);
+        auto at = [&lcs, r2](int i, int j) -> int& { return lcs[size_t(i) * size_t(r2 + 1) + size_t(j)]; };
+        for (int i = r1 - 1; i >= 0; --i) {
+            for (int j = r2 - 1; j >= 0; --j) {
+                if (h1[head + i] == h2[head + j]) {
+                    at(i, j) = at(i + 1, j + 1) + 1;
+                } else {
+                    at(i, j) = std::max(at(i + 1, j), at(i, j + 1));
+                }
+            }
+        }
+        int i = 0;
+        int j = 0;
+        while (i < r1 && j < r2) {
+            if (h1[head + i] == h2[head + j]) {
+                pairs.push_back({ head + i, head + j });
+                ++i;
+                ++j;
+            } else if (at(i + 1, j) >= at(i, j + 1)) {
+                ++i;
+            } else {
+                ++j;
+            }
+        }
+    }
+    // else: too large to search, the rest is compared measure by measure
+
+    for (int i = tail; i > 0; --i) {
+        pairs.push_back({ n1 - i, n2 - i });
+    }
+    return pairs;
+}
+
+//---------------------------------------------------------
+//   ScoreDiff::structuralDiff
+//---------------------------------------------------------
+
+void ScoreDiff::structuralDiff()
+{
+    std::vector<const Measure*> measures[2];
+    std::vector<std::vector<uint> > staffHashes[2];
+    std::vector<uint> hashes[2];
+
+    const Score* scores[2] { _s1, _s2 };
+    for (int i = 0; i < 2; ++i) {
+        const int nstaves = scores[i]->nstaves();
+        for (const Measure* m = scores[i]->firstMeasure(); m; m = m->nextMeasure()) {
+            std::vector<uint> h;
+            h.reserve(nstaves);
+            uint mh = 0;
+            for (int staff = 0; staff < nstaves; ++staff) {
+                h.push_back(m->contentHash(staff));
+                mh = qHash(qMakePair(mh, h.back()));
+            }
+            measures[i].push_back(m);
+            staffHashes[i].push_back(std::move(h));
+            hashes[i].push_back(mh);
+        }
+    }
+
+    StructuralDiffer differ(_diffs);
+
+    // unmatched measures between two matched ones are compared in order,
+    // the excess is inserted or deleted
+    auto diffGap = [&](int b1, int e1, int b2, int e2) {
+        const int n = std::min(e1 - b1, e2 - b2);
+        for (int k = 0; k < n; ++k) {
+            differ.diffMeasures(measures[0][b1 + k], measures[1][b2 + k], staffHashes[0][b1 + k], staffHashes[1][b2 + k]);
+        }
+        for (int k = b1 + n; k < e1; ++k) {
+            differ.measureInserted(measures[0][k], b2 + n > 0 ? measures[1][b2 + n - 1] : nullptr, 0);
+        }
+        for (int k = b2 + n; k < e2; ++k) {
+            differ.measureInserted(measures[1][k], b1 + n > 0 ? measures[0][b1 + n - 1] : nullptr, 1);
+        }
+    };
+
+    int i1 = 0;
+    int i2 = 0;
+    for (const std::pair<int, int>& p : alignMeasures(hashes[0], hashes[1])) {
+        diffGap(i1, p.first, i2, p.second);
+        i1 = p.first + 1;
+        i2 = p.second + 1;
+    }
+    diffGap(i1, int(measures[0].size()), i2, int(measures[1].size()));
+}
+
 //---------------------------------------------------------
 //   ScoreDiff::mergeInsertDeleteDiffs
 //    Merge INSERT and DELETE diffs to REPLACE diffs where
@@ -1180,6 +1704,9 @@ void ScoreDiff::editPropertyDiffs()
 
 bool ScoreDiff::equal() const
 {
+    if (_engine == DiffEngine::STRUCTURAL) {
+        return _diffs.empty();
+    }
     for (const TextDiff& td : _textDiffs) {
         if (td.type != DiffType::EQUAL) {
             return false;
@@ -127,6 +127,20 @@ struct MarkupDiff : public BaseDiff {
     QString toString() const override;
 };
 
+//---------------------------------------------------------
+//   DiffEngine
+//    MSCX runs a text diff over the serialized scores.
+//    STRUCTURAL walks measures, segments and elements of
+//    both scores and skips measures with equal content
+//    hashes, its cost scales with the size of the change.
+//    It produces no text diffs.
+//---------------------------------------------------------
+
+enum class DiffEngine {
+    MSCX,
+    STRUCTURAL
+};
+
 //---------------------------------------------------------
 //   ScoreDiff
 //---------------------------------------------------------
@@ -142,7 +156,9 @@ class ScoreDiff
     ScoreContentState _scoreState2;
 
     bool _textDiffOnly;
+    DiffEngine _engine;
 
+    void structuralDiff();
     void processMarkupDiffs();
     void mergeInsertDeleteDiffs();
     void mergeElementDiffs();
@@ -150,6 +166,7 @@ class ScoreDiff
 
 public:
     ScoreDiff(Score* s1, Score* s2, bool textDiffOnly = false);
+    ScoreDiff(Score* s1, Score* s2, DiffEngine engine);
     ScoreDiff(const ScoreDiff&) = delete;
     ~ScoreDiff();
 
@@ -158,6 +175,7 @@ public:
 
     std::vector<BaseDiff*>& diffs() { return _diffs; }
     const std::vector<TextDiff>& textDiffs() const { return _textDiffs; }
+    DiffEngine engine() const { return _engine; }
 
     const Score* score1() const { return _s1; }
     const Score* score2() const { return _s2; }
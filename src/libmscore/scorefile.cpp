@@ -13,6 +13,7 @@
 #include <cmath>
 #include <QDir>
 #include <QBuffer>
+#include <QPdfWriter>
 
 #include "config.h"
 #include "score.h"
@@ -380,16 +381,66 @@ void Score::readStaff(XmlReader& e)
 //---------------------------------------------------------
 
 bool MasterScore::saveFile(bool generateBackup)
+{
+    FileSaveData data;
+    if (!prepareSaveFile(data, generateBackup)) {
+        return false;
+    }
+    if (!writeSaveFile(data)) {
+        MScore::lastError = data.error;
+        return false;
+    }
+    finishSaveFile(data);
+    return true;
+}
+
+//---------------------------------------------------------
+//   prepareSaveFile
+//    serialize the score and render the thumbnail for
+//    writeSaveFile(); must be called on the thread that
+//    owns the score
+//---------------------------------------------------------
+
+bool MasterScore::prepareSaveFile(FileSaveData& data, bool generateBackup)
 {
     if (readOnly()) {
         return false;
     }
-    QString suffix = info.suffix();
     if (info.exists() && !info.isWritable()) {
         MScore::lastError = tr("The following file is locked: \n%1 \n\nTry saving to a different location.").arg(
             info.filePath());
         return false;
     }
+    data.info = info;
+    data.msczFormat = info.suffix() != "mscx";
+    if (data.msczFormat) {
+        data.compressed = prepareCompressedSave(info.completeBaseName() + ".mscx", false);
+    } else {
+        QBuffer buffer(&data.mscx);
+        buffer.open(QIODevice::WriteOnly);
+        if (!Score::saveFile(&buffer, false)) {
+            return false;
+        }
+    }
+    // if file was already saved in this session
+    // save but don't overwrite backup again
+    if (!saved() && generateBackup) {
+        data.backupSubdir = preferences().backupDirPath();
+    }
+    data.revision = contentRevision();
+    return true;
+}
+
+//---------------------------------------------------------
+//   writeSaveFile
+//    write a file prepared by prepareSaveFile() and move
+//    the previous file into the backup directory. Does not
+//    access the score and can be called on any thread.
+//---------------------------------------------------------
+
+bool MasterScore::writeSaveFile(FileSaveData& data)
+{
+    const QFileInfo& info = data.info;
     //
     // step 1
     // save into temporary file to prevent partially overwriting
@@ -399,24 +450,20 @@ bool MasterScore::saveFile(bool generateBackup)
     QString tempName = info.filePath() + QString(".temp");
     QFile temp(tempName);
     if (!temp.open(QIODevice::WriteOnly)) {
-        MScore::lastError = tr("Open Temp File\n%1\nfailed: %2").arg(tempName, strerror(errno));
+        data.error = tr("Open Temp File\n%1\nfailed: %2").arg(tempName, strerror(errno));
         return false;
     }
 
-    bool rv = false;
-    if ("mscx" == suffix) {
-        rv = Score::saveFile(&temp, false);
+    if (data.msczFormat) {
+        if (!writeCompressedFile(&temp, data.compressed, &data.error)) {
+            return false;
+        }
     } else {
-        QString fileName = info.completeBaseName() + ".mscx";
-        rv = Score::saveCompressedFile(&temp, fileName, false);
-    }
-
-    if (!rv) {
-        return false;
+        temp.write(data.mscx);
     }
 
     if (temp.error() != QFile::NoError) {
-        MScore::lastError = tr("Save File failed: %1").arg(temp.errorString());
+        data.error = tr("Save File failed: %1").arg(temp.errorString());
         return false;
     }
     temp.close();
@@ -424,16 +471,13 @@ bool MasterScore::saveFile(bool generateBackup)
     const QString name(info.filePath());
     const QString basename(info.fileName());
     QDir dir(info.path());
-    if (!saved() && generateBackup) {
-        // if file was already saved in this session
-        // save but don't overwrite backup again
-
+    if (!data.backupSubdir.isEmpty()) {
         //
         // step 2
         // remove old backup file if exists
         // remove the backup file in the same dir as score (the traditional place) if exists
         //
-        const QString backupSubdirString = preferences().backupDirPath();
+        const QString backupSubdirString = data.backupSubdir;
         const QString backupDirString = info.path() + QString(QDir::separator()) + backupSubdirString;
         QDir backupDir(backupDirString);
         if (!backupDir.exists()) {
@@ -483,7 +527,7 @@ bool MasterScore::saveFile(bool generateBackup)
         }
 
         QFileInfo fileBackup(backupDir, backupName);
-        _sessionStartBackupInfo = fileBackup;
+        data.backupInfo = fileBackup;
     } else {
         // file has previously been saved - remove the old file
         if (dir.exists(basename)) {
@@ -500,18 +544,34 @@ bool MasterScore::saveFile(bool generateBackup)
     // rename temp name into file name
     //
     if (!QFile::rename(tempName, name)) {
-        MScore::lastError = tr("Renaming temp. file <%1> to <%2> failed:\n%3").arg(tempName, name, strerror(errno));
+        data.error = tr("Renaming temp. file <%1> to <%2> failed:\n%3").arg(tempName, name, strerror(errno));
         return false;
     }
     // make file readable by all
     QFile::setPermissions(name, QFile::ReadOwner | QFile::WriteOwner | QFile::ReadUser
                           | QFile::ReadGroup | QFile::ReadOther);
 
-    undoStack()->setClean();
+    return true;
+}
+
+//---------------------------------------------------------
+//   finishSaveFile
+//    after writeSaveFile() succeeded, on the thread that
+//    owns the score. Changes made in between keep the
+//    score dirty.
+//---------------------------------------------------------
+
+void MasterScore::finishSaveFile(const FileSaveData& data)
+{
+    if (!data.backupSubdir.isEmpty()) {
+        _sessionStartBackupInfo = data.backupInfo;
+    }
+    if (contentRevision() == data.revision) {
+        undoStack()->setClean();
+    }
     setSaved(true);
     info.refresh();
     update();
-    return true;
 }
 
 //---------------------------------------------------------
@@ -523,6 +583,9 @@ bool Score::saveCompressedFile(QFileInfo& info, bool onlySelection, bool createT
     if (readOnly() && info == *masterScore()->fileInfo()) {
         return false;
     }
+    // opening truncates the file, which may still hold images and audio of the score
+    loadArchivedData(info.absoluteFilePath());
+
     QFile fp(info.filePath());
     if (!fp.open(QIODevice::WriteOnly)) {
         MScore::lastError = tr("Open File\n%1\nfailed: %2").arg(info.filePath(), strerror(errno));
@@ -533,6 +596,23 @@ bool Score::saveCompressedFile(QFileInfo& info, bool onlySelection, bool createT
     return saveCompressedFile(&fp, fileName, onlySelection, createThumbnail);
 }
 
+//---------------------------------------------------------
+//   loadArchivedData
+//    read the images and audio that are still in the
+//    archive archivePath into memory
+//---------------------------------------------------------
+
+void Score::loadArchivedData(const QString& archivePath)
+{
+    if (archivePath.isEmpty()) {
+        return;
+    }
+    imageStore.loadUsed(this, archivePath);
+    if (_audio && _audio->archivePath() == archivePath) {
+        _audio->data();
+    }
+}
+
 //---------------------------------------------------------
 //   createThumbnail
 //---------------------------------------------------------
@@ -556,17 +636,15 @@ QImage Score::createThumbnail()
     pm.setDotsPerMeterY(dpm);
     pm.fill(0xffffffff);
 
-    double pr = MScore::pixelRatio;
-    MScore::pixelRatio = 1.0;
-
-    QPainter p(&pm);
-    p.setRenderHint(QPainter::Antialiasing, true);
-    p.setRenderHint(QPainter::TextAntialiasing, true);
-    p.scale(mag, mag);
-    print(&p, 0);
-    p.end();
-
-    MScore::pixelRatio = pr;
+    {
+        PrintingState printingState(1.0, true);
+        QPainter p(&pm);
+        p.setRenderHint(QPainter::Antialiasing, true);
+        p.setRenderHint(QPainter::TextAntialiasing, true);
+        p.scale(mag, mag);
+        print(&p, 0);
+        p.end();
+    }
 
     if (layoutMode() != mode) {
         setLayoutMode(mode);
@@ -577,12 +655,26 @@ QImage Score::createThumbnail()
 
 //---------------------------------------------------------
 //   saveCompressedFile
-//    file is already opened
+//    file is already opened; if it is an archive the score
+//    was read from, loadArchivedData() must have been
+//    called before opening it
 //---------------------------------------------------------
 
 bool Score::saveCompressedFile(QIODevice* f, const QString& fn, bool onlySelection, bool doCreateThumbnail)
 {
-    MQZipWriter uz(f);
+    return writeCompressedFile(f, prepareCompressedSave(fn, onlySelection, doCreateThumbnail));
+}
+
+//---------------------------------------------------------
+//   prepareCompressedSave
+//    serialize the score and collect pictures, audio and
+//    the thumbnail image; must be called on the thread
+//    that owns the score
+//---------------------------------------------------------
+
+CompressedSaveData Score::prepareCompressedSave(const QString& fn, bool onlySelection, bool doCreateThumbnail)
+{
+    CompressedSaveData data;
 
     QBuffer cbuf;
     cbuf.open(QIODevice::ReadWrite);
@@ -602,52 +694,96 @@ bool Score::saveCompressedFile(QIODevice* f, const QString& fn, bool onlySelecti
 
     xml.etag();
     xml.etag();
-    cbuf.seek(0);
-    //uz.addDirectory("META-INF");
-    uz.addFile("META-INF/container.xml", cbuf.data());
+    data.container = cbuf.data();
 
     QBuffer dbuf;
     dbuf.open(QIODevice::ReadWrite);
     saveFile(&dbuf, true, onlySelection);
-    dbuf.seek(0);
-    uz.addFile(fn, dbuf.data());
+    data.rootFileName = fn;
+    data.rootFile = dbuf.data();
 
-    QFileDevice* fd = dynamic_cast<QFileDevice*>(f);
-    if (fd) { // if is file (may be buffer)
-        fd->flush();     // flush to preserve score data in case of
-    }
-    // any failures on the further operations.
-
-    // save images
-    //uz.addDirectory("Pictures");
+    // pictures that were not used since loading are copied from their archive
     for (ImageStoreItem* ip : imageStore) {
         if (!ip->isUsed(this)) {
             continue;
         }
         QString path = QString("Pictures/") + ip->hashName();
-        uz.addFile(path, ip->buffer());
+        if (!ip->archivePath().isEmpty() && QFileInfo::exists(ip->archivePath())) {
+            data.archivedFiles.append({ path, ip->archivePath(), ip->path() });
+        } else {
+            data.files.append({ path, ip->buffer() });
+        }
     }
 
-    // create thumbnail
     if (doCreateThumbnail && !pages().isEmpty()) {
-        QImage pm = createThumbnail();
+        data.thumbnail = createThumbnail();
+    }
+
+    if (_audio) {
+        if (!_audio->archivePath().isEmpty() && QFileInfo::exists(_audio->archivePath())) {
+            data.archivedFiles.append({ "audio.ogg", _audio->archivePath(), "audio.ogg" });
+        } else {
+            data.files.append({ "audio.ogg", _audio->data() });
+        }
+    }
+
+    return data;
+}
 
+//---------------------------------------------------------
+//   writeCompressedFile
+//    compress and write the entries of a prepared save;
+//    entries are compressed in parallel. Fails if an
+//    entry cannot be copied from its archive; the message
+//    goes to error, or to MScore::lastError if it is 0.
+//---------------------------------------------------------
+
+bool Score::writeCompressedFile(QIODevice* f, const CompressedSaveData& data, QString* error)
+{
+    MQZipWriter uz(f);
+
+    uz.addFiles({ { "META-INF/container.xml", data.container }, { data.rootFileName, data.rootFile } });
+
+    QFileDevice* fd = dynamic_cast<QFileDevice*>(f);
+    if (fd) { // if is file (may be buffer)
+        fd->flush();     // flush to preserve score data in case of
+    }
+    // any failures on the further operations.
+
+    QVector<QPair<QString, QByteArray> > files = data.files.toVector();
+
+    if (!data.thumbnail.isNull()) {
         QByteArray ba;
         QBuffer b(&ba);
         if (!b.open(QIODevice::WriteOnly)) {
             qDebug("open buffer failed");
         }
-        if (!pm.save(&b, "PNG")) {
+        if (!data.thumbnail.save(&b, "PNG")) {
             qDebug("save failed");
         }
-        uz.addFile("Thumbnails/thumbnail.png", ba);
+        files.append({ "Thumbnails/thumbnail.png", ba });
     }
 
-    //
-    // save audio
-    //
-    if (_audio) {
-        uz.addFile("audio.ogg", _audio->data());
+    uz.addFiles(files);
+
+    QString archivePath;
+    QScopedPointer<MQZipReader> source;
+    for (const CompressedSaveData::ArchivedFile& file : data.archivedFiles) {
+        if (file.archivePath != archivePath) {
+            archivePath = file.archivePath;
+            source.reset(new MQZipReader(archivePath));
+        }
+        if (!uz.copyFile(*source, file.sourceName, file.name)) {
+            // container.xml already lists the entry, do not write an incomplete file
+            const QString msg = tr("Cannot copy <%1> from <%2>").arg(file.sourceName, file.archivePath);
+            if (error) {
+                *error = msg;
+            } else {
+                MScore::lastError = msg;
+            }
+            uz.close();
+            return false;
+        }
     }
 
     uz.close();
@@ -823,27 +959,39 @@ Score::FileError MasterScore::loadCompressedMsc(QIODevice* io, bool ignoreVersio
         return FileError::FILE_NO_ROOTFILE;
     }
 
+    // images and audio of a score file are read from the archive on first use
+    QFile* file = qobject_cast<QFile*>(io);
+    QString archivePath = file ? QFileInfo(file->fileName()).absoluteFilePath() : QString();
+
     //
     // load images
     //
     if (!MScore::noImages) {
         foreach (const QString& s, sl) {
-            QByteArray dbuf = uz.fileData(s);
-            imageStore.add(s, dbuf);
+            if (archivePath.isEmpty() || !imageStore.addFromArchive(s, archivePath)) {
+                QByteArray dbuf = uz.fileData(s);
+                imageStore.add(s, dbuf);
+            }
         }
     }
 
-    QByteArray dbuf = uz.fileData(rootfile);
-    if (dbuf.isEmpty()) {
+    QScopedPointer<QIODevice> dev(uz.fileDevice(rootfile));
+    if (!dev) {
         QVector<MQZipReader::FileInfo> fil = uz.fileInfoList();
         foreach (const MQZipReader::FileInfo& fi, fil) {
             if (fi.filePath.endsWith(".mscx")) {
-                dbuf = uz.fileData(fi.filePath);
+                dev.reset(uz.fileDevice(fi.filePath));
                 break;
             }
         }
     }
-    XmlReader e(dbuf);
+    if (!dev) {
+        dev.reset(new QBuffer());
+        dev->open(QIODevice::ReadOnly);
+    }
+
+    // the root file is inflated while it is parsed
+    XmlReader e(dev.data());
     e.setDocName(masterScore()->fileInfo()->completeBaseName());
 
     FileError retval = read1(e, ignoreVersionError);
@@ -852,8 +1000,12 @@ Score::FileError MasterScore::loadCompressedMsc(QIODevice* io, bool ignoreVersio
     //  read audio
     //
     if (audio()) {
-        QByteArray dbuf1 = uz.fileData("audio.ogg");
-        audio()->setData(dbuf1);
+        if (archivePath.isEmpty()) {
+            QByteArray dbuf1 = uz.fileData("audio.ogg");
+            audio()->setData(dbuf1);
+        } else {
+            audio()->setArchive(archivePath);
+        }
     }
     return retval;
 }
@@ -986,6 +1138,7 @@ Score::FileError MasterScore::read1(XmlReader& e, bool ignoreVersionError)
 void Score::print(QPainter* painter, int pageNo)
 {
     _printing  = true;
+    bool pdfPrinting = MScore::pdfPrinting;
     MScore::pdfPrinting = true;
     Page* page = pages().at(pageNo);
     QRectF fr  = page->abbox();
@@ -1001,10 +1154,49 @@ void Score::print(QPainter* painter, int pageNo)
         e->draw(painter);
         painter->restore();
     }
-    MScore::pdfPrinting = false;
+    MScore::pdfPrinting = pdfPrinting;
     _printing = false;
 }
 
+//---------------------------------------------------------
+//   printPdf
+//    paint all pages into pdfWriter, which is set up by
+//    the caller; the pages go through its one painter,
+//    one after another
+//---------------------------------------------------------
+
+bool Score::printPdf(QPdfWriter& pdfWriter)
+{
+    setPrinting(true);
+
+    QPainter painter;
+    if (!painter.begin(&pdfWriter)) {
+        setPrinting(false);
+        return false;
+    }
+
+    QSizeF size(styleD(Sid::pageWidth), styleD(Sid::pageHeight));
+    painter.setRenderHint(QPainter::Antialiasing, true);
+    painter.setRenderHint(QPainter::TextAntialiasing, true);
+    painter.setViewport(QRect(0.0, 0.0, size.width() * pdfWriter.logicalDpiX(),
+                              size.height() * pdfWriter.logicalDpiY()));
+    painter.setWindow(QRect(0.0, 0.0, size.width() * DPI, size.height() * DPI));
+
+    {
+        PrintingState printingState(DPI / pdfWriter.logicalDpiX(), true);
+        for (int pageNumber = 0; pageNumber < npages(); ++pageNumber) {
+            if (pageNumber > 0) {
+                pdfWriter.newPage();
+            }
+            print(&painter, pageNumber);
+        }
+    }
+
+    painter.end();
+    setPrinting(false);
+    return true;
+}
+
 //---------------------------------------------------------
 //   readCompressedToBuffer
 //---------------------------------------------------------
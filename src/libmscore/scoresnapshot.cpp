@@ -0,0 +1,260 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "scoresnapshot.h"
+
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+#include "measure.h"
+#include "repeatlist.h"
+#include "score.h"
+
+namespace Ms {
+//---------------------------------------------------------
+//   MeasureSnapshot::memoryUsage
+//---------------------------------------------------------
+
+size_t MeasureSnapshot::memoryUsage() const
+{
+    size_t n = sizeof(MeasureSnapshot) + hashes.capacity() * sizeof(uint) + staves.capacity() * sizeof(QByteArray);
+    for (const QByteArray& ba : staves) {
+        n += size_t(ba.capacity());
+    }
+    return n;
+}
+
+//---------------------------------------------------------
+//   sameTempos
+//---------------------------------------------------------
+
+static bool sameTempos(const TempoMap& a, const TempoMap& b)
+{
+    if (a.size() != b.size() || a.relTempo() != b.relTempo()) {
+        return false;
+    }
+    return std::equal(a.begin(), a.end(), b.begin(), [](const std::pair<const int, TEvent>& e1, const std::pair<const int, TEvent>& e2) {
+        return e1.first == e2.first && e1.second.type == e2.second.type && e1.second.tempo == e2.second.tempo
+               && e1.second.pause == e2.second.pause && e1.second.time == e2.second.time;
+    });
+}
+
+//---------------------------------------------------------
+//   take
+//    withMeasures: also keep the MSCX of every measure.
+//    Measures with the same content as in the previous
+//    snapshot are shared with it, only the changed ones
+//    are serialized. Must be called on the thread that
+//    owns the score.
+//---------------------------------------------------------
+
+std::shared_ptr<const ScoreSnapshot> ScoreSnapshot::take(const Score* score,
+                                                         const std::shared_ptr<const ScoreSnapshot>& previous,
+                                                         bool withMeasures)
+{
+    std::shared_ptr<ScoreSnapshot> snapshot(new ScoreSnapshot);
+    snapshot->_revision = score->contentRevision();
+    snapshot->_nstaves = score->nstaves();
+
+    // the maps rarely change between two commands: compare
+    // them, which does not allocate, before copying
+    const TempoMap* tempomap = score->tempomap();
+    if (previous && sameTempos(*previous->_tempomap, *tempomap)) {
+        snapshot->_tempomap = previous->_tempomap;
+    } else {
+        snapshot->_tempomap = std::make_shared<const TempoMap>(*tempomap);
+    }
+    const TimeSigMap* sigmap = score->sigmap();
+    if (previous && static_cast<const std::map<int, SigEvent>&>(*previous->_sigmap) == *sigmap) {
+        snapshot->_sigmap = previous->_sigmap;
+    } else {
+        snapshot->_sigmap = std::make_shared<const TimeSigMap>(*sigmap);
+    }
+    std::vector<RepeatSnapshot> repeats;
+    for (const RepeatSegment* rs : score->repeatList()) {
+        repeats.push_back({ rs->tick, rs->utick, rs->utime, rs->timeOffset });
+    }
+    if (previous && *previous->_repeats == repeats) {
+        snapshot->_repeats = previous->_repeats;
+    } else {
+        snapshot->_repeats = std::make_shared<const std::vector<RepeatSnapshot> >(std::move(repeats));
+    }
+
+    if (!withMeasures) {
+        return snapshot;
+    }
+
+    std::unordered_multimap<uint, std::shared_ptr<const MeasureSnapshot> > previousMeasures;
+    if (previous && !previous->_measures.empty()) {
+        previousMeasures.reserve(previous->_measures.size());
+        for (const MeasureEntry& e : previous->_measures) {
+            uint h = 0;
+            for (uint sh : e.measure->hashes) {
+                h = qHash(qMakePair(h, sh));
+            }
+            previousMeasures.insert({ h, e.measure });
+        }
+    }
+
+    const int nstaves = snapshot->_nstaves;
+    snapshot->_measures.reserve(score->nmeasures());
+    for (const Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        std::vector<uint> hashes;
+        hashes.reserve(nstaves);
+        for (int staffIdx = 0; staffIdx < nstaves; ++staffIdx) {
+            hashes.push_back(m->contentHash(staffIdx));
+        }
+
+        std::shared_ptr<const MeasureSnapshot> measure;
+        auto range = previousMeasures.equal_range(m->contentHash());
+        for (auto it = range.first; it != range.second; ++it) {
+            const MeasureSnapshot* ms = it->second.get();
+            if (ms->hashes == hashes && ms->len == m->ticks() && ms->timesig == m->timesig()) {
+                measure = it->second;
+                break;
+            }
+        }
+
+        if (!measure) {
+            std::shared_ptr<MeasureSnapshot> ms = std::make_shared<MeasureSnapshot>();
+            ms->len = m->ticks();
+            ms->timesig = m->timesig();
+            ms->hashes = std::move(hashes);
+            ms->staves.reserve(nstaves);
+            for (int staffIdx = 0; staffIdx < nstaves; ++staffIdx) {
+                ms->staves.push_back(m->staffMscx(staffIdx).toUtf8());
+            }
+            measure = ms;
+        }
+
+        snapshot->_measures.push_back({ m->tick(), measure });
+    }
+
+    return snapshot;
+}
+
+//---------------------------------------------------------
+//   measureAt
+//---------------------------------------------------------
+
+const ScoreSnapshot::MeasureEntry* ScoreSnapshot::measureAt(const Fraction& tick) const
+{
+    auto it = std::upper_bound(_measures.begin(), _measures.end(), tick, [](const Fraction& t, const MeasureEntry& e) {
+        return t < e.tick;
+    });
+    if (it == _measures.begin()) {
+        return nullptr;
+    }
+    --it;
+    return tick < it->tick + it->measure->len ? &*it : nullptr;
+}
+
+//---------------------------------------------------------
+//   utick2utime
+//    as RepeatList::utick2utime(), but without its lookup
+//    cache, so that it can be called from any thread
+//---------------------------------------------------------
+
+qreal ScoreSnapshot::utick2utime(int utick) const
+{
+    const std::vector<RepeatSnapshot>& rl = *_repeats;
+    auto it = std::upper_bound(rl.begin(), rl.end(), utick, [](int t, const RepeatSnapshot& r) {
+        return t < r.utick;
+    });
+    if (it == rl.begin()) {
+        return 0.0;
+    }
+    --it;
+    return _tempomap->tick2time(utick - (it->utick - it->tick)) + it->timeOffset;
+}
+
+//---------------------------------------------------------
+//   utime2utick
+//---------------------------------------------------------
+
+int ScoreSnapshot::utime2utick(qreal utime) const
+{
+    const std::vector<RepeatSnapshot>& rl = *_repeats;
+    auto it = std::upper_bound(rl.begin(), rl.end(), utime, [](qreal t, const RepeatSnapshot& r) {
+        return t < r.utime;
+    });
+    if (it == rl.begin()) {
+        return 0;
+    }
+    --it;
+    return _tempomap->time2tick(utime - it->timeOffset) + (it->utick - it->tick);
+}
+
+//---------------------------------------------------------
+//   memoryUsage
+//---------------------------------------------------------
+
+size_t ScoreSnapshot::memoryUsage() const
+{
+    size_t n = sizeof(ScoreSnapshot) + _measures.capacity() * sizeof(MeasureEntry);
+    for (const MeasureEntry& e : _measures) {
+        n += e.measure->memoryUsage();
+    }
+    return n;
+}
+
+//---------------------------------------------------------
+//   memoryUsageNotSharedWith
+//    what this snapshot costs if the other one is kept
+//---------------------------------------------------------
+
+size_t ScoreSnapshot::memoryUsageNotSharedWith(const ScoreSnapshot& other) const
+{
+    std::unordered_set<const MeasureSnapshot*> shared;
+    for (const MeasureEntry& e : other._measures) {
+        shared.insert(e.measure.get());
+    }
+    size_t n = sizeof(ScoreSnapshot) + _measures.capacity() * sizeof(MeasureEntry);
+    for (const MeasureEntry& e : _measures) {
+        if (shared.find(e.measure.get()) == shared.end()) {
+            n += e.measure->memoryUsage();
+        }
+    }
+    return n;
+}
+
+//---------------------------------------------------------
+//   sharedMeasures
+//---------------------------------------------------------
+
+int ScoreSnapshot::sharedMeasures(const ScoreSnapshot& other) const
+{
+    std::unordered_set<const MeasureSnapshot*> shared;
+    for (const MeasureEntry& e : other._measures) {
+        shared.insert(e.measure.get());
+    }
+    int n = 0;
+    for (const MeasureEntry& e : _measures) {
+        if (shared.find(e.measure.get()) != shared.end()) {
+            ++n;
+        }
+    }
+    return n;
+}
+
+//---------------------------------------------------------
+//   sharesMaps
+//    whether the tempo and time signature maps and the
+//    repeats were taken over from the other snapshot
+//---------------------------------------------------------
+
+bool ScoreSnapshot::sharesMaps(const ScoreSnapshot& other) const
+{
+    return _tempomap == other._tempomap && _sigmap == other._sigmap && _repeats == other._repeats;
+}
+}
@@ -0,0 +1,110 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __SCORESNAPSHOT_H__
+#define __SCORESNAPSHOT_H__
+
+#include <memory>
+#include <vector>
+
+#include <QByteArray>
+
+#include "fraction.h"
+#include "sig.h"
+#include "tempo.h"
+
+namespace Ms {
+class Score;
+
+//---------------------------------------------------------
+//   MeasureSnapshot
+//    Immutable content of one measure. Snapshots taken
+//    one after another share the measures which did not
+//    change in between.
+//---------------------------------------------------------
+
+struct MeasureSnapshot {
+    Fraction len;
+    Fraction timesig;
+    std::vector<uint> hashes;         // per staff, see Measure::contentHash()
+    std::vector<QByteArray> staves;   // per staff, what is saved for the measure (MSCX)
+
+    size_t memoryUsage() const;
+};
+
+//---------------------------------------------------------
+//   RepeatSnapshot
+//    one segment of the unwound score, see RepeatSegment
+//---------------------------------------------------------
+
+struct RepeatSnapshot {
+    int tick;
+    int utick;
+    qreal utime;
+    qreal timeOffset;
+
+    bool operator==(const RepeatSnapshot& r) const
+    {
+        return tick == r.tick && utick == r.utick && utime == r.utime && timeOffset == r.timeOffset;
+    }
+};
+
+//---------------------------------------------------------
+//   ScoreSnapshot
+//    Immutable view of the tempo, time signatures, repeats
+//    and, if asked for, the measures of a score. It is taken
+//    on the thread that owns the score, does not refer to
+//    the score and can be read from any thread afterwards.
+//    Maps which did not change are shared with the previous
+//    snapshot.
+//---------------------------------------------------------
+
+class ScoreSnapshot
+{
+public:
+    struct MeasureEntry {
+        Fraction tick;
+        std::shared_ptr<const MeasureSnapshot> measure;
+    };
+
+    static std::shared_ptr<const ScoreSnapshot> take(const Score* score,
+                                                     const std::shared_ptr<const ScoreSnapshot>& previous = nullptr,
+                                                     bool withMeasures = false);
+
+    int revision() const { return _revision; }
+    int nstaves() const { return _nstaves; }
+    const std::vector<MeasureEntry>& measures() const { return _measures; }
+    const MeasureEntry* measureAt(const Fraction& tick) const;
+    const TempoMap& tempomap() const { return *_tempomap; }
+    const TimeSigMap& sigmap() const { return *_sigmap; }
+    const std::vector<RepeatSnapshot>& repeats() const { return *_repeats; }
+
+    qreal utick2utime(int utick) const;
+    int utime2utick(qreal utime) const;
+
+    size_t memoryUsage() const;
+    size_t memoryUsageNotSharedWith(const ScoreSnapshot& other) const;
+    int sharedMeasures(const ScoreSnapshot& other) const;
+    bool sharesMaps(const ScoreSnapshot& other) const;
+
+private:
+    ScoreSnapshot() = default;
+
+    int _revision { 0 };               // Score::contentRevision() when taken
+    int _nstaves { 0 };
+    std::vector<MeasureEntry> _measures;
+    std::shared_ptr<const TempoMap> _tempomap;
+    std::shared_ptr<const TimeSigMap> _sigmap;
+    std::shared_ptr<const std::vector<RepeatSnapshot> > _repeats;
+};
+}     // namespace Ms
+#endif
@@ -10,6 +10,8 @@
 //  the file LICENCE.GPL
 //=============================================================================
 
+#include <atomic>
+
 #include "mscore.h"
 #include "segment.h"
 #include "element.h"
@@ -209,6 +211,7 @@ void Segment::init()
     _elist.assign(tracks, 0);
     _dotPosX.assign(staves, 0.0);
     _shapes.assign(staves, Shape());
+    shapesChanged();
 }
 
 //---------------------------------------------------------
@@ -466,6 +469,7 @@ void Segment::insertStaff(int staff)
     }
     _dotPosX.insert(_dotPosX.begin() + staff, 0.0);
     _shapes.insert(_shapes.begin() + staff, Shape());
+    shapesChanged();
 
     for (Element* e : _annotations) {
         int staffIdx = e->staffIdx();
@@ -486,6 +490,7 @@ void Segment::removeStaff(int staff)
     _elist.erase(_elist.begin() + track, _elist.begin() + track + VOICES);
     _dotPosX.erase(_dotPosX.begin() + staff);
     _shapes.erase(_shapes.begin() + staff);
+    shapesChanged();
 
     for (Element* e : _annotations) {
         int staffIdx = e->staffIdx();
@@ -2168,6 +2173,7 @@ void Segment::createShapes()
 
 void Segment::createShape(int staffIdx)
 {
+    shapesChanged();
     Shape& s = _shapes[staffIdx];
     s.clear();
 
@@ -2306,12 +2312,57 @@ qreal Segment::minLeft() const
 
 qreal Segment::minHorizontalCollidingDistance(Segment* ns) const
 {
-    qreal w = 0.0;
+    // ns is usually not the next segment here (see Measure::computeMinWidth()),
+    // going through the cache would evict the distance to the next segment
+    return qMax(0.0, computeShapeDistance(ns));
+}
+
+//---------------------------------------------------------
+//   newShapesGeneration
+//---------------------------------------------------------
+
+quint64 Segment::newShapesGeneration()
+{
+    static std::atomic<quint64> generation { 0 };
+    return ++generation;
+}
+
+//---------------------------------------------------------
+//   computeShapeDistance
+//    maximum over all staves of the minimum horizontal
+//    distance between the shapes of this segment and ns
+//---------------------------------------------------------
+
+qreal Segment::computeShapeDistance(const Segment* ns) const
+{
+    qreal d = -1000000.0;
     for (unsigned staffIdx = 0; staffIdx < _shapes.size(); ++staffIdx) {
-        qreal d = staffShape(staffIdx).minHorizontalDistance(ns->staffShape(staffIdx));
-        w       = qMax(w, d);
+        d = qMax(d, _shapes[staffIdx].minHorizontalDistance(ns->_shapes[staffIdx]));
     }
-    return w;
+    return d;
+}
+
+//---------------------------------------------------------
+//   shapeDistance
+//    computeShapeDistance() to the following segment; the
+//    last result is kept until one of the shapes changes
+//    or it is asked for another segment
+//---------------------------------------------------------
+
+qreal Segment::shapeDistance(const Segment* ns) const
+{
+    if (_distanceTo == ns && _distanceGeneration == _shapesGeneration
+        && _distanceToGeneration == ns->_shapesGeneration) {
+        return _distance;
+    }
+
+    const qreal d = computeShapeDistance(ns);
+
+    _distanceTo           = ns;
+    _distanceGeneration   = _shapesGeneration;
+    _distanceToGeneration = ns->_shapesGeneration;
+    _distance             = d;
+    return d;
 }
 
 qreal Segment::elementsTopOffsetFromSkyline(int staffIndex) const
@@ -2371,15 +2422,18 @@ qreal Segment::elementsBottomOffsetFromSkyline(int staffIndex) const
 
 qreal Segment::minHorizontalDistance(Segment* ns, bool systemHeaderGap) const
 {
-    qreal ww = -1000000.0;          // can remain negative
-    for (unsigned staffIdx = 0; staffIdx < _shapes.size(); ++staffIdx) {
-        qreal d = ns ? staffShape(staffIdx).minHorizontalDistance(ns->staffShape(staffIdx)) : 0.0;
-        // first chordrest of a staff should clear the widest header for any staff
-        // so make sure segment is as wide as it needs to be
-        if (systemHeaderGap) {
-            d = qMax(d, staffShape(staffIdx).right());
+    qreal ww;                       // can remain negative
+    if (ns) {
+        ww = shapeDistance(ns);
+    } else {
+        ww = _shapes.empty() ? -1000000.0 : 0.0;
+    }
+    // first chordrest of a staff should clear the widest header for any staff
+    // so make sure segment is as wide as it needs to be
+    if (systemHeaderGap) {
+        for (const Shape& sh : _shapes) {
+            ww = qMax(ww, sh.right());
         }
-        ww      = qMax(ww, d);
     }
     qreal w = qMax(ww, 0.0);        // non-negative
 
@@ -62,6 +62,17 @@ class Segment final : public Element
     std::vector<Shape> _shapes;           // size = staves
     std::vector<qreal> _dotPosX;          // size = staves
 
+    quint64 _shapesGeneration { newShapesGeneration() };     // new value whenever _shapes may change
+    mutable const Segment* _distanceTo { nullptr };         // last result of shapeDistance()
+    mutable quint64 _distanceGeneration   { 0 };
+    mutable quint64 _distanceToGeneration { 0 };
+    mutable qreal _distance { 0.0 };
+
+    static quint64 newShapesGeneration();
+    void shapesChanged() { _shapesGeneration = newShapesGeneration(); }
+    qreal computeShapeDistance(const Segment* ns) const;
+    qreal shapeDistance(const Segment* ns) const;
+
     void init();
     void checkEmpty() const;
     void checkElement(Element*, int track);
@@ -225,7 +236,7 @@ public:
     std::vector<Shape> shapes() { return _shapes; }
     const std::vector<Shape>& shapes() const { return _shapes; }
     const Shape& staffShape(int staffIdx) const { return _shapes[staffIdx]; }
-    Shape& staffShape(int staffIdx) { return _shapes[staffIdx]; }
+    Shape& staffShape(int staffIdx) { shapesChanged(); return _shapes[staffIdx]; }
     void createShapes();
     void createShape(int staffIdx);
     qreal minRight() const;
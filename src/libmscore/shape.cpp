@@ -10,6 +10,8 @@
 //  the file LICENCE.GPL
 //=============================================================================
 
+#include <algorithm>
+
 #include "shape.h"
 #include "segment.h"
 
@@ -78,26 +80,69 @@ Shape Shape::translated(const QPointF& pt) const
     return s;
 }
 
+//-------------------------------------------------------------------
+//   horizontallyInteract
+//    true if r1 and r2 (right of r1) have to be kept apart
+//-------------------------------------------------------------------
+
+static inline bool horizontallyInteract(const QRectF& r1, const QRectF& r2)
+{
+    qreal ay1 = r1.top();
+    qreal ay2 = r1.bottom();
+    qreal by1 = r2.top();
+    qreal by2 = r2.bottom();
+    return Ms::intersects(ay1, ay2, by1, by2)
+           || ((r1.height() == 0.0) && (r2.height() == 0.0) && (ay1 == by1))
+           || ((r1.width() == 0.0) || (r2.width() == 0.0));
+}
+
 //-------------------------------------------------------------------
 //   minHorizontalDistance
 //    a is located right of this shape.
 //    Calculates the minimum horizontal distance between the two shapes
 //    so they don’t touch.
+//    For big shapes the rectangles of this shape are visited by
+//    descending right edge: the first one interacting with a
+//    rectangle of a gives the distance to it.
 //-------------------------------------------------------------------
 
 qreal Shape::minHorizontalDistance(const Shape& a) const
 {
+    static const size_t SORT_THRESHOLD = 64;      // pairs to compare
+
     qreal dist = -1000000.0;        // min real
+    if (size() * a.size() < SORT_THRESHOLD) {
+        for (const QRectF& r2 : a) {
+            qreal bx1 = r2.left();
+            for (const QRectF& r1 : *this) {
+                qreal d = r1.right() - bx1;
+                if (d > dist && horizontallyInteract(r1, r2)) {
+                    dist = d;
+                }
+            }
+        }
+        return dist;
+    }
+
+    std::vector<const QRectF*> byRight;
+    byRight.reserve(size());
+    for (const QRectF& r1 : *this) {
+        byRight.push_back(&r1);
+    }
+    std::sort(byRight.begin(), byRight.end(), [](const QRectF* r1, const QRectF* r2) {
+        return r1->right() > r2->right();
+    });
+
     for (const QRectF& r2 : a) {
-        qreal by1 = r2.top();
-        qreal by2 = r2.bottom();
-        for (const QRectF& r1 : *this) {
-            qreal ay1 = r1.top();
-            qreal ay2 = r1.bottom();
-            if (Ms::intersects(ay1, ay2, by1, by2)
-                || ((r1.height() == 0.0) && (r2.height() == 0.0) && (ay1 == by1))
-                || ((r1.width() == 0.0) || (r2.width() == 0.0))) {
-                dist = qMax(dist, r1.right() - r2.left());
+        qreal bx1 = r2.left();
+        for (const QRectF* r1 : byRight) {
+            qreal d = r1->right() - bx1;
+            if (!(d > dist)) {
+                break;              // no rectangle left can increase dist
+            }
+            if (horizontallyInteract(*r1, r2)) {
+                dist = d;
+                break;
             }
         }
     }
@@ -10,6 +10,8 @@
 //  the file LICENCE.GPL
 //=============================================================================
 
+#include <atomic>
+
 #include "connector.h"
 #include "score.h"
 #include "spanner.h"
@@ -359,9 +361,12 @@ void SpannerSegment::scanElements(void* data, void (* func)(void*, Element*), bo
 //   Spanner
 //---------------------------------------------------------
 
+static std::atomic<unsigned> spannerCount { 0 };
+
 Spanner::Spanner(Score* s, ElementFlags f)
     : Element(s, f)
 {
+    _creationIndex = spannerCount++;
 }
 
 Spanner::Spanner(const Spanner& s)
@@ -373,6 +378,7 @@ Spanner::Spanner(const Spanner& s)
     _tick         = s._tick;
     _ticks        = s._ticks;
     _track2       = s._track2;
+    _creationIndex = spannerCount++;
 }
 
 Spanner::~Spanner()
@@ -1197,7 +1203,7 @@ void Spanner::setTick(const Fraction& v)
 {
     _tick = v;
     if (score()) {
-        score()->spannerMap().setDirty();
+        score()->spannerMap().setDirty(this);
     }
 }
 
@@ -1218,7 +1224,7 @@ void Spanner::setTicks(const Fraction& f)
 {
     _ticks = f;
     if (score()) {
-        score()->spannerMap().setDirty();
+        score()->spannerMap().setDirty(this);
     }
 }
 
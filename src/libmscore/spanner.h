@@ -146,6 +146,7 @@ private:
     Fraction _ticks        { Fraction(0, 1) };
     int _track2            { -1 };
     bool _broken           { false };
+    unsigned _creationIndex;                      // order in which the spanners were created
 
     std::vector<SpannerSegment*> segments;
     std::deque<SpannerSegment*> unusedSegments;   // Currently unused segments which can be reused later.
@@ -197,6 +198,8 @@ public:
     void setTrack2(int v) { _track2 = v; }
     int effectiveTrack2() const { return _track2 == -1 ? track() : _track2; }
 
+    unsigned creationIndex() const { return _creationIndex; }
+
     bool broken() const { return _broken; }
     void setBroken(bool v) { _broken = v; }
 
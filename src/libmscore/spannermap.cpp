@@ -10,6 +10,8 @@
 //  the file LICENCE.GPL
 //=============================================================================
 
+#include <algorithm>
+
 #include "spannermap.h"
 #include "spanner.h"
 
@@ -32,24 +34,108 @@ SpannerMap::SpannerMap()
 void SpannerMap::update() const
 {
     std::vector<interval_tree::Interval<Spanner*> > intervals;
+    intervals.reserve(size());
     for (auto i : *this) {
         intervals.push_back(interval_tree::Interval<Spanner*>(i.second->tick().ticks(), i.second->tick2().ticks(), i.second));
     }
-    tree = interval_tree::IntervalTree<Spanner*>(intervals);
+    tree.reset(new interval_tree::IntervalTree<Spanner*>(intervals));
+    added.clear();
+    stale.clear();
     dirty = false;
 }
 
 //---------------------------------------------------------
-//   findContained
+//   checkPending
+//    give up on merging when there are more changes
+//    than it is worth, the tree is rebuilt instead
 //---------------------------------------------------------
 
-const std::vector<interval_tree::Interval<Spanner*> >& SpannerMap::findContained(int start, int stop)
+void SpannerMap::checkPending() const
 {
-    if (dirty) {
+    if (added.size() + stale.size() > 32 + size() / 32) {
+        dirty = true;
+        added.clear();
+        stale.clear();
+    }
+}
+
+//---------------------------------------------------------
+//   prepareQuery
+//---------------------------------------------------------
+
+void SpannerMap::prepareQuery()
+{
+    if (dirty || !tree) {
         update();
     }
     results.clear();
-    tree.findContained(start, stop, results);
+}
+
+//---------------------------------------------------------
+//   spannerLess
+//    order of the query results: by start tick, then by
+//    values of the spanner and last by creation order, so
+//    that spanners starting on the same tick do not come
+//    out in an order depending on how the map was edited
+//---------------------------------------------------------
+
+static bool spannerLess(const interval_tree::Interval<Spanner*>& a, const interval_tree::Interval<Spanner*>& b)
+{
+    if (a.start != b.start) {
+        return a.start < b.start;
+    }
+    if (a.stop != b.stop) {
+        return a.stop < b.stop;
+    }
+    const Spanner* sa = a.value;
+    const Spanner* sb = b.value;
+    if (sa->track() != sb->track()) {
+        return sa->track() < sb->track();
+    }
+    if (sa->track2() != sb->track2()) {
+        return sa->track2() < sb->track2();
+    }
+    if (sa->type() != sb->type()) {
+        return sa->type() < sb->type();
+    }
+    return sa->creationIndex() < sb->creationIndex();
+}
+
+//---------------------------------------------------------
+//   finishQuery
+//    drop results for spanners removed or moved since the
+//    tree was built, add the matching spanners not in the
+//    tree and sort the results
+//---------------------------------------------------------
+
+template<typename Match>
+void SpannerMap::finishQuery(Match match)
+{
+    if (!stale.empty()) {
+        results.erase(std::remove_if(results.begin(), results.end(),
+                                     [this](const interval_tree::Interval<Spanner*>& i) {
+            return stale.count(i.value) != 0;
+        }), results.end());
+    }
+    for (Spanner* s : added) {
+        int tick  = s->tick().ticks();
+        int tick2 = s->tick2().ticks();
+        if (match(tick, tick2)) {
+            results.push_back(interval_tree::Interval<Spanner*>(tick, tick2, s));
+        }
+    }
+    std::sort(results.begin(), results.end(), spannerLess);
+}
+
+//---------------------------------------------------------
+//   findContained
+//---------------------------------------------------------
+
+const std::vector<interval_tree::Interval<Spanner*> >& SpannerMap::findContained(int start, int stop)
+{
+    prepareQuery();
+    tree->findContained(start, stop, results);
+    finishQuery([start, stop](int tick, int tick2) { return tick >= start && tick2 <= stop; });
     return results;
 }
 
@@ -59,11 +145,9 @@ const std::vector<interval_tree::Interval<Spanner*> >& SpannerMap::findContained
 
 const std::vector<interval_tree::Interval<Spanner*> >& SpannerMap::findOverlapping(int start, int stop)
 {
-    if (dirty) {
-        update();
-    }
-    results.clear();
-    tree.findOverlapping(start, stop, results);
+    prepareQuery();
+    tree->findOverlapping(start, stop, results);
+    finishQuery([start, stop](int tick, int tick2) { return tick2 >= start && tick <= stop; });
     return results;
 }
 
@@ -84,7 +168,13 @@ void SpannerMap::addSpanner(Spanner* s)
 #endif
 #endif
     insert(std::pair<int,Spanner*>(s->tick().ticks(), s));
-    dirty = true;
+    members.insert(s);
+    if (members.count(s) > 1) {
+        dirty = true;             // added twice
+    } else if (!dirty) {
+        added.push_back(s);
+        checkPending();
+    }
 }
 
 //---------------------------------------------------------
@@ -93,15 +183,72 @@ void SpannerMap::addSpanner(Spanner* s)
 
 bool SpannerMap::removeSpanner(Spanner* s)
 {
-    for (auto i = begin(); i != end(); ++i) {
+    // the key is the start tick at the time the spanner was added,
+    // so look there first
+    auto range = equal_range(s->tick().ticks());
+    auto found = end();
+    for (auto i = range.first; i != range.second; ++i) {
         if (i->second == s) {
-            erase(i);
-            dirty = true;
-            return true;
+            found = i;
+            break;
+        }
+    }
+    if (found == end()) {
+        for (auto i = begin(); i != end(); ++i) {
+            if (i->second == s) {
+                found = i;
+                break;
+            }
         }
     }
-    qDebug("%s (%p) not found", s->name(), s);
-    return false;
+    if (found == end()) {
+        qDebug("%s (%p) not found", s->name(), s);
+        return false;
+    }
+
+    erase(found);
+    auto m = members.find(s);
+    if (m != members.end()) {
+        members.erase(m);
+    }
+    if (!dirty) {
+        auto i = std::find(added.begin(), added.end(), s);
+        if (i != added.end()) {
+            added.erase(i);
+        } else {
+            stale.insert(s);
+            checkPending();
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------
+//   clear
+//---------------------------------------------------------
+
+void SpannerMap::clear()
+{
+    std::multimap<int, Spanner*>::clear();
+    members.clear();
+    dirty = true;
+}
+
+//---------------------------------------------------------
+//   setDirty
+//    s changed its start or length
+//---------------------------------------------------------
+
+void SpannerMap::setDirty(Spanner* s) const
+{
+    if (dirty || !members.count(s)) {
+        return;
+    }
+    if (std::find(added.begin(), added.end(), s) == added.end()) {
+        stale.insert(s);
+        added.push_back(s);
+        checkPending();
+    }
 }
 
 #ifndef NDEBUG
@@ -14,6 +14,9 @@
 #define __SPANNERMAP_H__
 
 #include <map>
+#include <memory>
+#include <unordered_set>
+#include <vector>
 #include "thirdparty/intervaltree/IntervalTree.h"
 
 namespace Ms {
@@ -21,14 +24,25 @@ class Spanner;
 
 //---------------------------------------------------------
 //   SpannerMap
+//    Spanners added, removed or moved after the lookup tree
+//    was built are kept aside and merged into the query
+//    results, the tree is only rebuilt when there are too
+//    many of them.
 //---------------------------------------------------------
 
 class SpannerMap : std::multimap<int, Spanner*>
 {
     mutable bool dirty;
-    mutable interval_tree::IntervalTree<Spanner*> tree;
+    mutable std::unique_ptr<interval_tree::IntervalTree<Spanner*> > tree;
+    mutable std::vector<Spanner*> added;              // not in tree
+    mutable std::unordered_set<Spanner*> stale;       // removed or moved, but still in tree
+    std::unordered_multiset<Spanner*> members;
     std::vector<interval_tree::Interval<Spanner*> > results;
 
+    void checkPending() const;
+    void prepareQuery();
+    template<typename Match> void finishQuery(Match match);
+
 public:
     SpannerMap();
     const std::vector<interval_tree::Interval<Spanner*> >& findContained(int start, int stop);
@@ -44,9 +58,10 @@ public:
     std::multimap<int,Spanner*>::const_iterator cend() const { return std::multimap<int, Spanner*>::cend(); }
     void addSpanner(Spanner* s);
     bool removeSpanner(Spanner* s);
-    void clear() { std::multimap<int, Spanner*>::clear(); dirty = true; }
+    void clear();
     void update() const;
-    void setDirty() const { dirty = true; }     // must be called if a spanner changes start/length
+    void setDirty() const { dirty = true; }
+    void setDirty(Spanner* s) const;            // must be called if a spanner changes start/length
 #ifndef NDEBUG
     void dump() const;
 #endif
@@ -17,6 +17,9 @@
 #include <QJsonObject>
 #include <QJsonArray>
 #include <QCache>
+#include <QMutex>
+#include <QGlyphRun>
+#include <QRawFont>
 
 #include "style.h"
 #include "sym.h"
@@ -6071,6 +6074,24 @@ SymId Sym::userName2id(const QString& s)
     return SymId::noSym;
 }
 
+//---------------------------------------------------------
+//   glyphMutex
+//    guards the FreeType faces, the glyph caches and the
+//    lazily created fonts, which all scores share
+//---------------------------------------------------------
+
+static QMutex glyphMutex;
+
+//---------------------------------------------------------
+//   loadMutex
+//    guards the lazy ScoreFont::load() in fontFactory()
+//    and fallbackFont(), scores can be opened and exported
+//    on several threads at once; load() itself asks for
+//    the fallback font
+//---------------------------------------------------------
+
+static QRecursiveMutex loadMutex;
+
 //---------------------------------------------------------
 //   GlyphKey operator==
 //---------------------------------------------------------
@@ -6092,6 +6113,107 @@ Sym ScoreFont::sym(SymId id) const
     return Sym();
 }
 
+//---------------------------------------------------------
+//   printFont
+//    the font used to draw symbols as text in pdf and svg
+//    export, sized for the current MScore::pixelRatio
+//---------------------------------------------------------
+
+bool ScoreFont::printFont(QFont& f) const
+{
+    bool fontAdded = false;
+    {
+        QMutexLocker locker(&glyphMutex);
+        if (font == 0) {
+            QString s(_fontPath + _filename);
+            if (-1 == QFontDatabase::addApplicationFont(s)) {
+                qDebug("Mscore: fatal error: cannot load internal font <%s>", qPrintable(s));
+                return false;
+            }
+            fontAdded = true;
+            font = new QFont;
+            font->setWeight(QFont::Normal);
+            font->setItalic(false);
+            font->setFamily(_family);
+            font->setStyleStrategy(QFont::NoFontMerging);
+            font->setHintingPreference(QFont::PreferVerticalHinting);
+        }
+        f = *font;
+    }
+    // not under glyphMutex, the text layout cache has its own lock
+    if (fontAdded) {
+        MScore::invalidateRenderCaches();
+    }
+    qreal size = 20.0 * MScore::pixelRatio;
+    f.setPointSize(size);
+    return true;
+}
+
+//---------------------------------------------------------
+//   drawGlyphRun
+//    pdf and svg export: draw the symbols as one run of
+//    glyphs of the embedded font. Unlike drawText() this
+//    does no text shaping and the paint engine gets one
+//    text item for the whole run.
+//    Returns false if the run can not be drawn this way.
+//---------------------------------------------------------
+
+bool ScoreFont::drawGlyphRun(const std::vector<SymId>& ids, QPainter* painter, const QSizeF& mag, const QPointF& pos) const
+{
+    if (ids.empty()) {
+        return true;
+    }
+
+    QVector<quint32> glyphs;
+    QVector<QPointF> positions;
+    glyphs.reserve(int(ids.size()));
+    positions.reserve(int(ids.size()));
+
+    qreal x = 0.0;
+    for (SymId id : ids) {
+        Sym s = sym(id);
+        if (!s.symList().empty() || !s.isValid()) {     // compound or fallback font symbol
+            return false;
+        }
+        glyphs.append(s.index());
+        positions.append(QPointF(x, 0.0));
+        x += s.advance();
+    }
+
+    QFont f;
+    if (!printFont(f)) {
+        return false;
+    }
+    QRawFont rawFont;
+    {
+        QMutexLocker locker(&glyphMutex);
+        const QPair<int, int> key(f.pointSize(), painter->device()->logicalDpiY());
+        auto i = rawFonts.find(key);
+        if (i == rawFonts.end()) {
+            i = rawFonts.insert(key, QRawFont::fromFont(QFont(f, painter->device())));
+        }
+        rawFont = i.value();
+    }
+    if (!rawFont.isValid()) {
+        return false;
+    }
+
+    QGlyphRun run;
+    run.setRawFont(rawFont);
+    run.setGlyphIndexes(glyphs);
+    run.setPositions(positions);
+
+    // glyph positions are relative to the run, so that equal runs
+    // produce equal text items (see SvgPaintEngine::drawTextItem())
+    QTransform transform = painter->transform();
+    painter->translate(pos);
+    painter->scale(mag.width(), mag.height());
+    painter->drawGlyphRun(QPointF(), run);
+    painter->setTransform(transform);
+
+    return true;
+}
+
 //---------------------------------------------------------
 //   draw
 //---------------------------------------------------------
@@ -6127,31 +6249,17 @@ void ScoreFont::draw(SymId id, QPainter* painter, const QSizeF& mag, const QPoin
         }
         return;
     }
-    int rv = FT_Load_Glyph(face, sym(id).index(), FT_LOAD_DEFAULT);
-    if (rv) {
-        qDebug("load glyph id %d, failed: 0x%x", int(id), rv);
-        return;
-    }
-
     if (MScore::pdfPrinting) {
-        if (font == 0) {
-            QString s(_fontPath + _filename);
-            if (-1 == QFontDatabase::addApplicationFont(s)) {
-                qDebug("Mscore: fatal error: cannot load internal font <%s>", qPrintable(s));
-                return;
-            }
-            font = new QFont;
-            font->setWeight(QFont::Normal);
-            font->setItalic(false);
-            font->setFamily(_family);
-            font->setStyleStrategy(QFont::NoFontMerging);
-            font->setHintingPreference(QFont::PreferVerticalHinting);
+        if (MScore::printGlyphRuns && drawGlyphRun({ id }, painter, mag, pos)) {
+            return;
+        }
+        QFont f;
+        if (!printFont(f)) {
+            return;
         }
-        qreal size = 20.0 * MScore::pixelRatio;
-        font->setPointSize(size);
         QSizeF imag = QSizeF(1.0 / mag.width(), 1.0 / mag.height());
         painter->scale(mag.width(), mag.height());
-        painter->setFont(*font);
+        painter->setFont(f);
         painter->drawText(QPointF(pos.x() * imag.width(), pos.y() * imag.height()), toString(id));
         painter->scale(imag.width(), imag.height());
         return;
@@ -6167,53 +6275,66 @@ void ScoreFont::draw(SymId id, QPainter* painter, const QSizeF& mag, const QPoin
     int scale16X      = lrint(worldScale * 6553.6 * mag.width() * DPI_F);
     int scale16Y      = lrint(worldScale * 6553.6 * mag.height() * DPI_F);
 
-    GlyphKey gk(face, id, mag.width(), mag.height(), worldScale, color);
-    GlyphPixmap* pm = cache->object(gk);
-
-    if (!pm) {
-        FT_Matrix matrix {
-            scale16X, 0,
-            0,       scale16Y
-        };
-
-        FT_Glyph glyph;
-        FT_Get_Glyph(face->glyph, &glyph);
-        FT_Glyph_Transform(glyph, &matrix, 0);
-        rv = FT_Glyph_To_Bitmap(&glyph, FT_RENDER_MODE_NORMAL, 0, 1);
-        if (rv) {
-            qDebug("glyph to bitmap failed: 0x%x", rv);
-            return;
-        }
+    GlyphPixmap gp;
+    {
+        // the face and the cache are shared by all scores
+        QMutexLocker locker(&glyphMutex);
 
-        FT_BitmapGlyph gb = (FT_BitmapGlyph)glyph;
-        FT_Bitmap* bm     = &gb->bitmap;
+        GlyphKey gk(face, id, mag.width(), mag.height(), worldScale, color);
+        GlyphPixmap* cached = cache->object(gk);
 
-        if (bm->width == 0 || bm->rows == 0) {
-            qDebug("zero glyph, id %d", int(id));
-            return;
-        }
-        QImage img(QSize(bm->width, bm->rows), QImage::Format_ARGB32);
-        img.fill(Qt::transparent);
-
-        for (unsigned y = 0; y < bm->rows; ++y) {
-            unsigned* dst      = (unsigned*)img.scanLine(y);
-            unsigned char* src = (unsigned char*)(bm->buffer) + bm->pitch * y;
-            for (unsigned x = 0; x < bm->width; ++x) {
-                unsigned val = *src++;
-                color.setAlpha(std::min(int(val), painter->pen().color().alpha()));
-                *dst++ = color.rgba();
+        if (cached) {
+            gp = *cached;
+        } else {
+            int rv = FT_Load_Glyph(face, sym(id).index(), FT_LOAD_DEFAULT);
+            if (rv) {
+                qDebug("load glyph id %d, failed: 0x%x", int(id), rv);
+                return;
             }
+
+            FT_Matrix matrix {
+                scale16X, 0,
+                0,       scale16Y
+            };
+
+            FT_Glyph glyph;
+            FT_Get_Glyph(face->glyph, &glyph);
+            FT_Glyph_Transform(glyph, &matrix, 0);
+            rv = FT_Glyph_To_Bitmap(&glyph, FT_RENDER_MODE_NORMAL, 0, 1);
+            if (rv) {
+                qDebug("glyph to bitmap failed: 0x%x", rv);
+                return;
+            }
+
+            FT_BitmapGlyph gb = (FT_BitmapGlyph)glyph;
+            FT_Bitmap* bm     = &gb->bitmap;
+
+            if (bm->width == 0 || bm->rows == 0) {
+                qDebug("zero glyph, id %d", int(id));
+                return;
+            }
+            QImage img(QSize(bm->width, bm->rows), QImage::Format_ARGB32);
+            img.fill(Qt::transparent);
+
+            for (unsigned y = 0; y < bm->rows; ++y) {
+                unsigned* dst      = (unsigned*)img.scanLine(y);
+                unsigned char* src = (unsigned char*)(bm->buffer) + bm->pitch * y;
+                for (unsigned x = 0; x < bm->width; ++x) {
+                    unsigned val = *src++;
+                    color.setAlpha(std::min(int(val), painter->pen().color().alpha()));
+                    *dst++ = color.rgba();
+                }
+            }
+            gp.pm = QPixmap::fromImage(img, Qt::NoFormatConversion);
+            gp.pm.setDevicePixelRatio(worldScale);
+            gp.offset = QPointF(qreal(gb->left), -qreal(gb->top)) / worldScale;
+            if (!cache->insert(gk, new GlyphPixmap(gp))) {
+                qDebug("cannot cache glyph");
+            }
+            FT_Done_Glyph(glyph);
         }
-        pm = new GlyphPixmap;
-        pm->pm = QPixmap::fromImage(img, Qt::NoFormatConversion);
-        pm->pm.setDevicePixelRatio(worldScale);
-        pm->offset = QPointF(qreal(gb->left), -qreal(gb->top)) / worldScale;
-        if (!cache->insert(gk, pm)) {
-            qDebug("cannot cache glyph");
-        }
-        FT_Done_Glyph(glyph);
     }
-    painter->drawPixmap(pos + pm->offset, pm->pm);
+    painter->drawPixmap(pos + gp.offset, gp.pm);
 }
 
 void ScoreFont::draw(SymId id, QPainter* painter, qreal mag, const QPointF& pos, int n) const
@@ -6227,6 +6348,9 @@ void ScoreFont::draw(SymId id, QPainter* painter, qreal mag, const QPointF& pos,
 
 void ScoreFont::draw(const std::vector<SymId>& ids, QPainter* p, qreal mag, const QPointF& _pos, qreal scale) const
 {
+    if (MScore::pdfPrinting && MScore::printGlyphRuns && drawGlyphRun(ids, p, QSizeF(mag, mag), _pos)) {
+        return;
+    }
     QPointF pos(_pos);
     for (SymId id : ids) {
         draw(id, p, mag, pos, scale);
@@ -6243,6 +6367,9 @@ void ScoreFont::draw(const std::vector<SymId>& ids, QPainter* p, const QSizeF& m
 void ScoreFont::draw(const std::vector<SymId>& ids, QPainter* p, const QSizeF& mag, const QPointF& _pos,
                      qreal scale) const
 {
+    if (MScore::pdfPrinting && MScore::printGlyphRuns && drawGlyphRun(ids, p, mag, _pos)) {
+        return;
+    }
     QPointF pos(_pos);
     for (SymId id : ids) {
         draw(id, p, mag, pos, scale);
@@ -6692,6 +6819,7 @@ ScoreFont* ScoreFont::fontFactory(QString s)
         return fallbackFont();
     }
 
+    QMutexLocker locker(&loadMutex);
     if (!f->face) {
         f->load();
     }
@@ -6705,6 +6833,7 @@ ScoreFont* ScoreFont::fontFactory(QString s)
 ScoreFont* ScoreFont::fallbackFont()
 {
     ScoreFont* f = &_scoreFonts[FALLBACK_FONT];
+    QMutexLocker locker(&loadMutex);
     if (!f->face) {
         f->load();
     }
@@ -14,6 +14,7 @@
 #define __SYM_H__
 
 #include <QApplication>
+#include <QRawFont>
 
 #include "config.h"
 #include "style.h"
@@ -2993,11 +2994,14 @@ class ScoreFont
     std::list<std::pair<Sid, QVariant> > _engravingDefaults;
     double _textEnclosureThickness = 0;
     mutable QFont* font { 0 };
+    mutable QHash<QPair<int, int>, QRawFont> rawFonts;   // by point size and device dpi
 
     static QVector<ScoreFont> _scoreFonts;
     static std::array<uint, size_t(SymId::lastSym) + 1> _mainSymCodeTable;
     void load();
     void computeMetrics(Sym* sym, int code);
+    bool printFont(QFont& f) const;
+    bool drawGlyphRun(const std::vector<SymId>&, QPainter*, const QSizeF& mag, const QPointF& pos) const;
 
 public:
     ScoreFont() {}
@@ -17,6 +17,10 @@
 #include "libmscore/score.h"
 #include "libmscore/measure.h"
 #include "libmscore/chordrest.h"
+#include "libmscore/chord.h"
+#include "libmscore/beam.h"
+#include "libmscore/note.h"
+#include "libmscore/stem.h"
 
 static const QString BEAM_DATA_DIR("beam_data/");
 
@@ -49,6 +53,8 @@ private slots:
     void beamCrossMeasure2() { beam("Beam-CrossM2.mscx"); }
     void beamCrossMeasure3() { beam("Beam-CrossM3.mscx"); }
     void beamCrossMeasure4() { beam("Beam-CrossM4.mscx"); }
+    void beamRelayout_data();
+    void beamRelayout();
 };
 
 //---------------------------------------------------------
@@ -72,6 +78,131 @@ void TestBeam::beam(const char* path)
     delete score;
 }
 
+//---------------------------------------------------------
+//   beamGeometry
+//    stem lengths and beam bounding boxes of all chords
+//---------------------------------------------------------
+
+static QList<qreal> beamGeometry(Score* score)
+{
+    QList<qreal> geometry;
+    for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+        for (Element* e : s->elist()) {
+            if (!e || !e->isChord()) {
+                continue;
+            }
+            Chord* c = toChord(e);
+            if (!c->beam()) {
+                continue;
+            }
+            QRectF r = c->beam()->bbox();
+            geometry << r.x() << r.y() << r.width() << r.height();
+            geometry << (c->stem() ? c->stem()->len() : 0.0);
+        }
+    }
+    return geometry;
+}
+
+//---------------------------------------------------------
+//   beamedChords
+//---------------------------------------------------------
+
+static std::vector<Chord*> beamedChords(Score* score)
+{
+    std::vector<Chord*> chords;
+    for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+        for (Element* e : s->elist()) {
+            if (e && e->isChord() && toChord(e)->beam()) {
+                chords.push_back(toChord(e));
+            }
+        }
+    }
+    return chords;
+}
+
+//---------------------------------------------------------
+//   sameGeometry
+//    beam positions are saved rounded
+//---------------------------------------------------------
+
+static bool sameGeometry(const QList<qreal>& g1, const QList<qreal>& g2)
+{
+    if (g1.size() != g2.size()) {
+        return false;
+    }
+    for (int i = 0; i < g1.size(); ++i) {
+        if (qAbs(g1[i] - g2[i]) > 0.01) {
+            qDebug("beam geometry differs at %d: %f %f", i, g1[i], g2[i]);
+            return false;
+        }
+    }
+    return true;
+}
+
+//---------------------------------------------------------
+//   beamRelayout
+//    laying out an unchanged score again reuses the stored
+//    beam geometry, the result has to be identical; after
+//    edits which change the stored keys, the layout has to
+//    be the one of the edited score loaded afresh
+//---------------------------------------------------------
+
+void TestBeam::beamRelayout_data()
+{
+    QTest::addColumn<QString>("path");
+    for (const char* path : { "Beam-A.mscx", "Beam-B.mscx", "Beam-C.mscx", "Beam-D.mscx", "Beam-E.mscx",
+                              "Beam-F.mscx", "Beam-G.mscx", "Beam-2.mscx", "Beam-23.mscx", "Beam-S0.mscx",
+                              "Beam-dir.mscx" }) {
+        QTest::newRow(path) << QString(path);
+    }
+}
+
+void TestBeam::beamRelayout()
+{
+    QFETCH(QString, path);
+    MasterScore* score = readScore(BEAM_DATA_DIR + path);
+    QVERIFY(score);
+    score->doLayout();
+    QList<qreal> first = beamGeometry(score);
+    QVERIFY(!first.empty());
+
+    score->doLayout();
+    QCOMPARE(beamGeometry(score), first);
+
+    std::vector<Chord*> chords = beamedChords(score);
+    QVERIFY(!chords.empty());
+
+    // a pitch, by an octave to keep the spelling
+    Note* note = chords.front()->upNote();
+    score->startCmd();
+    note->undoChangeProperty(Pid::PITCH, note->pitch() + (note->pitch() < 72 ? 12 : -12));
+    score->endCmd();
+
+    // a stem direction
+    Chord* chord = chords.back();
+    score->startCmd();
+    chord->undoChangeProperty(Pid::STEM_DIRECTION, QVariant::fromValue<Direction>(chord->up() ? Direction::DOWN : Direction::UP));
+    score->endCmd();
+
+    // flat beams, which changes Beam::hasNoSlope()
+    score->startCmd();
+    score->undoChangeStyleVal(Sid::beamNoSlope, !score->styleB(Sid::beamNoSlope));
+    score->endCmd();
+
+    score->doLayout();
+    QList<qreal> edited = beamGeometry(score);
+
+    const QString saveName = "beamRelayout-" + path;
+    QVERIFY(saveScore(score, saveName));
+    MasterScore* fresh = readCreatedScore(saveName);
+    QVERIFY(fresh);
+    fresh->doLayout();
+    QVERIFY(sameGeometry(edited, beamGeometry(fresh)));
+
+    delete fresh;
+    delete score;
+}
+
 //---------------------------------------------------------
 //   beamCrossMeasure1
 //   This method simulates following operations:
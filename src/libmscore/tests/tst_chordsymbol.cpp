@@ -22,8 +22,10 @@
 #include "libmscore/segment.h"
 #include "libmscore/chordrest.h"
 #include "libmscore/harmony.h"
+#include "libmscore/chordlist.h"
 #include "libmscore/duration.h"
 #include "libmscore/durationtype.h"
+#include "libmscore/staff.h"
 
 static const QString CHORDSYMBOL_DATA_DIR("chordsymbol_data/");
 
@@ -63,6 +65,8 @@ private slots:
     void testRealizeTriplet();
     void testRealizeDuration();
     void testRealizeJazz();
+    void testParsedChordCache();
+    void testConcertPitchStaves();
 };
 
 //---------------------------------------------------------
@@ -412,5 +416,88 @@ void TestChordSymbol::testRealizeJazz()
     test_post(score, "realize-jazz");
 }
 
+//---------------------------------------------------------
+//   testParsedChordCache
+///   Chord symbols with the same name share one parsed
+///   chord until the chord list is reloaded
+//---------------------------------------------------------
+void TestChordSymbol::testParsedChordCache()
+{
+    MasterScore* score = test_pre("realize");
+    ChordList* cl = score->style().chordList();
+
+    Harmony* h1 = new Harmony(score);
+    h1->setHarmony("Cmaj7");
+    Harmony* h2 = new Harmony(score);
+    h2->setHarmony("Cmaj7");
+    Harmony* h3 = new Harmony(score);
+    h3->setHarmony("G7");
+
+    QVERIFY(h1->parsedForm() == h2->parsedForm());
+    QVERIFY(h1->parsedForm() != h3->parsedForm());
+    QCOMPARE(h1->parsedForm()->quality(), QString("major"));
+    QVERIFY(!h1->parsedForm()->renderList().empty());
+
+    Harmony* h4 = h1->clone();
+    QVERIFY(h4->parsedForm() == h1->parsedForm());
+
+    std::shared_ptr<const ParsedChord> before = cl->parsedChord("maj7");
+    QVERIFY(before.get() == h1->parsedForm());
+    cl->unload();
+    score->style().checkChordList();
+    QVERIFY(cl->parsedChord("maj7") != before);
+
+    delete h1;
+    delete h2;
+    delete h3;
+    delete h4;
+    delete score;
+}
+
+//---------------------------------------------------------
+//   testConcertPitchStaves
+///   Toggle concert pitch on a score with the same chord
+///   symbols on a flute and on clarinet, alto sax and horn
+///   staves. In concert pitch every staff shows the chords
+///   and the key of the flute; toggling back gives the
+///   score as it was read.
+//---------------------------------------------------------
+void TestChordSymbol::testConcertPitchStaves()
+{
+    MasterScore* score = test_pre("concert-pitch-staves");
+    QVERIFY(saveScore(score, "concert-pitch-staves-before.mscx"));
+
+    score->startCmd();
+    score->cmdConcertPitchChanged(true);
+    score->endCmd();
+
+    int harmonies = 0;
+    for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+        Harmony* reference = toHarmony(s->findAnnotation(ElementType::HARMONY, 0, VOICES - 1));
+        QVERIFY(reference);
+        for (int staffIdx = 1; staffIdx < score->nstaves(); ++staffIdx) {
+            int strack = staffIdx * VOICES;
+            Harmony* h = toHarmony(s->findAnnotation(ElementType::HARMONY, strack, strack + VOICES - 1));
+            QVERIFY(h);
+            QCOMPARE(h->rootTpc(), reference->rootTpc());
+            QCOMPARE(h->baseTpc(), reference->baseTpc());
+            QCOMPARE(h->harmonyName(), reference->harmonyName());
+            ++harmonies;
+        }
+    }
+    QCOMPARE(harmonies, 8 * 3);
+    for (Staff* staff : score->staves()) {
+        QCOMPARE(int(staff->key(Fraction(0, 1))), int(Key::D));
+    }
+
+    score->startCmd();
+    score->cmdConcertPitchChanged(false);
+    score->endCmd();
+
+    QVERIFY(saveScore(score, "concert-pitch-staves-after.mscx"));
+    QVERIFY(compareFilesFromPaths("concert-pitch-staves-after.mscx", "concert-pitch-staves-before.mscx"));
+    delete score;
+}
+
 QTEST_MAIN(TestChordSymbol)
 #include "tst_chordsymbol.moc"
@@ -29,6 +29,8 @@ class TestConcertPitchBenchmark : public QObject, public MTest
 private slots:
     void initTestCase();
     void benchmark();
+    void benchmarkToggle();         // concert pitch toggle without layout
+    void benchmarkSpell();          // respell all notes
 };
 
 //---------------------------------------------------------
@@ -58,5 +60,33 @@ void TestConcertPitchBenchmark::benchmark()
     }
 }
 
+//---------------------------------------------------------
+//   benchmarkToggle
+//    transposition of keys and chord symbols only
+//---------------------------------------------------------
+
+void TestConcertPitchBenchmark::benchmarkToggle()
+{
+    Score* score = readScore(CONCERTPITCH_DATA_DIR + "concertpitchbenchmark.mscx");
+    QBENCHMARK {
+        score->cmdConcertPitchChanged(true);
+        score->cmdConcertPitchChanged(false);
+    }
+    delete score;
+}
+
+//---------------------------------------------------------
+//   benchmarkSpell
+//---------------------------------------------------------
+
+void TestConcertPitchBenchmark::benchmarkSpell()
+{
+    Score* score = readScore(CONCERTPITCH_DATA_DIR + "concertpitchbenchmark.mscx");
+    QBENCHMARK {
+        score->spell();
+    }
+    delete score;
+}
+
 QTEST_MAIN(TestConcertPitchBenchmark)
 #include "tst_concertpitchbenchmark.moc"
@@ -10,9 +10,27 @@
 //  the file LICENCE.GPL
 //=============================================================================
 
+#include <QBuffer>
+#include <QCryptographicHash>
+#include <QPainter>
+#include <QPdfWriter>
+#include <QRandomGenerator>
+#include <QTemporaryDir>
+
+#if defined(Q_OS_UNIX)
+#include <sys/resource.h>
+#endif
+
 #include "testing/qtestsuite.h"
 #include "testbase.h"
+#include "libmscore/chord.h"
+#include "libmscore/lyrics.h"
+#include "libmscore/measure.h"
+#include "libmscore/note.h"
 #include "libmscore/score.h"
+#include "libmscore/scoresnapshot.h"
+#include "libmscore/segment.h"
+#include "thirdparty/qzip/qzipwriter_p.h"
 
 static const QString LAYOUT_DATA_DIR("layout_data/");
 
@@ -39,6 +57,15 @@ private slots:
     void benchmark1();
     void benchmark2();
     void benchmark4();              // incremental layout (one page)
+    void benchmark5();              // load image-heavy .mscz
+    void benchmark6();              // save .mscz
+    void benchmark7();              // save .mscz, main thread part only
+    void benchmark8();              // snapshot of the whole score
+    void benchmark9();              // snapshot after a one note edit
+    void benchmark10();             // pdf export, symbols as text
+    void benchmark11();             // pdf export, symbols as glyph runs
+    void benchmark12();             // layout of a lyrics-heavy score
+    void benchmark13();             // minimum widths of all measures
 };
 
 //---------------------------------------------------------
@@ -48,6 +75,12 @@ private slots:
 void TestLayoutBenchmark::initTestCase()
 {
     initMTest();
+    MScore::testMode = true;
+
+    // the score all benchmarks work on
+    score = new MasterScore(mscore->baseStyle());
+    QCOMPARE(score->loadMsc(root + "/" + LAYOUT_DATA_DIR + "goldberg.mscz", false), Score::FileError::FILE_NO_ERROR);
+    QVERIFY(score->firstMeasure());
 }
 
 //---------------------------------------------------------
@@ -56,18 +89,17 @@ void TestLayoutBenchmark::initTestCase()
 
 void TestLayoutBenchmark::benchmark3()
 {
-    QString path = root + "/" + LAYOUT_DATA_DIR + "goldberg.mscx";
-    score = new MasterScore(mscore->baseStyle());
-    score->setName(path);
-    MScore::testMode = true;
+    QString path = root + "/" + LAYOUT_DATA_DIR + "goldberg.mscz";
     QBENCHMARK {
-        score->loadMsc(path, false);
+        MasterScore* s = new MasterScore(mscore->baseStyle());
+        QCOMPARE(s->loadMsc(path, false), Score::FileError::FILE_NO_ERROR);
+        QVERIFY(s->firstMeasure());
+        delete s;
     }
 }
 
 void TestLayoutBenchmark::benchmark1()
 {
-    // score = readScore(LAYOUT_DATA_DIR + "goldberg.mscx");
     QBENCHMARK {                          // cold run
         score->doLayout();
     }
@@ -90,5 +122,248 @@ void TestLayoutBenchmark::benchmark4()
     }
 }
 
+//---------------------------------------------------------
+//   benchmark5
+//    load a .mscz that contains many large pictures
+//---------------------------------------------------------
+
+void TestLayoutBenchmark::benchmark5()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+    QString path = dir.filePath("images.mscz");
+
+    QFile mscx(root + "/test.mscx");
+    QVERIFY(mscx.open(QIODevice::ReadOnly));
+
+    const int images = 100;
+    const int imageSize = 512 * 1024;
+    {
+        MQZipWriter uz(path);
+        QString container = "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                            "<container><rootfiles><rootfile full-path=\"images.mscx\"/>";
+        QList<QPair<QString, QByteArray> > pictures;
+        for (int i = 0; i < images; ++i) {
+            // random data, so the pictures do not shrink when they are deflated
+            QByteArray data(imageSize, 0);
+            QRandomGenerator generator(i + 1);
+            generator.fillRange(reinterpret_cast<quint32*>(data.data()), imageSize / sizeof(quint32));
+            QCryptographicHash h(QCryptographicHash::Md4);
+            h.addData(data);
+            QString name = QString("Pictures/%1.png").arg(QString(h.result().toHex()));
+            container += QString("<file>%1</file>").arg(name);
+            pictures.append({ name, data });
+        }
+        container += "</rootfiles></container>\n";
+        uz.addFile("META-INF/container.xml", container.toUtf8());
+        uz.addFile("images.mscx", mscx.readAll());
+        for (const auto& p : pictures) {
+            uz.addFile(p.first, p.second);
+        }
+        uz.close();
+    }
+
+    QBENCHMARK {
+        MasterScore* s = new MasterScore(mscore->baseStyle());
+        QCOMPARE(s->loadMsc(path, false), Score::FileError::FILE_NO_ERROR);
+        delete s;
+    }
+
+#if defined(Q_OS_UNIX)
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) == 0) {
+        qDebug("peak RSS: %ld", long(usage.ru_maxrss));
+    }
+#endif
+}
+
+//---------------------------------------------------------
+//   benchmark6
+//---------------------------------------------------------
+
+void TestLayoutBenchmark::benchmark6()
+{
+    QBENCHMARK {
+        QBuffer buffer;
+        buffer.open(QIODevice::WriteOnly);
+        score->saveCompressedFile(&buffer, "goldberg.mscx", false, true);
+    }
+}
+
+//---------------------------------------------------------
+//   benchmark7
+//    the part of a save that blocks the score, writing
+//    can be done on a worker thread
+//---------------------------------------------------------
+
+void TestLayoutBenchmark::benchmark7()
+{
+    QBENCHMARK {
+        CompressedSaveData data = score->prepareCompressedSave("goldberg.mscx", false, true);
+        Q_UNUSED(data);
+    }
+}
+
+//---------------------------------------------------------
+//   benchmark8
+//---------------------------------------------------------
+
+void TestLayoutBenchmark::benchmark8()
+{
+    std::shared_ptr<const ScoreSnapshot> snapshot;
+    QBENCHMARK {
+        snapshot = ScoreSnapshot::take(score, nullptr, true);
+    }
+    qDebug("snapshot: %d measures, %zu bytes", int(snapshot->measures().size()), snapshot->memoryUsage());
+}
+
+//---------------------------------------------------------
+//   benchmark9
+//    the snapshot taken after an edit shares all other
+//    measures with the previous one
+//---------------------------------------------------------
+
+void TestLayoutBenchmark::benchmark9()
+{
+    QVERIFY(score->firstMeasure());
+    std::shared_ptr<const ScoreSnapshot> first = ScoreSnapshot::take(score, nullptr, true);
+
+    Note* note = nullptr;
+    Segment* s = score->firstMeasure()->first(SegmentType::ChordRest);
+    for (; s && !note; s = s->next1(SegmentType::ChordRest)) {
+        for (int track = 0; track < score->ntracks() && !note; ++track) {
+            Element* e = s->element(track);
+            if (e && e->isChord()) {
+                Note* n = toChord(e)->upNote();
+                if (!n->tieFor() && !n->tieBack()) {
+                    note = n;
+                }
+            }
+        }
+    }
+    QVERIFY(note);
+
+    score->startCmd();
+    note->undoChangeProperty(Pid::PITCH, note->pitch() + 12);
+    score->endCmd();
+
+    std::shared_ptr<const ScoreSnapshot> second;
+    QBENCHMARK {
+        second = ScoreSnapshot::take(score, first, true);
+    }
+    QCOMPARE(second->sharedMeasures(*first), int(first->measures().size()) - 1);
+    qDebug("snapshot after edit: %zu bytes not shared with the previous one, %zu bytes in total",
+           second->memoryUsageNotSharedWith(*first), second->memoryUsage());
+
+    score->undoRedo(true, 0);
+}
+
+//---------------------------------------------------------
+//   printPdf
+//    the pdf export at 300 dpi, returns the file data
+//---------------------------------------------------------
+
+static QByteArray printPdf(Score* score)
+{
+    QByteArray data;
+    QBuffer buffer(&data);
+    buffer.open(QIODevice::WriteOnly);
+
+    QPdfWriter pdfWriter(&buffer);
+    pdfWriter.setResolution(300);
+    pdfWriter.setPageMargins(QMarginsF());
+    if (!score->printPdf(pdfWriter)) {
+        return QByteArray();
+    }
+    return data;
+}
+
+//---------------------------------------------------------
+//   benchmark10
+//    pdf export with the symbols drawn as text,
+//    the way it was done before glyph runs
+//---------------------------------------------------------
+
+void TestLayoutBenchmark::benchmark10()
+{
+    MScore::printGlyphRuns = false;
+    QByteArray data;
+    QBENCHMARK {
+        data = printPdf(score);
+    }
+    MScore::printGlyphRuns = true;
+
+    QVERIFY(!data.isEmpty());
+    qDebug("pdf, symbols as text: %d pages, %d bytes", score->npages(), data.size());
+}
+
+//---------------------------------------------------------
+//   benchmark11
+//    pdf export with the symbols drawn as glyph runs
+//---------------------------------------------------------
+
+void TestLayoutBenchmark::benchmark11()
+{
+    QByteArray data;
+    QBENCHMARK {
+        data = printPdf(score);
+    }
+
+    QVERIFY(!data.isEmpty());
+    qDebug("pdf, symbols as glyph runs: %d pages, %d bytes", score->npages(), data.size());
+}
+
+//---------------------------------------------------------
+//   benchmark12
+//    lay out a choral score with four verses of lyrics,
+//    hyphens and melismas on every chord of both staves
+//---------------------------------------------------------
+
+void TestLayoutBenchmark::benchmark12()
+{
+    MasterScore* s = new MasterScore(mscore->baseStyle());
+    QCOMPARE(s->loadMsc(root + "/" + LAYOUT_DATA_DIR + "lyrics.mscx", false), Score::FileError::FILE_NO_ERROR);
+    QVERIFY(s->firstMeasure());
+
+    int n = 0;
+    for (Segment* seg = s->firstSegment(SegmentType::ChordRest); seg; seg = seg->next1(SegmentType::ChordRest)) {
+        for (int track = 0; track < s->ntracks(); ++track) {
+            ChordRest* cr = seg->cr(track);
+            if (cr) {
+                n += int(cr->lyrics().size());
+            }
+        }
+    }
+    QVERIFY(n > 3000);
+    qDebug("%d lyrics", n);
+
+    QBENCHMARK {
+        s->doLayout();
+    }
+
+    delete s;
+}
+
+//---------------------------------------------------------
+//   benchmark13
+//    compute the minimum width of every measure, the
+//    segment shapes are left as the last layout made them
+//---------------------------------------------------------
+
+void TestLayoutBenchmark::benchmark13()
+{
+    int n = 0;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        ++n;
+    }
+    qDebug("%d measures", n);
+
+    QBENCHMARK {
+        for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+            m->computeMinWidth();
+        }
+    }
+}
+
 QTEST_MAIN(TestLayoutBenchmark)
 #include "tst_layout_benchmark.moc"
@@ -0,0 +1,210 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include "testing/qtestsuite.h"
+
+#include <map>
+#include <set>
+#include <tuple>
+
+#include "testbase.h"
+
+#include "libmscore/chordrest.h"
+#include "libmscore/layout.h"
+#include "libmscore/lyrics.h"
+#include "libmscore/measure.h"
+#include "libmscore/score.h"
+#include "libmscore/segment.h"
+#include "libmscore/system.h"
+
+static const QString LYRICS_DATA_DIR("lyrics_data/");
+
+using namespace Ms;
+
+Q_DECLARE_METATYPE(Ms::VerticalAlignRange)
+
+//---------------------------------------------------------
+//   TestLyrics
+//---------------------------------------------------------
+
+class TestLyrics : public QObject, public MTest
+{
+    Q_OBJECT
+
+    MasterScore* score { nullptr };
+
+    int distinctBelowY(VerticalAlignRange range);
+
+private slots:
+    void initTestCase();
+    void cleanupTestCase();
+    void verticalAlign_data();
+    void verticalAlign();
+    void verticalAlignRanges();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//    lyricsAlign.mscx: the soprano has verses 1 and 2
+//    above the staff and 3 to 5 below it, the bass has
+//    3 verses below; the notes go from far below to far
+//    above the staff, so that the lyrics are moved by
+//    different amounts
+//---------------------------------------------------------
+
+void TestLyrics::initTestCase()
+{
+    initMTest();
+    score = readScore(LYRICS_DATA_DIR + "lyricsAlign.mscx");
+    QVERIFY(score);
+}
+
+void TestLyrics::cleanupTestCase()
+{
+    delete score;
+}
+
+//---------------------------------------------------------
+//   lyricsY
+//    the lyrics of a staff by verse and position, with
+//    their page position
+//---------------------------------------------------------
+
+struct LyricsY {
+    System* system;
+    Measure* measure;
+    Segment* segment;
+    int staffIdx;
+    int no;
+    bool above;
+    qreal y;
+};
+
+static std::vector<LyricsY> lyricsY(Score* score)
+{
+    std::vector<LyricsY> all;
+    for (Segment* s = score->firstSegment(SegmentType::ChordRest); s; s = s->next1(SegmentType::ChordRest)) {
+        for (Element* e : s->elist()) {
+            if (!e) {
+                continue;
+            }
+            for (Lyrics* l : toChordRest(e)->lyrics()) {
+                all.push_back({ s->measure()->system(), s->measure(), s, e->staffIdx(), l->no(), l->placeAbove(),
+                                l->pagePos().y() });
+            }
+        }
+    }
+    return all;
+}
+
+//---------------------------------------------------------
+//   verticalAlign
+//    all lyrics of a verse in the same range of a staff
+//    are on the same line, and the verses keep their order
+//---------------------------------------------------------
+
+void TestLyrics::verticalAlign_data()
+{
+    QTest::addColumn<VerticalAlignRange>("range");
+
+    QTest::newRow("segment") << VerticalAlignRange::SEGMENT;
+    QTest::newRow("measure") << VerticalAlignRange::MEASURE;
+    QTest::newRow("system") << VerticalAlignRange::SYSTEM;
+}
+
+void TestLyrics::verticalAlign()
+{
+    QFETCH(VerticalAlignRange, range);
+
+    score->setStyleValue(Sid::autoplaceVerticalAlignRange, int(range));
+    score->doLayout();
+
+    const std::vector<LyricsY> all = lyricsY(score);
+    QCOMPARE(int(all.size()), 24 * 4 * (5 + 3));
+    QVERIFY(score->systems().size() > 1);
+
+    // below the staff: one line per verse and measure, segment or system;
+    // above the staff only the system range aligns the lyrics
+    std::map<std::tuple<void*, int, int, bool>, qreal> lines;
+    for (const LyricsY& l : all) {
+        if (l.above && range != VerticalAlignRange::SYSTEM) {
+            continue;
+        }
+        void* key = range == VerticalAlignRange::SEGMENT ? static_cast<void*>(l.segment)
+                    : range == VerticalAlignRange::MEASURE ? static_cast<void*>(l.measure)
+                    : static_cast<void*>(l.system);
+        auto i = lines.emplace(std::make_tuple(key, l.staffIdx, l.no, l.above), l.y).first;
+        QVERIFY2(qAbs(i->second - l.y) < 0.01,
+                 qPrintable(QString("staff %1 verse %2 at %3").arg(l.staffIdx).arg(l.no + 1).arg(l.segment->tick().ticks())));
+    }
+
+    // in each chord, verse n + 1 is below verse n
+    for (size_t i = 1; i < all.size(); ++i) {
+        const LyricsY& a = all[i - 1];
+        const LyricsY& b = all[i];
+        if (a.segment == b.segment && a.staffIdx == b.staffIdx && b.no == a.no + 1) {
+            QVERIFY(b.y > a.y);
+        }
+    }
+}
+
+//---------------------------------------------------------
+//   distinctBelowY
+//    number of lines of the first verse below the staff,
+//    counted per system and staff
+//---------------------------------------------------------
+
+int TestLyrics::distinctBelowY(VerticalAlignRange range)
+{
+    score->setStyleValue(Sid::autoplaceVerticalAlignRange, int(range));
+    score->doLayout();
+
+    std::set<std::tuple<System*, int, int> > lines;
+    for (const LyricsY& l : lyricsY(score)) {
+        int firstBelow = l.staffIdx == 0 ? 2 : 0;
+        if (l.no == firstBelow) {
+            lines.insert(std::make_tuple(l.system, l.staffIdx, qRound(l.y * 100.0)));
+        }
+    }
+    return int(lines.size());
+}
+
+//---------------------------------------------------------
+//   verticalAlignRanges
+//    the wider the range, the fewer lines the lyrics
+//    need; one line per system and staff for SYSTEM
+//---------------------------------------------------------
+
+void TestLyrics::verticalAlignRanges()
+{
+    int bySegment = distinctBelowY(VerticalAlignRange::SEGMENT);
+    int byMeasure = distinctBelowY(VerticalAlignRange::MEASURE);
+    int bySystem = distinctBelowY(VerticalAlignRange::SYSTEM);
+
+    QCOMPARE(bySystem, int(score->systems().size()) * score->nstaves());
+    QVERIFY(byMeasure > bySystem);
+    QVERIFY(bySegment > byMeasure);
+
+    score->setStyleValue(Sid::autoplaceVerticalAlignRange, int(VerticalAlignRange::SYSTEM));
+    score->doLayout();
+}
+
+QTEST_MAIN(TestLyrics)
+
+#include "tst_lyrics.moc"
@@ -64,6 +64,10 @@ private slots:
 
     void gap();
     void checkMeasure();
+
+    void contentHashSaveLoad();
+    void contentHashJournal();
+    void contentJournalWithoutLayout();
 };
 
 //---------------------------------------------------------
@@ -603,6 +607,111 @@ void TestMeasure::measureNumbers()
     delete score;
 }
 
+//---------------------------------------------------------
+///   contentHashSaveLoad
+///   content hashes do not change when the score is saved and loaded again
+//---------------------------------------------------------
+
+void TestMeasure::contentHashSaveLoad()
+{
+    MasterScore* score = readScore(MEASURE_DATA_DIR + "measure-1.mscx");
+    QVERIFY(saveScore(score, "measure-hash.mscx"));
+    MasterScore* loaded = readCreatedScore("measure-hash.mscx");
+    QVERIFY(loaded);
+
+    QCOMPARE(loaded->nstaves(), score->nstaves());
+    QCOMPARE(loaded->nmeasures(), score->nmeasures());
+
+    Measure* m2 = loaded->firstMeasure();
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure(), m2 = m2->nextMeasure()) {
+        for (int staffIdx = 0; staffIdx < score->nstaves(); ++staffIdx) {
+            QCOMPARE(m2->contentHash(staffIdx), m->contentHash(staffIdx));
+        }
+    }
+
+    delete loaded;
+    delete score;
+}
+
+//---------------------------------------------------------
+///   contentHashJournal
+///   a command changes the hash of the measure it edits only
+///   and records its range in the content journal
+//---------------------------------------------------------
+
+void TestMeasure::contentHashJournal()
+{
+    MasterScore* score = readScore(MEASURE_DATA_DIR + "measure-1.mscx");
+
+    std::vector<uint> hashes;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure()) {
+        hashes.push_back(m->contentHash());
+    }
+    const int revision = score->contentRevision();
+
+    Measure* edited = score->firstMeasure()->nextMeasure();
+    Chord* chord = edited->findChord(edited->tick(), 0);
+    QVERIFY(chord);
+    score->startCmd();
+    chord->upNote()->undoChangeProperty(Pid::PITCH, chord->upNote()->pitch() + 12);
+    score->endCmd();
+
+    std::vector<ContentChange> changes;
+    QVERIFY(score->contentChangesSince(revision, changes));
+    QVERIFY(!changes.empty());
+    QVERIFY(changes.front().startTick <= edited->tick());
+    QVERIFY(changes.front().endTick >= edited->tick());
+
+    size_t i = 0;
+    for (Measure* m = score->firstMeasure(); m; m = m->nextMeasure(), ++i) {
+        if (m == edited) {
+            QVERIFY(m->contentHash() != hashes[i]);
+        } else {
+            QCOMPARE(m->contentHash(), hashes[i]);
+        }
+    }
+
+    score->undoRedo(true, 0);
+    QCOMPARE(edited->contentHash(), hashes[1]);
+    QVERIFY(score->contentRevision() > revision + 1);
+
+    delete score;
+}
+
+//---------------------------------------------------------
+///   contentJournalWithoutLayout
+///   a command and its undo which do not ask for a layout
+///   are recorded for the whole score
+//---------------------------------------------------------
+
+void TestMeasure::contentJournalWithoutLayout()
+{
+    MasterScore* score = readScore(MEASURE_DATA_DIR + "measure-1.mscx");
+    const int revision = score->contentRevision();
+
+    score->startCmd();
+    score->undo(new ChangeMetaText(score, "composer", "changed"));
+    QVERIFY(!score->cmdState().layoutRange());
+    score->endCmd();
+
+    std::vector<ContentChange> changes;
+    QVERIFY(score->contentChangesSince(revision, changes));
+    QCOMPARE(int(changes.size()), 1);
+    QCOMPARE(changes.front().startTick, Fraction(0, 1));
+    QCOMPARE(changes.front().endTick, score->lastMeasure()->endTick());
+    QCOMPARE(changes.front().startStaff, -1);
+
+    score->undoRedo(true, 0);
+    QCOMPARE(score->contentRevision(), revision + 2);
+
+    // a command without changes is not recorded
+    score->startCmd();
+    score->endCmd();
+    QCOMPARE(score->contentRevision(), revision + 2);
+
+    delete score;
+}
+
 QTEST_MAIN(TestMeasure)
 
 #include "tst_measure.moc"
@@ -0,0 +1,136 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include "testing/qtestsuite.h"
+
+#include "testbase.h"
+
+#include "libmscore/chord.h"
+#include "libmscore/measure.h"
+#include "libmscore/note.h"
+#include "libmscore/score.h"
+#include "libmscore/scorediff.h"
+
+static const QString MEASURE_DATA_DIR("measure_data/");
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestScoreDiff
+//---------------------------------------------------------
+
+class TestScoreDiff : public QObject, public MTest
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void structuralEqual();
+    void structuralProperty();
+    void structuralInsertMeasure();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestScoreDiff::initTestCase()
+{
+    initMTest();
+}
+
+//---------------------------------------------------------
+//   structuralEqual
+//---------------------------------------------------------
+
+void TestScoreDiff::structuralEqual()
+{
+    MasterScore* s1 = readScore(MEASURE_DATA_DIR + "measure-1.mscx");
+    MasterScore* s2 = readScore(MEASURE_DATA_DIR + "measure-1.mscx");
+
+    ScoreDiff diff(s1, s2, DiffEngine::STRUCTURAL);
+    QVERIFY(diff.equal());
+    QVERIFY(diff.textDiffs().empty());
+
+    delete s1;
+    delete s2;
+}
+
+//---------------------------------------------------------
+//   structuralProperty
+//    a changed note is reported as a property change of
+//    that note only
+//---------------------------------------------------------
+
+void TestScoreDiff::structuralProperty()
+{
+    MasterScore* s1 = readScore(MEASURE_DATA_DIR + "measure-1.mscx");
+    MasterScore* s2 = readScore(MEASURE_DATA_DIR + "measure-1.mscx");
+
+    Chord* chord = s2->firstMeasure()->findChord(Fraction(0, 1), 0);
+    QVERIFY(chord);
+    Note* note = chord->upNote();
+    s2->startCmd();
+    note->undoChangeProperty(Pid::PITCH, note->pitch() + 12);
+    s2->endCmd();
+
+    ScoreDiff diff(s1, s2, DiffEngine::STRUCTURAL);
+    QVERIFY(!diff.equal());
+    QCOMPARE(int(diff.diffs().size()), 1);
+
+    const BaseDiff* d = diff.diffs().front();
+    QCOMPARE(d->itemType(), ItemType::PROPERTY);
+    QCOMPARE(static_cast<const PropertyDiff*>(d)->pid, Pid::PITCH);
+    QVERIFY(d->ctx[1] == note);
+
+    delete s1;
+    delete s2;
+}
+
+//---------------------------------------------------------
+//   structuralInsertMeasure
+//    an inserted measure does not make the following
+//    measures differ
+//---------------------------------------------------------
+
+void TestScoreDiff::structuralInsertMeasure()
+{
+    MasterScore* s1 = readScore(MEASURE_DATA_DIR + "measure-1.mscx");
+    MasterScore* s2 = readScore(MEASURE_DATA_DIR + "measure-1.mscx");
+
+    s2->startCmd();
+    Measure* m = s2->firstMeasure()->nextMeasure();
+    s2->insertMeasure(ElementType::MEASURE, m);
+    s2->endCmd();
+
+    ScoreDiff diff(s1, s2, DiffEngine::STRUCTURAL);
+    QCOMPARE(int(diff.diffs().size()), 1);
+
+    const BaseDiff* d = diff.diffs().front();
+    QCOMPARE(d->itemType(), ItemType::ELEMENT);
+    QCOMPARE(d->type, DiffType::INSERT);
+    QVERIFY(static_cast<const ElementDiff*>(d)->el[1] == s2->firstMeasure()->nextMeasure());
+
+    delete s1;
+    delete s2;
+}
+
+QTEST_MAIN(TestScoreDiff)
+
+#include "tst_scorediff.moc"
@@ -0,0 +1,156 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include "testing/qtestsuite.h"
+
+#include "testbase.h"
+
+#include "libmscore/chord.h"
+#include "libmscore/measure.h"
+#include "libmscore/note.h"
+#include "libmscore/score.h"
+#include "libmscore/scoresnapshot.h"
+
+static const QString MEASURE_DATA_DIR("measure_data/");
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestScoreSnapshot
+//---------------------------------------------------------
+
+class TestScoreSnapshot : public QObject, public MTest
+{
+    Q_OBJECT
+
+private slots:
+    void initTestCase();
+    void editSharesOtherMeasures();
+    void tempoChange();
+};
+
+//---------------------------------------------------------
+//   initTestCase
+//---------------------------------------------------------
+
+void TestScoreSnapshot::initTestCase()
+{
+    initMTest();
+}
+
+//---------------------------------------------------------
+//   editSharesOtherMeasures
+//    the snapshot taken at the end of a command shares all
+//    measures but the edited one and the maps with the
+//    previous snapshot, which keeps its content
+//---------------------------------------------------------
+
+void TestScoreSnapshot::editSharesOtherMeasures()
+{
+    MasterScore* score = readScore(MEASURE_DATA_DIR + "measure-1.mscx");
+    QVERIFY(score);
+    score->setSnapshotsEnabled(true, true);
+
+    std::shared_ptr<const ScoreSnapshot> first = score->snapshot();
+    QVERIFY(first);
+    QCOMPARE(int(first->measures().size()), score->nmeasures());
+    QCOMPARE(first->revision(), score->contentRevision());
+
+    Chord* chord = score->firstMeasure()->findChord(Fraction(0, 1), 0);
+    QVERIFY(chord);
+    Note* note = chord->upNote();
+    const QString oldPitch = QString("<pitch>%1</pitch>").arg(note->pitch());
+    const QString newPitch = QString("<pitch>%1</pitch>").arg(note->pitch() + 12);
+    const QByteArray firstStaff = first->measures().front().measure->staves[0];
+    QVERIFY(firstStaff.contains(oldPitch.toUtf8()));
+
+    score->startCmd();
+    note->undoChangeProperty(Pid::PITCH, note->pitch() + 12);
+    score->endCmd();
+
+    std::shared_ptr<const ScoreSnapshot> second = score->snapshot();
+    QVERIFY(second);
+    QVERIFY(second != first);
+    QCOMPARE(second->revision(), score->contentRevision());
+    QCOMPARE(second->measures().size(), first->measures().size());
+
+    // only the first measure is serialized again
+    QCOMPARE(second->sharedMeasures(*first), int(first->measures().size()) - 1);
+    QVERIFY(second->measures().front().measure != first->measures().front().measure);
+    for (size_t i = 1; i < second->measures().size(); ++i) {
+        QVERIFY(second->measures()[i].measure == first->measures()[i].measure);
+        QCOMPARE(second->measures()[i].tick, first->measures()[i].tick);
+    }
+    QVERIFY(second->sharesMaps(*first));
+    QVERIFY(second->memoryUsageNotSharedWith(*first) < second->memoryUsage());
+
+    // the new snapshot has the edit, the old one is unchanged
+    QVERIFY(second->measures().front().measure->staves[0].contains(newPitch.toUtf8()));
+    QCOMPARE(first->measures().front().measure->staves[0], firstStaff);
+
+    // nothing changed: no new snapshot
+    score->updateSnapshot();
+    QVERIFY(score->snapshot() == second);
+
+    delete score;
+}
+
+//---------------------------------------------------------
+//   tempoChange
+//    a snapshot without measures is retaken when the
+//    repeat list is unwound, a changed tempo map is copied
+//    and times are converted as by the score
+//---------------------------------------------------------
+
+void TestScoreSnapshot::tempoChange()
+{
+    MasterScore* score = readScore(MEASURE_DATA_DIR + "measure-1.mscx");
+    QVERIFY(score);
+    score->setSnapshotsEnabled(true);
+    std::shared_ptr<const ScoreSnapshot> first = score->snapshot();
+    QVERIFY(first);
+    QVERIFY(first->measures().empty());
+
+    const Fraction tick = score->firstMeasure()->nextMeasure()->tick();
+    score->setTempo(tick, 4.0);
+    score->updateSnapshot(true);
+
+    // not retaken before the score needs the repeats itself
+    QVERIFY(score->snapshot() == first);
+    score->repeatList();
+
+    std::shared_ptr<const ScoreSnapshot> second = score->snapshot();
+    QVERIFY(second != first);
+    QVERIFY(!second->sharesMaps(*first));
+    QVERIFY(second->measures().empty());
+    QCOMPARE(second->tempomap().tempo(tick.ticks()), 4.0);
+    QVERIFY(first->tempomap().tempo(tick.ticks()) != 4.0);
+
+    const int endTick = score->lastMeasure()->endTick().ticks();
+    for (int t = 0; t <= endTick; t += MScore::division / 2) {
+        QCOMPARE(second->utick2utime(t), score->utick2utime(t));
+        QCOMPARE(second->utime2utick(second->utick2utime(t)), score->utime2utick(score->utick2utime(t)));
+    }
+
+    delete score;
+}
+
+QTEST_MAIN(TestScoreSnapshot)
+
+#include "tst_scoresnapshot.moc"
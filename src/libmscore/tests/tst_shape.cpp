@@ -0,0 +1,118 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include "testing/qtestsuite.h"
+
+#include <QRandomGenerator>
+
+#include "libmscore/shape.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestShape
+//---------------------------------------------------------
+
+class TestShape : public QObject
+{
+    Q_OBJECT
+
+private slots:
+    void minHorizontalDistance_data();
+    void minHorizontalDistance();
+};
+
+//---------------------------------------------------------
+//   randomShape
+//    on a coarse grid, so that edges meet and lines lie
+//    on the same height; some rectangles are lines
+//---------------------------------------------------------
+
+static Shape randomShape(QRandomGenerator& rg, int n, qreal x0)
+{
+    Shape shape;
+    for (int i = 0; i < n; ++i) {
+        qreal x = x0 + rg.bounded(40);
+        qreal y = rg.bounded(-20, 20);
+        qreal w = rg.bounded(10) == 0 ? 0.0 : rg.bounded(1, 12);
+        qreal h = rg.bounded(10) == 0 ? 0.0 : rg.bounded(1, 8) * 0.5;
+        shape.add(QRectF(x, y, w, h));
+    }
+    return shape;
+}
+
+//---------------------------------------------------------
+//   bruteForceMinHorizontalDistance
+//    every pair of rectangles, as Shape did before the
+//    rectangles were sorted
+//---------------------------------------------------------
+
+static qreal bruteForceMinHorizontalDistance(const Shape& s1, const Shape& s2)
+{
+    qreal dist = -1000000.0;
+    for (const QRectF& r2 : s2) {
+        for (const QRectF& r1 : s1) {
+            bool interact = Ms::intersects(r1.top(), r1.bottom(), r2.top(), r2.bottom())
+                            || ((r1.height() == 0.0) && (r2.height() == 0.0) && (r1.top() == r2.top()))
+                            || ((r1.width() == 0.0) || (r2.width() == 0.0));
+            if (interact) {
+                dist = qMax(dist, r1.right() - r2.left());
+            }
+        }
+    }
+    return dist;
+}
+
+//---------------------------------------------------------
+//   minHorizontalDistance
+//    the sorted path with early exit, taken for big
+//    shapes, gives what comparing all pairs gives
+//---------------------------------------------------------
+
+void TestShape::minHorizontalDistance_data()
+{
+    QTest::addColumn<int>("size1");
+    QTest::addColumn<int>("size2");
+    QTest::addColumn<qreal>("offset");
+
+    QTest::newRow("64x1") << 64 << 1 << 20.0;
+    QTest::newRow("64x64 overlapping") << 64 << 64 << 0.0;
+    QTest::newRow("64x64 apart") << 64 << 64 << 30.0;
+    QTest::newRow("1x64") << 1 << 64 << 10.0;
+    QTest::newRow("100x7") << 100 << 7 << 15.0;
+    QTest::newRow("200x200") << 200 << 200 << 25.0;
+}
+
+void TestShape::minHorizontalDistance()
+{
+    QFETCH(int, size1);
+    QFETCH(int, size2);
+    QFETCH(qreal, offset);
+
+    QRandomGenerator rg(size1 * 1000 + size2);
+    for (int i = 0; i < 100; ++i) {
+        Shape s1 = randomShape(rg, size1, 0.0);
+        Shape s2 = randomShape(rg, size2, offset);
+        QCOMPARE(s1.minHorizontalDistance(s2), bruteForceMinHorizontalDistance(s1, s2));
+    }
+}
+
+QTEST_MAIN(TestShape)
+
+#include "tst_shape.moc"
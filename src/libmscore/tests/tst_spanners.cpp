@@ -25,6 +25,8 @@
 #include "libmscore/system.h"
 #include "libmscore/undo.h"
 #include "libmscore/line.h"
+#include "libmscore/slur.h"
+#include "libmscore/spannermap.h"
 
 static const QString SPANNERS_DATA_DIR("spanners_data/");
 
@@ -56,6 +58,8 @@ private slots:
     void spanners14();              // creating part from an existing grand staff containing a cross staff glissando
     void spanners15();              // change the color & min distance of a line and save it
     void spanners16();              // read lines with manual adjustments on a small staff and save
+    void spanners17();              // look up spanners after adding, removing and moving some
+    void spanners18();              // spanners starting on the same tick come out in the same order
 };
 
 //---------------------------------------------------------
@@ -668,5 +672,177 @@ void TestSpanners::spanners16()
     delete score;
 }
 
+//---------------------------------------------------------
+//   overlapping
+//    the spanners of map overlapping start..stop, as found
+//    by the map and by checking all of them
+//---------------------------------------------------------
+
+static void overlapping(SpannerMap& map, const std::vector<Spanner*>& spanners, int start, int stop,
+                        std::vector<Spanner*>& found, std::vector<Spanner*>& expected)
+{
+    found.clear();
+    expected.clear();
+    int lastStart = -1;
+    for (auto i : map.findOverlapping(start, stop)) {
+        QVERIFY(i.start >= lastStart);          // sorted by start tick
+        lastStart = i.start;
+        found.push_back(i.value);
+    }
+    for (Spanner* sp : spanners) {
+        if (sp->tick2().ticks() >= start && sp->tick().ticks() <= stop) {
+            expected.push_back(sp);
+        }
+    }
+    std::sort(found.begin(), found.end());
+    std::sort(expected.begin(), expected.end());
+}
+
+//---------------------------------------------------------
+///  spanners17
+///   the spanner map is updated incrementally after the
+///   first lookup, results must be the same as a full scan
+//---------------------------------------------------------
+
+void TestSpanners::spanners17()
+{
+    MasterScore* score = readScore(SPANNERS_DATA_DIR + "smallstaff01.mscx");
+    QVERIFY(score);
+
+    SpannerMap map;
+    std::vector<Spanner*> spanners;
+    auto addSlur = [&](int tick, int ticks) {
+        Slur* slur = new Slur(score);
+        slur->setTick(Fraction::fromTicks(tick));
+        slur->setTicks(Fraction::fromTicks(ticks));
+        map.addSpanner(slur);
+        spanners.push_back(slur);
+    };
+    for (int i = 0; i < 200; ++i) {
+        addSlur(i * 480, 960 + (i % 7) * 480);
+    }
+
+    std::vector<Spanner*> found;
+    std::vector<Spanner*> expected;
+    overlapping(map, spanners, 4800, 9600, found, expected);
+    QCOMPARE(found, expected);
+
+    // a few changes are merged without rebuilding the lookup tree
+    addSlur(5000, 100);
+    Spanner* removed = spanners[12];
+    map.removeSpanner(removed);
+    spanners.erase(spanners.begin() + 12);
+    Spanner* moved = spanners[30];
+    moved->setTick(Fraction::fromTicks(6000));
+    map.setDirty(moved);
+
+    for (int start : { 0, 4800, 6000, 20000, 100000 }) {
+        overlapping(map, spanners, start, start + 2400, found, expected);
+        QCOMPARE(found, expected);
+    }
+
+    // many changes
+    for (int i = 0; i < 100; ++i) {
+        map.removeSpanner(spanners.back());
+        delete spanners.back();
+        spanners.pop_back();
+        addSlur(i * 240, 240);
+    }
+    for (int start : { 0, 4800, 6000, 20000, 100000 }) {
+        overlapping(map, spanners, start, start + 2400, found, expected);
+        QCOMPARE(found, expected);
+    }
+
+    for (Spanner* sp : spanners) {
+        delete sp;
+    }
+    delete removed;
+    delete score;
+}
+
+//---------------------------------------------------------
+///  spanners18
+///   spanners starting on the same tick are found in the
+///   same order, however the map was built and edited
+//---------------------------------------------------------
+
+void TestSpanners::spanners18()
+{
+    MasterScore* score = readScore(SPANNERS_DATA_DIR + "smallstaff01.mscx");
+    QVERIFY(score);
+
+    std::vector<Spanner*> spanners;
+    for (int i = 0; i < 48; ++i) {
+        Slur* slur = new Slur(score);
+        slur->setTick(Fraction::fromTicks((i % 3) * 480));
+        slur->setTicks(Fraction::fromTicks(480 + (i / 3 % 4) * 480));
+        slur->setTrack(i / 12);
+        slur->setTrack2(i / 12);
+        spanners.push_back(slur);
+    }
+    // same tick, tick2, track, track2 and type as the first one
+    for (int i = 0; i < 4; ++i) {
+        Slur* slur = new Slur(score);
+        slur->setTick(Fraction(0, 1));
+        slur->setTicks(Fraction::fromTicks(480));
+        slur->setTrack(0);
+        slur->setTrack2(0);
+        spanners.push_back(slur);
+    }
+
+    auto order = [](SpannerMap& map, int start, int stop) {
+        std::vector<Spanner*> found;
+        for (auto i : map.findOverlapping(start, stop)) {
+            found.push_back(i.value);
+        }
+        return found;
+    };
+
+    // all at once, built in one go
+    SpannerMap all;
+    for (Spanner* sp : spanners) {
+        all.addSpanner(sp);
+    }
+
+    // in reverse order, half of them merged after the tree was built
+    // and a few moved away and back
+    SpannerMap edited;
+    for (int i = int(spanners.size()) - 1; i >= 24; --i) {
+        edited.addSpanner(spanners[i]);
+    }
+    QVERIFY(!order(edited, 0, 4800).empty());
+    for (int i = 23; i >= 0; --i) {
+        edited.addSpanner(spanners[i]);
+    }
+    for (int i : { 3, 25, 40, 50 }) {
+        Spanner* sp = spanners[i];
+        edited.removeSpanner(sp);
+        edited.addSpanner(sp);
+        edited.setDirty(sp);
+    }
+
+    for (int start : { 0, 480, 960, 2400 }) {
+        QCOMPARE(order(edited, start, start + 960), order(all, start, start + 960));
+    }
+    edited.setDirty();
+    for (int start : { 0, 480, 960, 2400 }) {
+        QCOMPARE(order(edited, start, start + 960), order(all, start, start + 960));
+    }
+
+    // spanners equal in all values come out in creation order
+    std::vector<Spanner*> equal;
+    for (Spanner* sp : order(edited, 0, 0)) {
+        if (sp->tick2().ticks() == 480 && sp->track() == 0) {
+            equal.push_back(sp);
+        }
+    }
+    QCOMPARE(equal, std::vector<Spanner*>({ spanners[0], spanners[48], spanners[49], spanners[50], spanners[51] }));
+
+    for (Spanner* sp : spanners) {
+        delete sp;
+    }
+    delete score;
+}
+
 QTEST_MAIN(TestSpanners)
 #include "tst_spanners.moc"
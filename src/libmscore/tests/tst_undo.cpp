@@ -0,0 +1,250 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "testing/qtestsuite.h"
+#include "testbase.h"
+#include "libmscore/score.h"
+#include "libmscore/measure.h"
+#include "libmscore/segment.h"
+#include "libmscore/chord.h"
+#include "libmscore/note.h"
+#include "libmscore/stafftext.h"
+#include "libmscore/undo.h"
+
+using namespace Ms;
+
+//---------------------------------------------------------
+//   TestUndo
+//---------------------------------------------------------
+
+class TestUndo : public QObject, public MTest
+{
+    Q_OBJECT
+
+    Note* firstNote(Score*) const;
+
+private slots:
+    void initTestCase() { initMTest(); }
+    void coalesceChangeProperty();
+    void memoryLimit();
+    void trimPastCleanState();
+    void trimKeepsMergedCommands();
+    void removedElementMemory();
+};
+
+//---------------------------------------------------------
+//   firstNote
+//---------------------------------------------------------
+
+Note* TestUndo::firstNote(Score* s) const
+{
+    Segment* seg = s->firstMeasure()->first(SegmentType::ChordRest);
+    while (seg && !(seg->element(0) && seg->element(0)->isChord())) {
+        seg = seg->next1(SegmentType::ChordRest);
+    }
+    return seg ? toChord(seg->element(0))->upNote() : nullptr;
+}
+
+//---------------------------------------------------------
+//   coalesceChangeProperty
+//    repeated changes of the same property inside one
+//    command are kept as a single undo step
+//---------------------------------------------------------
+
+void TestUndo::coalesceChangeProperty()
+{
+    MasterScore* s = readScore("test.mscx");
+    QVERIFY(s);
+    Note* n = firstNote(s);
+    QVERIFY(n);
+    const QVariant orig = n->getProperty(Pid::COLOR);
+
+    s->startCmd();
+    s->undo(new ChangeProperty(n, Pid::COLOR, QVariant::fromValue(QColor(Qt::red))));
+    s->undo(new ChangeProperty(n, Pid::COLOR, QVariant::fromValue(QColor(Qt::green))));
+    s->undo(new ChangeProperty(n, Pid::COLOR, QVariant::fromValue(QColor(Qt::blue))));
+    s->endCmd();
+
+    int changes = 0;
+    for (const UndoCommand* cmd : s->undoStack()->last()->commands()) {
+        if (dynamic_cast<const ChangeProperty*>(cmd)) {
+            ++changes;
+        }
+    }
+    QCOMPARE(changes, 1);
+    QCOMPARE(n->getProperty(Pid::COLOR).value<QColor>(), QColor(Qt::blue));
+
+    s->undoRedo(true, 0);
+    QCOMPARE(n->getProperty(Pid::COLOR), orig);
+    s->undoRedo(false, 0);
+    QCOMPARE(n->getProperty(Pid::COLOR).value<QColor>(), QColor(Qt::blue));
+    delete s;
+}
+
+//---------------------------------------------------------
+//   memoryLimit
+//    old commands are dropped once the history exceeds
+//    the memory limit, the last command stays undoable
+//---------------------------------------------------------
+
+void TestUndo::memoryLimit()
+{
+    MasterScore* s = readScore("test.mscx");
+    QVERIFY(s);
+    Note* n = firstNote(s);
+    QVERIFY(n);
+    UndoStack* stack = s->undoStack();
+
+    for (int i = 0; i < 20; ++i) {
+        s->startCmd();
+        s->undo(new ChangeProperty(n, Pid::COLOR, QVariant::fromValue(QColor(i, 0, 0))));
+        s->endCmd();
+    }
+    QVERIFY(stack->memoryUsage() > 0);
+    const size_t perCommand = stack->last()->memoryUsage();
+    QVERIFY(perCommand > 0);
+
+    const int idx = stack->getCurIdx();
+    stack->setMemoryLimit(perCommand * 5);
+    QVERIFY(stack->memoryUsage() <= perCommand * 5);
+    QCOMPARE(stack->getCurIdx(), idx);
+    QVERIFY(stack->canUndo());
+
+    s->undoRedo(true, 0);
+    QCOMPARE(n->getProperty(Pid::COLOR).value<QColor>(), QColor(18, 0, 0));
+    delete s;
+}
+
+//---------------------------------------------------------
+//   trimPastCleanState
+//    a score saved before the oldest kept command stays
+//    dirty, a clean state that is kept still becomes clean
+//    again by undo
+//---------------------------------------------------------
+
+void TestUndo::trimPastCleanState()
+{
+    MasterScore* s = readScore("test.mscx");
+    QVERIFY(s);
+    Note* n = firstNote(s);
+    QVERIFY(n);
+    UndoStack* stack = s->undoStack();
+
+    for (int i = 0; i < 20; ++i) {
+        if (i == 2) {
+            stack->setClean();
+        }
+        s->startCmd();
+        s->undo(new ChangeProperty(n, Pid::COLOR, QVariant::fromValue(QColor(i, 0, 0))));
+        s->endCmd();
+    }
+    const size_t perCommand = stack->last()->memoryUsage();
+    stack->setMemoryLimit(perCommand * 5);
+    QVERIFY(!stack->isClean());
+    while (stack->canUndo()) {
+        s->undoRedo(true, 0);
+        QVERIFY(!stack->isClean());
+    }
+    while (stack->canRedo()) {
+        s->undoRedo(false, 0);
+    }
+
+    // clean state within the kept commands
+    s->undoRedo(true, 0);
+    stack->setClean();
+    s->undoRedo(false, 0);
+    stack->setMemoryLimit(perCommand * 20);
+    for (int i = 0; i < 10; ++i) {
+        s->startCmd();
+        s->undo(new ChangeProperty(n, Pid::COLOR, QVariant::fromValue(QColor(0, i, 0))));
+        s->endCmd();
+    }
+    for (int i = 0; i < 11; ++i) {
+        QVERIFY(!stack->isClean());
+        s->undoRedo(true, 0);
+    }
+    QVERIFY(stack->isClean());
+    delete s;
+}
+
+//---------------------------------------------------------
+//   trimKeepsMergedCommands
+//    the commands from the keep index on, e.g. those of a
+//    text edit which are merged when the edit ends, are
+//    not dropped
+//---------------------------------------------------------
+
+void TestUndo::trimKeepsMergedCommands()
+{
+    MasterScore* s = readScore("test.mscx");
+    QVERIFY(s);
+    Note* n = firstNote(s);
+    QVERIFY(n);
+    UndoStack* stack = s->undoStack();
+
+    s->startCmd();
+    s->undo(new ChangeProperty(n, Pid::COLOR, QVariant::fromValue(QColor(1, 0, 0))));
+    s->endCmd();
+    const size_t perCommand = stack->last()->memoryUsage();
+    stack->setMemoryLimit(perCommand * 3);
+
+    const int startIdx = stack->getCurIdx();
+    stack->setKeepFrom(startIdx);
+    for (int i = 0; i < 10; ++i) {
+        s->startCmd();
+        s->undo(new ChangeProperty(n, Pid::COLOR, QVariant::fromValue(QColor(0, i, 0))));
+        s->endCmd();
+    }
+    QCOMPARE(stack->getCurIdx(), startIdx + 10);
+    stack->mergeCommands(startIdx);
+    stack->setKeepFrom(-1);
+    QCOMPARE(stack->getCurIdx(), startIdx + 1);
+
+    s->undoRedo(true, 0);
+    QCOMPARE(n->getProperty(Pid::COLOR).value<QColor>(), QColor(1, 0, 0));
+    delete s;
+}
+
+//---------------------------------------------------------
+//   removedElementMemory
+//    an element removed by a command is owned by it and
+//    counts towards the history size
+//---------------------------------------------------------
+
+void TestUndo::removedElementMemory()
+{
+    MasterScore* s = readScore("test.mscx");
+    QVERIFY(s);
+    Note* n = firstNote(s);
+    QVERIFY(n);
+    UndoStack* stack = s->undoStack();
+
+    StaffText* text = new StaffText(s);
+    text->setParent(n->chord()->segment());
+    text->setTrack(0);
+    text->setXmlText(QString(1000, 'x'));
+    s->startCmd();
+    s->undoAddElement(text);
+    s->endCmd();
+    const size_t added = stack->last()->memoryUsage();
+
+    s->startCmd();
+    s->undoRemoveElement(text);
+    s->endCmd();
+    QVERIFY(stack->last()->memoryUsage() >= 1000 * sizeof(QChar));
+    QVERIFY(stack->last()->memoryUsage() > added);
+    delete s;
+}
+
+QTEST_MAIN(TestUndo)
+
+#include "tst_undo.moc"
@@ -31,6 +31,7 @@
 #include "box.h"
 #include "page.h"
 #include "textframe.h"
+#include "textlayoutcache.h"
 #include "sym.h"
 #include "xml.h"
 #include "undo.h"
@@ -1000,30 +1001,7 @@ QFont TextFragment::font(const TextBase* t) const
 
         // check if all symbols are available
         font.setFamily(family);
-        QFontMetricsF fm(font);
-
-        bool fail = false;
-        for (int i = 0; i < text.size(); ++i) {
-            QChar c = text[i];
-            if (c.isHighSurrogate()) {
-                if (i + 1 == text.size()) {
-                    qFatal("bad string");
-                }
-                QChar c2 = text[i + 1];
-                ++i;
-                uint v = QChar::surrogateToUcs4(c, c2);
-                if (!fm.inFontUcs4(v)) {
-                    fail = true;
-                    break;
-                }
-            } else {
-                if (!fm.inFont(c)) {
-                    fail = true;
-                    break;
-                }
-            }
-        }
-        if (fail) {
+        if (!TextLayoutCache::inFont(font, text)) {
             family = ScoreFont::fallbackTextFont();
         }
     } else {
@@ -1100,9 +1078,9 @@ void TextBlock::layout(TextBase* t)
         auto fi = _fragments.begin();
         TextFragment& f = *fi;
         f.pos.setX(x);
-        QFontMetricsF fm(f.font(t), MScore::paintDevice());
+        const TextFontMetrics fm = TextLayoutCache::fontMetrics(f.font(t));
         if (f.format.valign() != VerticalAlignment::AlignNormal) {
-            qreal voffset = fm.xHeight() / subScriptSize;   // use original height
+            qreal voffset = fm.xHeight / subScriptSize;   // use original height
             if (f.format.valign() == VerticalAlignment::AlignSubScript) {
                 voffset *= subScriptOffset;
             } else {
@@ -1114,17 +1092,18 @@ void TextBlock::layout(TextBase* t)
             f.pos.setY(0.0);
         }
 
-        QRectF temp(0.0, -fm.ascent(), 1.0, fm.descent());
+        QRectF temp(0.0, -fm.ascent, 1.0, fm.descent);
         _bbox |= temp;
-        _lineSpacing = qMax(_lineSpacing, fm.lineSpacing());
+        _lineSpacing = qMax(_lineSpacing, fm.lineSpacing);
     } else {
         const auto fiLast = --_fragments.end();
         for (auto fi = _fragments.begin(); fi != _fragments.end(); ++fi) {
             TextFragment& f = *fi;
             f.pos.setX(x);
-            QFontMetricsF fm(f.font(t), MScore::paintDevice());
+            const QFont font = f.font(t);
+            const TextFontMetrics fm = TextLayoutCache::fontMetrics(font);
             if (f.format.valign() != VerticalAlignment::AlignNormal) {
-                qreal voffset = fm.xHeight() / subScriptSize;           // use original height
+                qreal voffset = fm.xHeight / subScriptSize;           // use original height
                 if (f.format.valign() == VerticalAlignment::AlignSubScript) {
                     voffset *= subScriptOffset;
                 } else {
@@ -1135,15 +1114,13 @@ void TextBlock::layout(TextBase* t)
                 f.pos.setY(0.0);
             }
 
-            // Optimization: don't calculate character position
-            // for the next fragment if there is no next fragment
+            const TextRun run = TextLayoutCache::textRun(font, f.text);
             if (fi != fiLast) {
-                const qreal w  = fm.width(f.text);
-                x += w;
+                x += run.width;
             }
 
-            _bbox   |= fm.tightBoundingRect(f.text).translated(f.pos);
-            _lineSpacing = qMax(_lineSpacing, fm.lineSpacing());
+            _bbox   |= run.tightBoundingRect.translated(f.pos);
+            _lineSpacing = qMax(_lineSpacing, fm.lineSpacing);
         }
     }
     qreal rx;
@@ -1190,7 +1167,7 @@ qreal TextBlock::xpos(int column, const TextBase* t) const
         if (column == col) {
             return f.pos.x();
         }
-        QFontMetricsF fm(f.font(t), MScore::paintDevice());
+        const QFont font = f.font(t);
         int idx = 0;
         for (const QChar& c : f.text) {
             ++idx;
@@ -1199,7 +1176,7 @@ qreal TextBlock::xpos(int column, const TextBase* t) const
             }
             ++col;
             if (column == col) {
-                return f.pos.x() + fm.width(f.text.left(idx));
+                return f.pos.x() + TextLayoutCache::width(font, f.text.left(idx));
             }
         }
     }
@@ -1290,13 +1267,13 @@ int TextBlock::column(qreal x, TextBase* t) const
             return col;
         }
         qreal px = 0.0;
+        const QFont font = f.font(t);
         for (const QChar& c : f.text) {
             ++idx;
             if (c.isHighSurrogate()) {
                 continue;
             }
-            QFontMetricsF fm(f.font(t), MScore::paintDevice());
-            qreal xo = fm.width(f.text.left(idx));
+            qreal xo = TextLayoutCache::width(font, f.text.left(idx));
             if (x <= f.pos.x() + px + (xo - px) * .5) {
                 return col;
             }
@@ -1807,6 +1784,16 @@ void TextBase::createLayout()
     _layout.clear();  // deletes the text fragments so we lose all formatting information
     TextCursor cursor = *_cursor;
 
+    // the parsed text depends only on the xml text and the initial format
+    const bool cacheable = cursor.row() == 0 && cursor.column() == 0;
+    ParsedText parsed;
+    if (cacheable && TextLayoutCache::parsedText(_text, *cursor.format(), &parsed)) {
+        _layout = parsed.blocks;
+        setUnstyledByMarkup(parsed);
+        layoutInvalid = false;
+        return;
+    }
+
     int state = 0;
     QString token;
     QString sym;
@@ -1900,19 +1887,19 @@ void TextBase::createLayout()
                     token = token.mid(5);
                     if (token.startsWith("size=\"")) {
                         cursor.format()->setFontSize(parseNumProperty(token.mid(6)));
-                        setPropertyFlags(Pid::FONT_SIZE, PropertyFlags::UNSTYLED);
+                        parsed.unstyledFontSize = true;
                     } else if (token.startsWith("face=\"")) {
                         QString face = parseStringProperty(token.mid(6));
                         face = unEscape(face);
                         cursor.format()->setFontFamily(face);
-                        setPropertyFlags(Pid::FONT_FACE, PropertyFlags::UNSTYLED);
+                        parsed.unstyledFontFace = true;
                     } else {
                         qDebug("cannot parse html property <%s> in text <%s>",
                                qPrintable(token), qPrintable(_text));
                     }
                 }
                 if (unstyleFontStyle) {
-                    setPropertyFlags(Pid::FONT_STYLE, PropertyFlags::UNSTYLED);
+                    parsed.unstyledFontStyle = true;
                 }
             } else {
                 token += c;
@@ -1939,9 +1926,33 @@ void TextBase::createLayout()
     if (_layout.empty()) {
         _layout.append(TextBlock());
     }
+    setUnstyledByMarkup(parsed);
+    if (cacheable) {
+        parsed.blocks = _layout;
+        TextLayoutCache::setParsedText(_text, *_cursor->format(), parsed);
+    }
     layoutInvalid = false;
 }
 
+//---------------------------------------------------------
+//   setUnstyledByMarkup
+//    font properties set by markup in the text are no
+//    longer styled
+//---------------------------------------------------------
+
+void TextBase::setUnstyledByMarkup(const ParsedText& parsed)
+{
+    if (parsed.unstyledFontSize) {
+        setPropertyFlags(Pid::FONT_SIZE, PropertyFlags::UNSTYLED);
+    }
+    if (parsed.unstyledFontFace) {
+        setPropertyFlags(Pid::FONT_FACE, PropertyFlags::UNSTYLED);
+    }
+    if (parsed.unstyledFontStyle) {
+        setPropertyFlags(Pid::FONT_STYLE, PropertyFlags::UNSTYLED);
+    }
+}
+
 //---------------------------------------------------------
 //   layout
 //---------------------------------------------------------
@@ -2584,6 +2595,9 @@ bool TextBase::acceptDrop(EditData& data) const
 
 void TextBase::setXmlText(const QString& s)
 {
+    if (!layoutInvalid && !textInvalid && s == _text) {
+        return;           // keep the parsed text blocks
+    }
     _text = s;
     textInvalid = false;
     layoutInvalid = true;
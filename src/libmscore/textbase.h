@@ -22,6 +22,7 @@
 namespace Ms {
 class MuseScoreView;
 struct SymCode;
+struct ParsedText;
 class TextBase;
 class TextBlock;
 class ChangeText;
@@ -272,6 +273,7 @@ protected:
     void layoutFrame();
     void layoutEdit();
     void createLayout();
+    void setUnstyledByMarkup(const ParsedText&);
     void insertSym(EditData& ed, SymId id);
 
 public:
@@ -82,6 +82,8 @@ void TextBase::startEdit(EditData& ed)
 
     ted->oldXmlText = xmlText();
     ted->startUndoIdx = score()->undoStack()->getCurIdx();
+    // endEdit() merges the macros of the edit, and maybe the one before
+    score()->undoStack()->setKeepFrom(qMax(ted->startUndoIdx - 1, 0));
 
     if (layoutInvalid) {
         layout();
@@ -144,6 +146,7 @@ void TextBase::endEdit(EditData& ed)
             undo->mergeCommands(ted->startUndoIdx - 1);
         }
     }
+    undo->setKeepFrom(-1);
 
     // TBox'es manage their Text themselves and are not removed if text is empty
     const bool removeTextIfEmpty = !(parent() && parent()->isTBox());
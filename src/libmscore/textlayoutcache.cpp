@@ -0,0 +1,203 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#include "textlayoutcache.h"
+
+#include <QFontMetricsF>
+#include <QHash>
+#include <QMutex>
+
+#include "mscore.h"
+
+namespace Ms {
+//---------------------------------------------------------
+//   the caches only grow while a score is laid out,
+//    they are dropped as a whole when they get too big
+//---------------------------------------------------------
+
+static const int MAX_RUNS        = 100000;
+static const int MAX_PARSED_TEXT = 20000;
+
+//---------------------------------------------------------
+//   FontEntry
+//---------------------------------------------------------
+
+struct FontEntry {
+    bool hasMetrics { false };
+    TextFontMetrics metrics;
+    QHash<QString, TextRun> runs;
+    QHash<QString, bool> inFont;
+};
+
+//---------------------------------------------------------
+//   ParsedTextKey
+//---------------------------------------------------------
+
+struct ParsedTextKey {
+    QString xmlText;
+    CharFormat format;
+
+    bool operator==(const ParsedTextKey& k) const { return xmlText == k.xmlText && format == k.format; }
+};
+
+static uint qHash(const ParsedTextKey& k, uint seed = 0)
+{
+    return ::qHash(k.xmlText, seed)
+           ^ ::qHash(k.format.fontFamily(), seed)
+           ^ ::qHash(k.format.fontSize(), seed)
+           ^ (uint(k.format.style()) << 8 | uint(k.format.valign()) << 4 | uint(k.format.preedit()));
+}
+
+static QMutex cacheMutex;
+static QHash<QFont, FontEntry> fonts;
+static int runCount = 0;
+static QHash<ParsedTextKey, ParsedText> parsedTexts;
+
+//---------------------------------------------------------
+//   fontEntry
+//    must be called with cacheMutex locked
+//---------------------------------------------------------
+
+static FontEntry& fontEntry(const QFont& f)
+{
+    if (runCount > MAX_RUNS) {
+        fonts.clear();
+        runCount = 0;
+    }
+    return fonts[f];
+}
+
+//---------------------------------------------------------
+//   fontMetrics
+//---------------------------------------------------------
+
+TextFontMetrics TextLayoutCache::fontMetrics(const QFont& f)
+{
+    QMutexLocker locker(&cacheMutex);
+    FontEntry& e = fontEntry(f);
+    if (!e.hasMetrics) {
+        QFontMetricsF fm(f, MScore::paintDevice());
+        e.metrics.ascent      = fm.ascent();
+        e.metrics.descent     = fm.descent();
+        e.metrics.lineSpacing = fm.lineSpacing();
+        e.metrics.xHeight     = fm.xHeight();
+        e.hasMetrics = true;
+    }
+    return e.metrics;
+}
+
+//---------------------------------------------------------
+//   textRun
+//---------------------------------------------------------
+
+TextRun TextLayoutCache::textRun(const QFont& f, const QString& s)
+{
+    QMutexLocker locker(&cacheMutex);
+    FontEntry& e = fontEntry(f);
+    auto i = e.runs.constFind(s);
+    if (i != e.runs.constEnd()) {
+        return i.value();
+    }
+
+    QFontMetricsF fm(f, MScore::paintDevice());
+    TextRun run;
+    run.width             = fm.width(s);
+    run.tightBoundingRect = fm.tightBoundingRect(s);
+    e.runs.insert(s, run);
+    ++runCount;
+    return run;
+}
+
+//---------------------------------------------------------
+//   inFont
+//    true if the font has glyphs for all characters of s
+//---------------------------------------------------------
+
+bool TextLayoutCache::inFont(const QFont& f, const QString& s)
+{
+    QMutexLocker locker(&cacheMutex);
+    FontEntry& e = fontEntry(f);
+    auto i = e.inFont.constFind(s);
+    if (i != e.inFont.constEnd()) {
+        return i.value();
+    }
+
+    QFontMetricsF fm(f);
+    bool found = true;
+    for (int idx = 0; idx < s.size(); ++idx) {
+        QChar c = s[idx];
+        if (c.isHighSurrogate()) {
+            if (idx + 1 == s.size()) {
+                qFatal("bad string");
+            }
+            QChar c2 = s[idx + 1];
+            ++idx;
+            uint v = QChar::surrogateToUcs4(c, c2);
+            if (!fm.inFontUcs4(v)) {
+                found = false;
+                break;
+            }
+        } else {
+            if (!fm.inFont(c)) {
+                found = false;
+                break;
+            }
+        }
+    }
+    e.inFont.insert(s, found);
+    ++runCount;
+    return found;
+}
+
+//---------------------------------------------------------
+//   parsedText
+//    text blocks created before from xmlText with
+//    format as the initial format
+//---------------------------------------------------------
+
+bool TextLayoutCache::parsedText(const QString& xmlText, const CharFormat& format, ParsedText* parsed)
+{
+    QMutexLocker locker(&cacheMutex);
+    auto i = parsedTexts.constFind(ParsedTextKey { xmlText, format });
+    if (i == parsedTexts.constEnd()) {
+        return false;
+    }
+    *parsed = i.value();
+    return true;
+}
+
+//---------------------------------------------------------
+//   setParsedText
+//---------------------------------------------------------
+
+void TextLayoutCache::setParsedText(const QString& xmlText, const CharFormat& format, const ParsedText& parsed)
+{
+    QMutexLocker locker(&cacheMutex);
+    if (parsedTexts.size() >= MAX_PARSED_TEXT) {
+        parsedTexts.clear();
+    }
+    parsedTexts.insert(ParsedTextKey { xmlText, format }, parsed);
+}
+
+//---------------------------------------------------------
+//   clear
+//    needed if the installed fonts change
+//---------------------------------------------------------
+
+void TextLayoutCache::clear()
+{
+    QMutexLocker locker(&cacheMutex);
+    fonts.clear();
+    runCount = 0;
+    parsedTexts.clear();
+}
+}
@@ -0,0 +1,85 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2
+//  as published by the Free Software Foundation and appearing in
+//  the file LICENCE.GPL
+//=============================================================================
+
+#ifndef __TEXTLAYOUTCACHE_H__
+#define __TEXTLAYOUTCACHE_H__
+
+#include <QFont>
+#include <QList>
+#include <QRectF>
+#include <QString>
+
+#include "textbase.h"
+
+namespace Ms {
+//---------------------------------------------------------
+//   TextFontMetrics
+//    the font metrics used by text layout, measured on
+//    MScore::paintDevice()
+//---------------------------------------------------------
+
+struct TextFontMetrics {
+    qreal ascent      { 0.0 };
+    qreal descent     { 0.0 };
+    qreal lineSpacing { 0.0 };
+    qreal xHeight     { 0.0 };
+};
+
+//---------------------------------------------------------
+//   TextRun
+//    a shaped string in one font
+//---------------------------------------------------------
+
+struct TextRun {
+    qreal width { 0.0 };
+    QRectF tightBoundingRect;
+};
+
+//---------------------------------------------------------
+//   ParsedText
+//    the text blocks created from xml text and the
+//    properties the markup made unstyled
+//---------------------------------------------------------
+
+struct ParsedText {
+    QList<TextBlock> blocks;
+    bool unstyledFontSize  { false };
+    bool unstyledFontFace  { false };
+    bool unstyledFontStyle { false };
+};
+
+//---------------------------------------------------------
+//   TextLayoutCache
+//    Process wide cache shared by all text elements.
+//    Lyrics, chord symbols, fingerings etc. repeat the
+//    same few strings in the same few fonts, so shaping
+//    and markup parsing are done once per distinct
+//    (font, string) and (xml text, format).
+//    Thread safe.
+//---------------------------------------------------------
+
+class TextLayoutCache
+{
+public:
+    static TextFontMetrics fontMetrics(const QFont&);
+    static TextRun textRun(const QFont&, const QString&);
+    static qreal width(const QFont& f, const QString& s) { return textRun(f, s).width; }
+    static bool inFont(const QFont&, const QString&);
+
+    static bool parsedText(const QString& xmlText, const CharFormat& format, ParsedText* parsed);
+    static void setParsedText(const QString& xmlText, const CharFormat& format, const ParsedText& parsed);
+
+    static void clear();
+};
+}     // namespace Ms
+
+#endif
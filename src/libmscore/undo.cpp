@@ -237,6 +237,53 @@ void UndoCommand::filterChildren(UndoCommand::Filter f, Element* target)
     childList = std::move(acceptedList);
 }
 
+//---------------------------------------------------------
+//   elementMemoryUsage
+///   Estimated number of bytes held by an element which is
+///   not part of the score and owned by a command,
+///   including its children.
+//---------------------------------------------------------
+
+static size_t elementMemoryUsage(Element* e)
+{
+    size_t n = 0;
+    e->scanElements(&n, [](void* data, Element* el) {
+        size_t* n = static_cast<size_t*>(data);
+        if (el->isNote()) {
+            *n += sizeof(Note);
+        } else if (el->isChord()) {
+            *n += sizeof(Chord);
+        } else if (el->isRest()) {
+            *n += sizeof(Rest);
+        } else if (el->isMeasure()) {
+            *n += sizeof(Measure);
+        } else if (el->isSegment()) {
+            *n += sizeof(Segment);
+        } else if (el->isTextBase()) {
+            *n += sizeof(TextBase) + size_t(toTextBase(el)->xmlText().capacity()) * sizeof(QChar);
+        } else {
+            *n += sizeof(Element);
+        }
+    }, true);
+    return n;
+}
+
+//---------------------------------------------------------
+//   memoryUsage
+///   Estimated number of bytes held by this command and
+///   its children. Elements referenced by commands are only
+///   accounted for where the command owns them.
+//---------------------------------------------------------
+
+size_t UndoCommand::memoryUsage() const
+{
+    size_t n = sizeof(UndoCommand) + size_t(childList.size()) * sizeof(UndoCommand*);
+    for (const UndoCommand* c : childList) {
+        n += c->memoryUsage();
+    }
+    return n;
+}
+
 //---------------------------------------------------------
 //   unwind
 //---------------------------------------------------------
@@ -262,6 +309,10 @@ UndoStack::UndoStack()
     cleanState = 0;
     stateList.push_back(cleanState);
     nextState = 1;
+    droppedCount = 0;
+    keepFrom = -1;
+    _memoryUsage = 0;
+    _memoryLimit = MScore::undoMemoryLimit;
 }
 
 //---------------------------------------------------------
@@ -307,13 +358,21 @@ void UndoStack::push(UndoCommand* cmd, EditData* ed)
         return;
     }
 #ifndef QT_NO_DEBUG
-    if (!strcmp(cmd->name(), "ChangeProperty")) {
-        ChangeProperty* cp = static_cast<ChangeProperty*>(cmd);
+    if (const ChangeProperty* cp = dynamic_cast<const ChangeProperty*>(cmd)) {
         qDebug("<%s> id %d %s", cmd->name(), int(cp->getId()), propertyName(cp->getId()));
     } else {
         qDebug("<%s>", cmd->name());
     }
 #endif
+    // a property changed twice in a row needs only the first
+    // command: it holds the original value for undo and picks
+    // up the final value when undone
+    const QList<UndoCommand*>& cl = curCmd->commands();
+    if (!cl.empty() && cl.back()->canCoalesce(cmd)) {
+        cmd->redo(ed);
+        delete cmd;
+        return;
+    }
     curCmd->appendChild(cmd);
     cmd->redo(ed);
 }
@@ -345,6 +404,7 @@ void UndoStack::remove(int idx)
     while (list.size() > curIdx) {
         UndoCommand* cmd = list.takeLast();
         stateList.pop_back();
+        _memoryUsage -= cmd->memoryUsage();
         cmd->cleanup(false);      // delete elements for which UndoCommand() holds ownership
         delete cmd;
 //            --curIdx;
@@ -352,18 +412,60 @@ void UndoStack::remove(int idx)
     while (list.size() > idx) {
         UndoCommand* cmd = list.takeLast();
         stateList.pop_back();
+        _memoryUsage -= cmd->memoryUsage();
         cmd->cleanup(true);
         delete cmd;
     }
     curIdx = idx;
 }
 
+//---------------------------------------------------------
+//   trim
+//    drop the oldest macros until the stack fits into
+//    the memory limit; the most recent macro and the
+//    macros from keepFrom on, which are still to be
+//    merged, are always kept
+//---------------------------------------------------------
+
+void UndoStack::trim()
+{
+    if (_memoryLimit == 0) {
+        return;
+    }
+    while (_memoryUsage > _memoryLimit && curIdx > 1 && (keepFrom < 0 || droppedCount < keepFrom)) {
+        UndoMacro* cmd = list.takeFirst();
+        if (stateList.front() == cleanState) {
+            cleanState = -1;      // can not be reached any more
+        }
+        stateList.erase(stateList.begin());
+        _memoryUsage -= cmd->memoryUsage();
+        cmd->cleanup(true);
+        delete cmd;
+        --curIdx;
+        ++droppedCount;
+    }
+}
+
+//---------------------------------------------------------
+//   setMemoryLimit
+//---------------------------------------------------------
+
+void UndoStack::setMemoryLimit(size_t bytes)
+{
+    _memoryLimit = bytes;
+    if (!curCmd) {
+        trim();
+    }
+}
+
 //---------------------------------------------------------
 //   mergeCommands
 //---------------------------------------------------------
 
 void UndoStack::mergeCommands(int startIdx)
 {
+    // startIdx counts the dropped macros too, trim() keeps the ones from keepFrom on
+    startIdx = qMax(startIdx - droppedCount, 0);
     Q_ASSERT(startIdx <= curIdx);
 
     if (startIdx >= list.size()) {
@@ -376,6 +478,9 @@ void UndoStack::mergeCommands(int startIdx)
         startMacro->append(std::move(*list[idx]));
     }
     remove(startIdx + 1);   // TODO: remove from startIdx to curIdx only
+    _memoryUsage -= startMacro->memoryUsage();
+    startMacro->updateMemoryUsage();
+    _memoryUsage += startMacro->memoryUsage();
 }
 
 //---------------------------------------------------------
@@ -425,14 +530,18 @@ void UndoStack::endMacro(bool rollback)
         while (list.size() > curIdx) {
             UndoCommand* cmd = list.takeLast();
             stateList.pop_back();
+            _memoryUsage -= cmd->memoryUsage();
             cmd->cleanup(false);        // delete elements for which UndoCommand() holds ownership
             delete cmd;
         }
+        curCmd->updateMemoryUsage();
+        _memoryUsage += curCmd->memoryUsage();
         list.append(curCmd);
         stateList.push_back(nextState++);
         ++curIdx;
     }
     curCmd = 0;
+    trim();
 }
 
 //---------------------------------------------------------
@@ -447,6 +556,7 @@ void UndoStack::reopen()
     --curIdx;
     curCmd = list.takeAt(curIdx);
     stateList.erase(stateList.begin() + curIdx);
+    _memoryUsage -= curCmd->memoryUsage();
     for (auto i : curCmd->commands()) {
         qDebug("   <%s>", i->name());
     }
@@ -471,7 +581,7 @@ void UndoStack::undo(EditData* ed)
     // Are we currently editing text?
     if (ed && ed->element && ed->element->isTextBase()) {
         TextEditData* ted = static_cast<TextEditData*>(ed->getData(ed->element));
-        if (ted && ted->startUndoIdx == curIdx) {
+        if (ted && ted->startUndoIdx == getCurIdx()) {
             // No edits to undo, so do nothing
             return;
         }
@@ -576,6 +686,17 @@ void UndoMacro::redo(EditData* ed)
     }
 }
 
+//---------------------------------------------------------
+//   updateMemoryUsage
+//    recompute the cached estimate after the list of
+//    child commands was changed
+//---------------------------------------------------------
+
+void UndoMacro::updateMemoryUsage()
+{
+    _memoryUsage = sizeof(UndoMacro) + UndoCommand::memoryUsage() - sizeof(UndoCommand);
+}
+
 void UndoMacro::append(UndoMacro&& other)
 {
     appendChildren(&other);
@@ -893,6 +1014,16 @@ void RemoveElement::cleanup(bool undo)
     }
 }
 
+//---------------------------------------------------------
+//   RemoveElement::memoryUsage
+//    the removed element is owned while the command is done
+//---------------------------------------------------------
+
+size_t RemoveElement::memoryUsage() const
+{
+    return sizeof(RemoveElement) + (element ? elementMemoryUsage(element) : 0);
+}
+
 //---------------------------------------------------------
 //   undo
 //---------------------------------------------------------
@@ -1257,6 +1388,17 @@ void ChangeElement::flip(EditData*)
     // score->setLayoutAll();
 }
 
+//---------------------------------------------------------
+//   ChangeElement::memoryUsage
+//    after flip() newElement is the one replaced in the
+//    score and kept for undo
+//---------------------------------------------------------
+
+size_t ChangeElement::memoryUsage() const
+{
+    return sizeof(ChangeElement) + elementMemoryUsage(newElement);
+}
+
 //---------------------------------------------------------
 //   InsertStaves
 //---------------------------------------------------------
@@ -2282,6 +2424,43 @@ void ChangeProperty::flip(EditData*)
     flags = ps;
 }
 
+//---------------------------------------------------------
+//   ChangeProperty::memoryUsage
+//---------------------------------------------------------
+
+size_t ChangeProperty::memoryUsage() const
+{
+    size_t n = sizeof(ChangeProperty);
+    switch (property.type()) {
+    case QVariant::String:
+        n += size_t(property.toString().capacity()) * sizeof(QChar);
+        break;
+    case QVariant::ByteArray:
+        n += size_t(property.toByteArray().capacity());
+        break;
+    default:
+        break;
+    }
+    return n;
+}
+
+//---------------------------------------------------------
+//   ChangeProperty::canCoalesce
+//    Two plain ChangeProperty commands for the same
+//    element and property can be merged into the older
+//    one. Commands which resolve their target element in
+//    flip() are never coalesced.
+//---------------------------------------------------------
+
+bool ChangeProperty::canCoalesce(const UndoCommand* cmd) const
+{
+    const ChangeProperty* cp = dynamic_cast<const ChangeProperty*>(cmd);
+    if (!cp || !hasFixedElement() || !cp->hasFixedElement()) {
+        return false;
+    }
+    return cp->element == element && cp->id == id;
+}
+
 //---------------------------------------------------------
 //   ChangeBracketProperty::flip
 //---------------------------------------------------------
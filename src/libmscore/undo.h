@@ -127,6 +127,9 @@ public:
     bool hasFilteredChildren(Filter, const Element* target) const;
     bool hasUnfilteredChildren(const std::vector<Filter>& filters, const Element* target) const;
     void filterChildren(UndoCommand::Filter f, Element* target);
+
+    virtual size_t memoryUsage() const;
+    virtual bool canCoalesce(const UndoCommand*) const { return false; }
 };
 
 //---------------------------------------------------------
@@ -153,6 +156,7 @@ class UndoMacro : public UndoCommand
     SelectionInfo redoSelectionInfo;
 
     Score* score;
+    size_t _memoryUsage { 0 };
 
     static void fillSelectionInfo(SelectionInfo&, const Selection&);
     static void applySelectionInfo(const SelectionInfo&, Selection&);
@@ -164,6 +168,9 @@ public:
     bool empty() const { return childCount() == 0; }
     void append(UndoMacro&& other);
 
+    size_t memoryUsage() const override { return _memoryUsage; }
+    void updateMemoryUsage();
+
     static bool canRecordSelectedElement(const Element* e);
 
     UNDO_NAME("UndoMacro");
@@ -181,8 +188,13 @@ class UndoStack
     int nextState;
     int cleanState;
     int curIdx;
+    int droppedCount;         // number of macros dropped from the bottom of the stack
+    int keepFrom;             // trim() keeps the macros from this index on (see getCurIdx()), -1: none
+    size_t _memoryUsage;
+    size_t _memoryLimit;      // 0: unlimited
 
     void remove(int idx);
+    void trim();
 
 public:
     UndoStack();
@@ -199,7 +211,7 @@ public:
     bool canRedo() const { return curIdx < list.size(); }
     int state() const { return stateList[curIdx]; }
     bool isClean() const { return cleanState == state(); }
-    int getCurIdx() const { return curIdx; }
+    int getCurIdx() const { return curIdx + droppedCount; }
     bool empty() const { return !canUndo() && !canRedo(); }
     UndoMacro* current() const { return curCmd; }
     UndoMacro* last() const { return curIdx > 0 ? list[curIdx - 1] : 0; }
@@ -211,6 +223,11 @@ public:
 
     void mergeCommands(int startIdx);
     void cleanRedoStack() { remove(curIdx); }
+
+    size_t memoryUsage() const { return _memoryUsage; }
+    size_t memoryLimit() const { return _memoryLimit; }
+    void setMemoryLimit(size_t bytes);
+    void setKeepFrom(int idx) { keepFrom = idx; }
 };
 
 //---------------------------------------------------------
@@ -444,6 +461,8 @@ class ChangeElement : public UndoCommand
 public:
     ChangeElement(Element* oldElement, Element* newElement);
     UNDO_NAME("ChangeElement")
+
+    size_t memoryUsage() const override;
 };
 
 //---------------------------------------------------------
@@ -582,6 +601,7 @@ public:
     virtual void redo(EditData*) override;
     virtual void cleanup(bool) override;
     virtual const char* name() const override;
+    size_t memoryUsage() const override;
 
     bool isFiltered(UndoCommand::Filter f, const Element* target) const override;
 };
@@ -1101,6 +1121,10 @@ public:
     QVariant data() const { return property; }
     UNDO_NAME("ChangeProperty")
 
+    size_t memoryUsage() const override;
+    bool canCoalesce(const UndoCommand*) const override;
+    virtual bool hasFixedElement() const { return true; }   // false if flip() resolves the element
+
     bool isFiltered(UndoCommand::Filter f, const Element* target) const override
     {
         return f == UndoCommand::Filter::ChangePropertyLinked && target->linkList().contains(element);
@@ -1122,6 +1146,8 @@ public:
     ChangeBracketProperty(Staff* s, int l, Pid i, const QVariant& v, PropertyFlags ps = PropertyFlags::NOSTYLE)
         : ChangeProperty(nullptr, i, v, ps), staff(s), level(l) {}
     UNDO_NAME("ChangeBracketProperty")
+
+    bool hasFixedElement() const override { return false; }
 };
 
 //---------------------------------------------------------
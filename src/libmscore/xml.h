@@ -107,6 +107,9 @@ class XmlReader : public QXmlStreamReader
 
     qint64 _offsetLines { 0 };
 
+    QString _textBuffer;                // reused by readText(), keeps its capacity
+    const QString& readText();
+
 public:
     XmlReader(QFile* f)
         : QXmlStreamReader(f), docName(f->fileName()) {}
@@ -124,7 +127,7 @@ public:
     void unknown();
 
     // attribute helper routines:
-    QString attribute(const char* s) const { return attributes().value(s).toString(); }
+    QString attribute(const char* s) const { return attributes().value(QLatin1String(s)).toString(); }
     QString attribute(const char* s, const QString&) const;
     int intAttribute(const char* s) const;
     int intAttribute(const char* s, int _default) const;
@@ -132,12 +135,13 @@ public:
     double doubleAttribute(const char* s, double _default) const;
     bool hasAttribute(const char* s) const;
 
-    // helper routines based on readElementText():
-    int readInt() { return readElementText().toInt(); }
-    int readInt(bool* ok) { return readElementText().toInt(ok); }
-    int readIntHex() { return readElementText().toInt(0, 16); }
-    double readDouble() { return readElementText().toDouble(); }
-    qlonglong readLongLong() { return readElementText().toLongLong(); }
+    // helper routines based on readText(), they do not allocate
+    // a new string for every element:
+    int readInt() { return readText().toInt(); }
+    int readInt(bool* ok) { return readText().toInt(ok); }
+    int readIntHex() { return readText().toInt(0, 16); }
+    double readDouble() { return readText().toDouble(); }
+    qlonglong readLongLong() { return readText().toLongLong(); }
 
     double readDouble(double min, double max);
     bool readBool();
@@ -41,13 +41,16 @@ XmlReader::~XmlReader()
 
 //---------------------------------------------------------
 //   intAttribute
+//    attribute names are looked up as QLatin1String to
+//    avoid converting the name to a QString on every call
 //---------------------------------------------------------
 
 int XmlReader::intAttribute(const char* s, int _default) const
 {
-    if (attributes().hasAttribute(s)) {
-        // return attributes().value(s).toString().toInt();
-        return attributes().value(s).toInt();
+    const QXmlStreamAttributes a = attributes();
+    const QLatin1String n(s);
+    if (a.hasAttribute(n)) {
+        return a.value(n).toInt();
     } else {
         return _default;
     }
@@ -55,7 +58,7 @@ int XmlReader::intAttribute(const char* s, int _default) const
 
 int XmlReader::intAttribute(const char* s) const
 {
-    return attributes().value(s).toInt();
+    return attributes().value(QLatin1String(s)).toInt();
 }
 
 //---------------------------------------------------------
@@ -64,13 +67,15 @@ int XmlReader::intAttribute(const char* s) const
 
 double XmlReader::doubleAttribute(const char* s) const
 {
-    return attributes().value(s).toDouble();
+    return attributes().value(QLatin1String(s)).toDouble();
 }
 
 double XmlReader::doubleAttribute(const char* s, double _default) const
 {
-    if (attributes().hasAttribute(s)) {
-        return attributes().value(s).toDouble();
+    const QXmlStreamAttributes a = attributes();
+    const QLatin1String n(s);
+    if (a.hasAttribute(n)) {
+        return a.value(n).toDouble();
     } else {
         return _default;
     }
@@ -82,8 +87,10 @@ double XmlReader::doubleAttribute(const char* s, double _default) const
 
 QString XmlReader::attribute(const char* s, const QString& _default) const
 {
-    if (attributes().hasAttribute(s)) {
-        return attributes().value(s).toString();
+    const QXmlStreamAttributes a = attributes();
+    const QLatin1String n(s);
+    if (a.hasAttribute(n)) {
+        return a.value(n).toString();
     } else {
         return _default;
     }
@@ -95,7 +102,45 @@ QString XmlReader::attribute(const char* s, const QString& _default) const
 
 bool XmlReader::hasAttribute(const char* s) const
 {
-    return attributes().hasAttribute(s);
+    return attributes().hasAttribute(QLatin1String(s));
+}
+
+//---------------------------------------------------------
+//   readText
+//    Same as readElementText() but collects the text into
+//    _textBuffer which keeps its capacity between calls.
+//    Used by the number parsing helpers, which previously
+//    allocated a temporary QString for every element read.
+//    The returned reference is valid until the next call.
+//---------------------------------------------------------
+
+const QString& XmlReader::readText()
+{
+    _textBuffer.resize(0);
+    if (!isStartElement()) {
+        return _textBuffer;
+    }
+    for (;;) {
+        switch (readNext()) {
+        case QXmlStreamReader::Characters:
+        case QXmlStreamReader::EntityReference:
+            _textBuffer.append(text());
+            break;
+        case QXmlStreamReader::EndElement:
+            return _textBuffer;
+        case QXmlStreamReader::ProcessingInstruction:
+        case QXmlStreamReader::Comment:
+            break;
+        case QXmlStreamReader::StartElement:
+            raiseError(QStringLiteral("Expected character data."));
+            return _textBuffer;
+        default:
+            if (atEnd() || hasError()) {
+                return _textBuffer;
+            }
+            break;
+        }
+    }
 }
 
 //---------------------------------------------------------
@@ -183,16 +228,16 @@ QRectF XmlReader::readRect()
 Fraction XmlReader::readFraction()
 {
     Q_ASSERT(tokenType() == QXmlStreamReader::StartElement);
-    int z = attribute("z", "0").toInt();
-    int n = attribute("n", "1").toInt();
-    const QString& s(readElementText());
+    int z = intAttribute("z", 0);
+    int n = intAttribute("n", 1);
+    const QString& s(readText());
     if (!s.isEmpty()) {
         int i = s.indexOf('/');
         if (i == -1) {
             return Fraction::fromTicks(s.toInt());
         } else {
-            z = s.left(i).toInt();
-            n = s.mid(i + 1).toInt();
+            z = s.leftRef(i).toInt();
+            n = s.midRef(i + 1).toInt();
         }
     }
     return Fraction(z, n);
@@ -304,7 +349,7 @@ void XmlReader::addTuplet(Tuplet* s)
 
 double XmlReader::readDouble(double min, double max)
 {
-    double val = readElementText().toDouble();
+    double val = readText().toDouble();
     if (val < min) {
         val = min;
     } else if (val > max) {
@@ -26,6 +26,10 @@ namespace mu::notation {
 class AbstractNotationWriter : public INotationWriter
 {
 public:
+    //! NOTE Writes the pages one after another with OptionKey::PAGE_NUMBER
+    Ret writePages(const INotationPtr notation, const std::vector<system::IODevice*>& destinationDevices,
+                   const Options& options = Options()) override;
+
     void abort() override;
     framework::ProgressChannel progress() const override;
 
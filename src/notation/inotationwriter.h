@@ -20,6 +20,8 @@
 #ifndef MU_NOTATION_INOTATIONWRITER_H
 #define MU_NOTATION_INOTATIONWRITER_H
 
+#include <vector>
+
 #include "ret.h"
 #include "val.h"
 
@@ -44,6 +46,11 @@ public:
     virtual ~INotationWriter() = default;
 
     virtual Ret write(const INotationPtr notation, system::IODevice& destinationDevice, const Options& options = Options()) = 0;
+
+    //! Writes every page of the notation into its own device, in page order.
+    //! The number of devices must be the number of pages.
+    virtual Ret writePages(const INotationPtr notation, const std::vector<system::IODevice*>& destinationDevices,
+                           const Options& options = Options()) = 0;
     virtual void abort() = 0;
     virtual framework::ProgressChannel progress() const = 0;
 };
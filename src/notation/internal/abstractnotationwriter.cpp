@@ -24,6 +24,20 @@
 using namespace mu::notation;
 using namespace mu::framework;
 
+mu::Ret AbstractNotationWriter::writePages(const INotationPtr notation, const std::vector<system::IODevice*>& destinationDevices,
+                                          const Options& options)
+{
+    Options pageOptions = options;
+    for (size_t i = 0; i < destinationDevices.size(); ++i) {
+        pageOptions[OptionKey::PAGE_NUMBER] = Val(static_cast<int>(i));
+        Ret ret = write(notation, *destinationDevices[i], pageOptions);
+        if (!ret) {
+            return ret;
+        }
+    }
+    return make_ret(Ret::Code::Ok);
+}
+
 void AbstractNotationWriter::abort()
 {
     NOT_IMPLEMENTED;
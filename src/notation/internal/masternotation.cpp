@@ -510,19 +510,52 @@ mu::Ret MasterNotation::save(const mu::io::path& path)
         return exportScore(path, suffix);
     }
 
+    finishSave();
+
     if (!path.empty()) {
         score()->masterScore()->fileInfo()->setFile(path.toQString());
     }
 
-    bool ok = score()->masterScore()->saveFile(true);
-    if (!ok) {
+    //! NOTE Only the serialization and the thumbnail need the score. The file is
+    //! compressed and written on a worker thread while the score can be edited,
+    //! the save is finished on the main thread when the write is done.
+    std::shared_ptr<Ms::FileSaveData> data = std::make_shared<Ms::FileSaveData>();
+    if (!score()->masterScore()->prepareSaveFile(*data, true)) {
         LOGE() << Ms::MScore::lastError;
+        return false;
+    }
+
+    std::weak_ptr<MasterNotation> weakThis = shared_from_this();
+    framework::Invoker* invoker = &m_saveInvoker;
+    m_saveData = data;
+    m_saving = std::async(std::launch::async, [data, weakThis, invoker]() {
+        bool ok = Ms::MasterScore::writeSaveFile(*data);
+        invoker->invoke([weakThis]() {
+            if (std::shared_ptr<MasterNotation> self = weakThis.lock()) {
+                self->finishSave();
+            }
+        });
+        return ok;
+    });
+
+    return make_ret(Err::NoError);
+}
+
+void MasterNotation::finishSave()
+{
+    if (!m_saving.valid()) {
+        return;
+    }
+
+    bool ok = m_saving.get();
+    if (!ok) {
+        LOGE() << m_saveData->error;
     } else {
+        score()->masterScore()->finishSaveFile(*m_saveData);
         score()->setCreated(false);
         undoStack()->stackChanged().notify();
     }
-
-    return ok;
+    m_saveData.reset();
 }
 
 mu::Ret MasterNotation::exportScore(const io::path& path, const std::string& suffix)
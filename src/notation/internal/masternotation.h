@@ -20,6 +20,7 @@
 #define MU_NOTATION_MASTERNOTATION_H
 
 #include <memory>
+#include <future>
 
 #include "../imasternotation.h"
 #include "../inotationreadersregister.h"
@@ -28,9 +29,11 @@
 #include "modularity/ioc.h"
 #include "notation.h"
 #include "retval.h"
+#include "invoker.h"
 
 namespace Ms {
 class MasterScore;
+struct FileSaveData;
 }
 
 namespace mu::notation {
@@ -61,6 +64,7 @@ public:
 
 private:
     Ret exportScore(const io::path& path, const std::string& suffix);
+    void finishSave();
 
     Ms::MasterScore* masterScore() const;
 
@@ -79,6 +83,10 @@ private:
 
     ValCh<ExcerptNotationList> m_excerpts;
     INotationPartsPtr m_parts;
+
+    framework::Invoker m_saveInvoker;
+    std::shared_ptr<Ms::FileSaveData> m_saveData;
+    std::future<bool> m_saving;   // destroyed first, waits for the write
 };
 }
 
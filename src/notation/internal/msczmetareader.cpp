@@ -324,16 +324,16 @@ io::path MsczMetaReader::readRootFile(MQZipReader* zipReader) const
     return rootFile;
 }
 
-QPixmap MsczMetaReader::loadThumbnail(MQZipReader* zipReader) const
+QImage MsczMetaReader::loadThumbnail(MQZipReader* zipReader) const
 {
     QByteArray thumbnailBuffer = zipReader->fileData("Thumbnails/thumbnail.png");
 
     if (thumbnailBuffer.isEmpty()) {
         LOGD() << "Can't find thumbnail";
-        return QPixmap();
+        return QImage();
     }
 
-    QPixmap thumbnail;
+    QImage thumbnail;
     thumbnail.loadFromData(thumbnailBuffer, "PNG");
 
     return thumbnail;
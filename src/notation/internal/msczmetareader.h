@@ -64,7 +64,7 @@ private:
     RawMeta doReadBox(framework::XmlReader& xmlReader) const;
     RetVal<Meta> loadCompressedMsc(const io::path& filePath) const;
     io::path readRootFile(MQZipReader* zipReader) const;
-    QPixmap loadThumbnail(MQZipReader* zipReader) const;
+    QImage loadThumbnail(MQZipReader* zipReader) const;
     RawMeta doReadRawMeta(framework::XmlReader& xmlReader) const;
     QString formatFromXml(const std::string& xml) const;
 
@@ -87,7 +87,7 @@ Notation::Notation(Ms::Score* score)
     m_accessibility = std::make_shared<NotationAccessibility>(this, m_interaction->selectionChanged());
     m_parts = std::make_shared<NotationParts>(this, m_interaction, m_undoStack);
     m_style = std::make_shared<NotationStyle>(this);
-    m_elements = std::make_shared<NotationElements>(this);
+    m_elements = std::make_shared<NotationElements>(this, m_notationChanged);
 
     m_interaction->noteInput()->noteAdded().onNotify(this, [this]() {
         notifyAboutNotationChanged();
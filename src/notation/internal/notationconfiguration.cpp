@@ -65,6 +65,8 @@ static const Settings::Key NAVIGATOR_VISIBLE_KEY(module_name, "ui/application/st
 static const Settings::Key NAVIGATOR_ORIENTATION(module_name, "ui/canvas/scroll/verticalOrientation");
 static const bool NAVIGATOR_ORIENTATION_VERTICAL(true);
 
+static const Settings::Key UNDO_MEMORY_LIMIT(module_name, "application/undo/memoryLimitMB");
+
 void NotationConfiguration::init()
 {
     settings()->setDefaultValue(ANCHORLINE_COLOR, Val(QColor("#C31989")));
@@ -110,8 +112,14 @@ void NotationConfiguration::init()
         m_navigatorOrientationChanged.send(navigatorOrientation().val);
     });
 
+    settings()->setDefaultValue(UNDO_MEMORY_LIMIT, Val(0));
+    settings()->valueChanged(UNDO_MEMORY_LIMIT).onReceive(nullptr, [](const Val& val) {
+        Ms::MScore::undoMemoryLimit = size_t(qMax(val.toInt(), 0)) * 1024 * 1024;
+    });
+
     // libmscore
     preferences().setBackupDirPath(globalConfiguration()->backupPath().toQString());
+    Ms::MScore::undoMemoryLimit = size_t(qMax(settings()->value(UNDO_MEMORY_LIMIT).toInt(), 0)) * 1024 * 1024;
 }
 
 QColor NotationConfiguration::anchorLineColor() const
@@ -27,9 +27,12 @@
 
 using namespace mu::notation;
 
-NotationElements::NotationElements(IGetScore* getScore)
+NotationElements::NotationElements(IGetScore* getScore, async::Notification notationChanged)
     : m_getScore(getScore)
 {
+    notationChanged.onNotify(this, [this]() {
+        m_rehearsalMarksIndexValid = false;
+    });
 }
 
 Ms::Score* NotationElements::msScore() const
@@ -92,7 +95,25 @@ std::vector<Element*> NotationElements::elements(const FilterElementsOptions& el
 
 Ms::RehearsalMark* NotationElements::rehearsalMark(const std::string& name) const
 {
-    QString qname = QString::fromStdString(name).toLower();
+    if (!m_rehearsalMarksIndexValid) {
+        buildRehearsalMarksIndex();
+    }
+
+    //! NOTE The first matching mark in the score
+    Ms::RehearsalMark* result = nullptr;
+    for (Ms::RehearsalMark* rehearsalMark : m_rehearsalMarksIndex.findStartingWith(QString::fromStdString(name))) {
+        if (!result || rehearsalMark->tick() < result->tick()
+            || (rehearsalMark->tick() == result->tick() && rehearsalMark->track() < result->track())) {
+            result = rehearsalMark;
+        }
+    }
+
+    return result;
+}
+
+void NotationElements::buildRehearsalMarksIndex() const
+{
+    m_rehearsalMarksIndex.clear();
 
     for (Ms::Segment* segment = score()->firstSegment(Ms::SegmentType::ChordRest); segment;
          segment = segment->next1(Ms::SegmentType::ChordRest)) {
@@ -102,14 +123,11 @@ Ms::RehearsalMark* NotationElements::rehearsalMark(const std::string& name) cons
             }
 
             Ms::RehearsalMark* rehearsalMark = static_cast<Ms::RehearsalMark*>(element);
-            QString rehearsalMarkName = rehearsalMark->plainText().toLower();
-            if (rehearsalMarkName.startsWith(qname)) {
-                return rehearsalMark;
-            }
+            m_rehearsalMarksIndex.insert(rehearsalMark, { rehearsalMark->plainText() });
         }
     }
 
-    return nullptr;
+    m_rehearsalMarksIndexValid = true;
 }
 
 Ms::Measure* NotationElements::measure(const int measureIndex) const
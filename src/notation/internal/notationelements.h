@@ -19,12 +19,15 @@
 
 #include "inotationelements.h"
 #include "igetscore.h"
+#include "async/asyncable.h"
+#include "async/notification.h"
+#include "searchindex.h"
 
 namespace mu::notation {
-class NotationElements : public INotationElements
+class NotationElements : public INotationElements, public async::Asyncable
 {
 public:
-    NotationElements(IGetScore* getScore);
+    NotationElements(IGetScore* getScore, async::Notification notationChanged);
 
     Ms::Score* msScore() const override;
 
@@ -38,6 +41,7 @@ private:
     Ms::Score* score() const;
 
     Ms::RehearsalMark* rehearsalMark(const std::string& name) const;
+    void buildRehearsalMarksIndex() const;
     Ms::Page* page(const int pageIndex) const;
 
     std::vector<Element*> allScoreElements() const;
@@ -49,6 +53,10 @@ private:
     Ms::NotePattern* constructNotePattern(const FilterNotesOptions* notesOptions) const;
 
     IGetScore* m_getScore = nullptr;
+
+    //! NOTE Built on the first search after a change of the notation
+    mutable SearchIndex<Ms::RehearsalMark*> m_rehearsalMarksIndex;
+    mutable bool m_rehearsalMarksIndexValid = false;
 };
 }
 
@@ -24,6 +24,7 @@
 
 #include "libmscore/rendermidi.h"
 #include "libmscore/score.h"
+#include "libmscore/scoresnapshot.h"
 #include "libmscore/tempo.h"
 #include "libmscore/part.h"
 #include "libmscore/instrument.h"
@@ -69,6 +70,10 @@ void NotationPlayback::init()
     m_midiRenderer = std::unique_ptr<Ms::MidiRenderer>(new Ms::MidiRenderer(score));
     m_midiRenderer->setMinChunkSize(MIN_CHUNK_SIZE);
 
+    //! NOTE The playback position is converted on position updates of the sequencer,
+    //! the snapshot of the tempo map and repeats can be read there while the score is being edited
+    score->masterScore()->setSnapshotsEnabled(true);
+
     QObject::connect(score, &Ms::Score::posChanged, [this](Ms::POS pos, int tick) {
         if (Ms::POS::CURRENT == pos) {
             m_playPositionTickChanged.send(tick);
@@ -249,6 +254,11 @@ float NotationPlayback::tickToSec(int tick) const
         return 0.0f;
     }
 
+    std::shared_ptr<const Ms::ScoreSnapshot> snapshot = score->masterScore()->snapshot();
+    if (snapshot) {
+        return snapshot->utick2utime(tick);
+    }
+
     return score->utick2utime(tick);
 }
 
@@ -259,6 +269,11 @@ int NotationPlayback::secToTick(float sec) const
         return 0;
     }
 
+    std::shared_ptr<const Ms::ScoreSnapshot> snapshot = score->masterScore()->snapshot();
+    if (snapshot) {
+        return snapshot->utime2utick(sec);
+    }
+
     return score->utime2utick(sec);
 }
 
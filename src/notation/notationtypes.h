@@ -19,7 +19,7 @@
 #ifndef MU_NOTATION_NOTATIONTYPES_H
 #define MU_NOTATION_NOTATIONTYPES_H
 
-#include <QPixmap>
+#include <QImage>
 #include <QDate>
 
 #include "io/path.h"
@@ -182,7 +182,7 @@ struct Meta
     QString translator;
     QString arranger;
     size_t partsCount = 0;
-    QPixmap thumbnail;
+    QImage thumbnail;
     QDate creationDate;
 
     QString source;
@@ -0,0 +1,42 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_NOTATION_NOTATIONELEMENTSMOCK_H
+#define MU_NOTATION_NOTATIONELEMENTSMOCK_H
+
+#include <gmock/gmock.h>
+#include "notation/inotationelements.h"
+
+namespace mu {
+namespace notation {
+class NotationElementsMock : public INotationElements
+{
+public:
+    MOCK_METHOD(Ms::Score*, msScore, (), (const, override));
+
+    MOCK_METHOD(Element*, search, (const std::string&), (const, override));
+    MOCK_METHOD(std::vector<Element*>, elements, (const FilterElementsOptions&), (const, override));
+
+    MOCK_METHOD(Measure*, measure, (const int), (const, override));
+
+    MOCK_METHOD(PageList, pages, (), (const, override));
+};
+}
+}
+
+#endif // MU_NOTATION_NOTATIONELEMENTSMOCK_H
@@ -0,0 +1,57 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_NOTATION_NOTATIONMOCK_H
+#define MU_NOTATION_NOTATIONMOCK_H
+
+#include <gmock/gmock.h>
+#include "notation/inotation.h"
+
+namespace mu {
+namespace notation {
+class NotationMock : public INotation
+{
+public:
+    MOCK_METHOD(Meta, metaInfo, (), (const, override));
+    MOCK_METHOD(void, setMetaInfo, (const Meta&), (override));
+
+    MOCK_METHOD(INotationPtr, clone, (), (const, override));
+
+    MOCK_METHOD(void, setViewSize, (const QSizeF&), (override));
+    MOCK_METHOD(void, setViewMode, (const ViewMode&), (override));
+    MOCK_METHOD(ViewMode, viewMode, (), (const, override));
+    MOCK_METHOD(void, paint, (QPainter*, const QRectF&), (override));
+
+    MOCK_METHOD(ValCh<bool>, opened, (), (const, override));
+    MOCK_METHOD(void, setOpened, (bool), (override));
+
+    MOCK_METHOD(INotationInteractionPtr, interaction, (), (const, override));
+    MOCK_METHOD(INotationMidiInputPtr, midiInput, (), (const, override));
+    MOCK_METHOD(INotationUndoStackPtr, undoStack, (), (const, override));
+    MOCK_METHOD(INotationStylePtr, style, (), (const, override));
+    MOCK_METHOD(INotationPlaybackPtr, playback, (), (const, override));
+    MOCK_METHOD(INotationElementsPtr, elements, (), (const, override));
+    MOCK_METHOD(INotationAccessibilityPtr, accessibility, (), (const, override));
+    MOCK_METHOD(INotationPartsPtr, parts, (), (const, override));
+
+    MOCK_METHOD(async::Notification, notationChanged, (), (const, override));
+};
+}
+}
+
+#endif // MU_NOTATION_NOTATIONMOCK_H
@@ -52,6 +52,7 @@
 #include "libmscore/slur.h"
 #include "libmscore/fret.h"
 
+#include "log.h"
 #include "translation.h"
 
 #include "widgetstatestore.h"
@@ -847,9 +848,10 @@ void Palette::paintPaletteElement(void* data, Element* element)
 
 void Palette::paintEvent(QPaintEvent* /*event*/)
 {
+    TRACEFUNC;
+
     qreal _spatium = gscore->spatium();
     qreal magS     = PALETTE_SPATIUM * extraMag * paletteScaling();
-    qreal mag      = magS / _spatium;
     gscore->setSpatium(SPATIUM20);
 
     QPainter p(this);
@@ -882,8 +884,6 @@ void Palette::paintEvent(QPaintEvent* /*event*/)
         }
     }
 
-    qreal dy = lrint(2 * magS);
-
     //
     // draw symbols
     //
@@ -891,9 +891,7 @@ void Palette::paintEvent(QPaintEvent* /*event*/)
     pen.setWidthF(MScore::defaultStyle().value(Sid::staffLineWidth).toDouble() * magS);
 
     for (int idx = 0; idx < ccp()->size(); ++idx) {
-        int yoffset  = gscore->spatium() * _yOffset;
         QRect r      = idxRect(idx);
-        QRect rShift = r.translated(0, yoffset);
         p.setPen(pen);
         QColor c(configuration()->accentColor());
 
@@ -913,85 +911,111 @@ void Palette::paintEvent(QPaintEvent* /*event*/)
         }
         PaletteCell* cc = ccp()->at(idx);          // current cell
 
-        QString tag = cc->tag;
-        if (!tag.isEmpty()) {
-            p.setPen(configuration()->gridColor());
-            QFont f(p.font());
-            f.setPointSize(12);
-            p.setFont(f);
-            if (tag == "ShowMore") {
-                p.drawText(idxRect(idx), Qt::AlignCenter, "???");
+        QColor color;
+        if (idx != selectedIdx) {
+            // show voice colors for notes
+            if (cc->element && cc->element->isChord()) {
+                color = cc->element->curColor();
             } else {
-                p.drawText(rShift, Qt::AlignLeft | Qt::AlignTop, tag);
-            }
-        }
-
-        p.setPen(pen);
-
-        Element* el = cc->element.get();
-        if (el == 0) {
-            continue;
-        }
-        bool drawStaff = cc->drawStaff;
-        int row    = idx / columns();
-        int column = idx % columns();
-
-        qreal cellMag = cc->mag * mag;
-        if (el->isIcon()) {
-            toIcon(el)->setExtent((hhgrid < vgridM ? hhgrid : vgridM) - 4);
-            cellMag = 1.0;
-        }
-        el->layout();
-
-        if (drawStaff) {
-            qreal y = r.y() + vgridM * .5 - dy + _yOffset * _spatium * cellMag;
-            qreal x = r.x() + 3;
-            qreal w = hhgrid - 6;
-            for (int i = 0; i < 5; ++i) {
-                qreal yy = y + i * magS;
-                p.setPen(configuration()->elementsColor());
-                p.drawLine(QLineF(x, yy, x + w, yy));
+                color = palette().color(QPalette::Normal, QPalette::Text);
             }
+        } else {
+            color = palette().color(QPalette::Normal, QPalette::HighlightedText);
         }
-        p.save();
-        p.scale(cellMag, cellMag);
 
-        double gw = hhgrid / cellMag;
-        double gh = vgridM / cellMag;
-        double gx = column * gw + cc->xoffset * _spatium;
-        double gy = row * gh + cc->yoffset * _spatium;
+        // the cell content is rendered once in cell coordinates and then
+        // only copied as long as nothing that affects it changes
+        const QString key = QString("palette|%1|%2|%3|%4|%5|%6|%7|%8|%9")
+                            .arg(_spatium).arg(magS).arg(cc->mag).arg(cc->xoffset).arg(cc->yoffset)
+                            .arg(_yOffset).arg(cc->drawStaff).arg(cc->tag)
+                            .arg(QString("%1|%2|%3").arg(color.rgba()).arg(pen.color().rgba()).arg(pen.widthF()));
+        const QRect cellRect(QPoint(0, 0), r.size());
+        const QImage& image = cc->cachedImage(key, r.size(), devicePixelRatioF(), [&](QPainter& cellPainter) {
+            paintCellContent(cellPainter, cc, cellRect, pen, color, _spatium, magS);
+        });
+        p.drawImage(r.topLeft(), image);
+    }
+}
 
-        double sw = el->width();
-        double sh = el->height();
-        double sy;
+//---------------------------------------------------------
+//   paintCellContent
+///   paint tag, staff and element of a cell into r
+//---------------------------------------------------------
 
-        if (drawStaff) {
-            sy = gy + gh * .5 - 2.0 * _spatium;
+void Palette::paintCellContent(QPainter& p, const PaletteCell* cc, const QRect& r, const QPen& pen, const QColor& color,
+                               qreal _spatium, qreal magS) const
+{
+    qreal mag    = magS / _spatium;
+    int hhgrid   = r.width();
+    int vgridM   = r.height();
+    qreal dy     = lrint(2 * magS);
+    int yoffset  = gscore->spatium() * _yOffset;
+    QRect rShift = r.translated(0, yoffset);
+
+    QString tag = cc->tag;
+    if (!tag.isEmpty()) {
+        p.setPen(configuration()->gridColor());
+        QFont f(p.font());
+        f.setPointSize(12);
+        p.setFont(f);
+        if (tag == "ShowMore") {
+            p.drawText(r, Qt::AlignCenter, "???");
         } else {
-            sy  = gy + (gh - sh) * .5 - el->bbox().y();
+            p.drawText(rShift, Qt::AlignLeft | Qt::AlignTop, tag);
         }
-        double sx  = gx + (gw - sw) * .5 - el->bbox().x();
+    }
 
-        sy += _yOffset * _spatium;
+    p.setPen(pen);
 
-        p.translate(sx, sy);
+    Element* el = cc->element.get();
+    if (el == 0) {
+        return;
+    }
+    bool drawStaff = cc->drawStaff;
 
-        QColor color;
-        if (idx != selectedIdx) {
-            // show voice colors for notes
-            if (el->isChord()) {
-                color = el->curColor();
-            } else {
-                color = palette().color(QPalette::Normal, QPalette::Text);
-            }
-        } else {
-            color = palette().color(QPalette::Normal, QPalette::HighlightedText);
+    qreal cellMag = cc->mag * mag;
+    if (el->isIcon()) {
+        toIcon(el)->setExtent((hhgrid < vgridM ? hhgrid : vgridM) - 4);
+        cellMag = 1.0;
+    }
+    el->layout();
+
+    if (drawStaff) {
+        qreal y = r.y() + vgridM * .5 - dy + _yOffset * _spatium * cellMag;
+        qreal x = r.x() + 3;
+        qreal w = hhgrid - 6;
+        for (int i = 0; i < 5; ++i) {
+            qreal yy = y + i * magS;
+            p.setPen(configuration()->elementsColor());
+            p.drawLine(QLineF(x, yy, x + w, yy));
         }
+    }
+    p.save();
+    p.scale(cellMag, cellMag);
+
+    double gw = hhgrid / cellMag;
+    double gh = vgridM / cellMag;
+    double gx = r.x() / cellMag + cc->xoffset * _spatium;
+    double gy = r.y() / cellMag + cc->yoffset * _spatium;
+
+    double sw = el->width();
+    double sh = el->height();
+    double sy;
 
-        p.setPen(QPen(color));
-        el->scanElements(&p, paintPaletteElement);
-        p.restore();
+    if (drawStaff) {
+        sy = gy + gh * .5 - 2.0 * _spatium;
+    } else {
+        sy  = gy + (gh - sh) * .5 - el->bbox().y();
     }
+    double sx  = gx + (gw - sw) * .5 - el->bbox().x();
+
+    sy += _yOffset * _spatium;
+
+    p.translate(sx, sy);
+
+    p.setPen(QPen(color));
+    el->scanElements(&p, paintPaletteElement);
+    p.restore();
 }
 
 //---------------------------------------------------------
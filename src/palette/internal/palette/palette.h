@@ -96,6 +96,8 @@ class Palette : public QWidget
     bool _showContextMenu { true };
 
     virtual void paintEvent(QPaintEvent*) override;
+    void paintCellContent(QPainter& p, const PaletteCell* cc, const QRect& r, const QPen& pen, const QColor& color,
+                          qreal spatium, qreal magS) const;
     virtual void mousePressEvent(QMouseEvent*) override;
     void mouseReleaseEvent(QMouseEvent* event) override;
     void mouseDoubleClickEvent(QMouseEvent*) override;
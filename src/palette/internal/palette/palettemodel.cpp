@@ -19,6 +19,8 @@
 
 #include "palettemodel.h"
 
+#include <algorithm>
+
 #include <QMimeData>
 
 #include "libmscore/beam.h"
@@ -48,6 +50,7 @@ PaletteTreeModel::PaletteTreeModel(PaletteTreePtr tree, QObject* parent)
     connect(this, &QAbstractItemModel::rowsRemoved, this, &PaletteTreeModel::setTreeChanged);
 
     configuration()->colorsChanged().onNotify(this, [this]() {
+        PaletteCell::invalidateCachedImages();
         notifyAboutCellsChanged(Qt::DecorationRole);
     });
 }
@@ -61,7 +64,7 @@ void PaletteTreeModel::onDataChanged(const QModelIndex& topLeft, const QModelInd
 {
     Q_UNUSED(topLeft);
     Q_UNUSED(bottomRight);
-    static const std::set<int> nonPersistentRoles({ CellActiveRole, PaletteExpandedRole });
+    static const std::set<int> nonPersistentRoles({ CellActiveRole, PaletteExpandedRole, Qt::ToolTipRole });
 
     bool treeChanged = false;
     for (int role : roles) {
@@ -909,6 +912,11 @@ void PaletteTreeModel::updateCellsState(const Selection& sel)
 void PaletteTreeModel::retranslate()
 {
     _paletteTree->retranslate();
+
+    if (rowCount() > 0) {
+        emit dataChanged(index(0, 0), index(rowCount() - 1, 0), { Qt::ToolTipRole });
+    }
+    notifyAboutCellsChanged(Qt::ToolTipRole);
 }
 
 //---------------------------------------------------------
@@ -1103,6 +1111,162 @@ PaletteCellFilterProxyModel::PaletteCellFilterProxyModel(QObject* parent)
     setFilterRole(Qt::ToolTipRole);   // palette cells have no data for DisplayRole
 }
 
+//---------------------------------------------------------
+//   PaletteCellFilterProxyModel::setSourceModel
+//---------------------------------------------------------
+
+void PaletteCellFilterProxyModel::setSourceModel(QAbstractItemModel* model)
+{
+    if (QAbstractItemModel* oldModel = sourceModel()) {
+        disconnect(oldModel, &QAbstractItemModel::rowsInserted, this, &PaletteCellFilterProxyModel::addToSearchIndex);
+        disconnect(oldModel, &QAbstractItemModel::rowsAboutToBeRemoved, this, &PaletteCellFilterProxyModel::removeFromSearchIndex);
+        disconnect(oldModel, &QAbstractItemModel::dataChanged, this, &PaletteCellFilterProxyModel::updateSearchIndex);
+        disconnect(oldModel, &QAbstractItemModel::modelReset, this, &PaletteCellFilterProxyModel::rebuildSearchIndex);
+    }
+
+    // connected before QSortFilterProxyModel connects to the model,
+    // so the index is up to date when the proxy filters new rows
+    if (model) {
+        connect(model, &QAbstractItemModel::rowsInserted, this, &PaletteCellFilterProxyModel::addToSearchIndex);
+        connect(model, &QAbstractItemModel::rowsAboutToBeRemoved, this, &PaletteCellFilterProxyModel::removeFromSearchIndex);
+        connect(model, &QAbstractItemModel::dataChanged, this, &PaletteCellFilterProxyModel::updateSearchIndex);
+        connect(model, &QAbstractItemModel::modelReset, this, &PaletteCellFilterProxyModel::rebuildSearchIndex);
+    }
+
+    QSortFilterProxyModel::setSourceModel(model);
+    rebuildSearchIndex();
+}
+
+//---------------------------------------------------------
+//   PaletteCellFilterProxyModel::searchTexts
+///   translated filter text, and the untranslated name
+///   of cells so that English names are found in any language
+//---------------------------------------------------------
+
+QStringList PaletteCellFilterProxyModel::searchTexts(const QModelIndex& sourceIndex) const
+{
+    QStringList texts { sourceModel()->data(sourceIndex, filterRole()).toString() };
+
+    const QVariant cellData = sourceModel()->data(sourceIndex, PaletteTreeModel::PaletteCellRole);
+    if (const PaletteCell* cell = cellData.value<const PaletteCell*>()) {
+        texts << cell->name;
+    }
+
+    return texts;
+}
+
+//---------------------------------------------------------
+//   PaletteCellFilterProxyModel::addToSearchIndex
+//---------------------------------------------------------
+
+void PaletteCellFilterProxyModel::addToSearchIndex(const QModelIndex& sourceParent, int first, int last)
+{
+    const QAbstractItemModel* model = sourceModel();
+    for (int row = first; row <= last; ++row) {
+        const QModelIndex rowIndex = model->index(row, 0, sourceParent);
+        searchIndex.insert(QPersistentModelIndex(rowIndex), searchTexts(rowIndex));
+
+        const int childCount = model->rowCount(rowIndex);
+        if (childCount > 0) {
+            addToSearchIndex(rowIndex, 0, childCount - 1);
+        }
+    }
+    searchMatchesValid = false;
+}
+
+//---------------------------------------------------------
+//   PaletteCellFilterProxyModel::removeFromSearchIndex
+//---------------------------------------------------------
+
+void PaletteCellFilterProxyModel::removeFromSearchIndex(const QModelIndex& sourceParent, int first, int last)
+{
+    const QAbstractItemModel* model = sourceModel();
+    for (int row = first; row <= last; ++row) {
+        const QModelIndex rowIndex = model->index(row, 0, sourceParent);
+
+        const int childCount = model->rowCount(rowIndex);
+        if (childCount > 0) {
+            removeFromSearchIndex(rowIndex, 0, childCount - 1);
+        }
+
+        searchIndex.remove(QPersistentModelIndex(rowIndex));
+    }
+    searchMatchesValid = false;
+}
+
+//---------------------------------------------------------
+//   PaletteCellFilterProxyModel::updateSearchIndex
+///   only changes of the searched texts matter, cells
+///   change e.g. their active state all the time
+//---------------------------------------------------------
+
+void PaletteCellFilterProxyModel::updateSearchIndex(const QModelIndex& topLeft, const QModelIndex& bottomRight,
+                                                    const QVector<int>& roles)
+{
+    if (!roles.empty()) {
+        const bool textChanged = std::any_of(roles.begin(), roles.end(), [this](int role) {
+            return role == filterRole() || role == Qt::DisplayRole || role == Qt::EditRole
+                   || role == PaletteTreeModel::PaletteCellRole;
+        });
+        if (!textChanged) {
+            return;
+        }
+    }
+
+    const QModelIndex parent = topLeft.parent();
+    for (int row = topLeft.row(); row <= bottomRight.row(); ++row) {
+        const QModelIndex rowIndex = sourceModel()->index(row, 0, parent);
+        searchIndex.insert(QPersistentModelIndex(rowIndex), searchTexts(rowIndex));
+    }
+    searchMatchesValid = false;
+}
+
+//---------------------------------------------------------
+//   PaletteCellFilterProxyModel::rebuildSearchIndex
+//---------------------------------------------------------
+
+void PaletteCellFilterProxyModel::rebuildSearchIndex()
+{
+    searchIndex.clear();
+    searchMatchesValid = false;
+
+    if (sourceModel() && sourceModel()->rowCount() > 0) {
+        addToSearchIndex(QModelIndex(), 0, sourceModel()->rowCount() - 1);
+    }
+}
+
+//---------------------------------------------------------
+//   PaletteCellFilterProxyModel::useSearchIndex
+///   the index covers the case insensitive fixed string
+///   filter used for palette search
+//---------------------------------------------------------
+
+bool PaletteCellFilterProxyModel::useSearchIndex() const
+{
+    return filterCaseSensitivity() == Qt::CaseInsensitive
+           && filterRegExp().patternSyntax() == QRegExp::FixedString;
+}
+
+//---------------------------------------------------------
+//   PaletteCellFilterProxyModel::acceptsIndex
+//---------------------------------------------------------
+
+bool PaletteCellFilterProxyModel::acceptsIndex(const QModelIndex& sourceIndex) const
+{
+    if (!useSearchIndex()) {
+        return QSortFilterProxyModel::filterAcceptsRow(sourceIndex.row(), sourceIndex.parent());
+    }
+
+    const QString query = filterRegExp().pattern();
+    if (!searchMatchesValid || query != searchMatchesQuery) {
+        searchMatches = searchIndex.findContaining(query);
+        searchMatchesQuery = query;
+        searchMatchesValid = true;
+    }
+
+    return searchMatches.contains(QPersistentModelIndex(sourceIndex));
+}
+
 //---------------------------------------------------------
 //   PaletteCellFilterProxyModel::filterAcceptsRow
 //---------------------------------------------------------
@@ -1114,12 +1278,11 @@ bool PaletteCellFilterProxyModel::filterAcceptsRow(int sourceRow, const QModelIn
     const int rowCount = model->rowCount(rowIndex);
 
     if (rowCount == 0) {
-        if (QSortFilterProxyModel::filterAcceptsRow(sourceRow, sourceParent)) {
+        if (acceptsIndex(rowIndex)) {
             return true;
         }
         // accept row if its parent is accepted by filter: necessary to be able to search by palette name
-        if (sourceParent.isValid()
-            && QSortFilterProxyModel::filterAcceptsRow(sourceParent.row(), sourceParent.parent())) {
+        if (sourceParent.isValid() && acceptsIndex(sourceParent)) {
             return true;
         }
         return false;
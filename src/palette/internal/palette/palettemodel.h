@@ -28,6 +28,7 @@
 #include "modularity/ioc.h"
 #include "ipaletteconfiguration.h"
 #include "async/asyncable.h"
+#include "searchindex.h"
 
 namespace Ms {
 class Selection;
@@ -220,9 +221,27 @@ public:
 class PaletteCellFilterProxyModel : public QSortFilterProxyModel
 {
     Q_OBJECT
+
+    // filter texts of all rows of the source model, kept up to date
+    // with the model so that filtering does not query and scan every row
+    mu::SearchIndex<QPersistentModelIndex> searchIndex;
+    mutable QSet<QPersistentModelIndex> searchMatches;
+    mutable QString searchMatchesQuery;
+    mutable bool searchMatchesValid = false;
+
+    bool useSearchIndex() const;
+    bool acceptsIndex(const QModelIndex& sourceIndex) const;
+
+    QStringList searchTexts(const QModelIndex& sourceIndex) const;
+    void addToSearchIndex(const QModelIndex& sourceParent, int first, int last);
+    void removeFromSearchIndex(const QModelIndex& sourceParent, int first, int last);
+    void updateSearchIndex(const QModelIndex& topLeft, const QModelIndex& bottomRight, const QVector<int>& roles);
+    void rebuildSearchIndex();
+
 public:
     PaletteCellFilterProxyModel(QObject* parent = nullptr);
 
+    void setSourceModel(QAbstractItemModel* model) override;
     bool filterAcceptsRow(int sourceRow, const QModelIndex& sourceParent) const override;
 };
 } // namespace Ms
@@ -17,9 +17,12 @@
 //  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
 //=============================================================================
 
+#include <algorithm>
+
 #include <QBuffer>
 #include <QAction>
 #include <QMetaEnum>
+#include <QPainter>
 
 #include "palette.h"
 #include "palettetree.h"
@@ -38,6 +41,7 @@
 
 #include "modularity/ioc.h"
 
+#include "log.h"
 #include "translation.h"
 
 #include "../palette_config.h"
@@ -128,6 +132,85 @@ QString PaletteCell::makeId()
     return QString::number(++id);
 }
 
+//---------------------------------------------------------
+//   PaletteCell::cachedImage
+///   Returns the cell content rendered by paint into an
+///   image of the given size. The image is rendered again
+///   only if the key (geometry, colors, ...) or the element
+///   of the cell changes, so repainting a palette is a blit.
+///   Consumers pass different keys and sizes, e.g. the
+///   palette widget and the icon engine, each of them
+///   gets an image of its own.
+//---------------------------------------------------------
+
+int PaletteCell::_cachedImagesGeneration = 0;
+
+const QImage& PaletteCell::cachedImage(const QString& key, const QSize& size, qreal dpr,
+                                       const std::function<void(QPainter&)>& paint) const
+{
+    const int generation = cachedImagesGeneration();
+    const QSize imageSize = size * dpr;
+
+    CachedImage* cached = nullptr;
+    for (CachedImage& c : _cachedImages) {
+        if (c.key == key && c.image.size() == imageSize && qFuzzyCompare(c.image.devicePixelRatioF(), dpr)) {
+            if (c.generation == generation && c.element.lock() == element) {
+                return c.image;
+            }
+            cached = &c;
+            break;
+        }
+    }
+
+    if (!cached) {
+        // drop images that are out of date anyway, then the oldest one
+        _cachedImages.erase(std::remove_if(_cachedImages.begin(), _cachedImages.end(), [generation](const CachedImage& c) {
+            return c.generation != generation;
+        }), _cachedImages.end());
+        if (_cachedImages.size() >= MAX_CACHED_IMAGES) {
+            _cachedImages.erase(_cachedImages.begin());
+        }
+        _cachedImages.emplace_back();
+        cached = &_cachedImages.back();
+        cached->key = key;
+    }
+
+    cached->image = QImage(imageSize, QImage::Format_ARGB32_Premultiplied);
+    cached->image.setDevicePixelRatio(dpr);
+    cached->image.fill(Qt::transparent);
+
+    QPainter p(&cached->image);
+    p.setRenderHint(QPainter::Antialiasing, true);
+    paint(p);
+    p.end();
+
+    cached->generation = generation;
+    cached->element = element;
+
+    return cached->image;
+}
+
+//---------------------------------------------------------
+//   PaletteCell::invalidateCachedImages
+///   e.g. after a change of colors
+//---------------------------------------------------------
+
+void PaletteCell::invalidateCachedImages()
+{
+    ++_cachedImagesGeneration;
+}
+
+//---------------------------------------------------------
+//   PaletteCell::cachedImagesGeneration
+///   images are also out of date after a change of the
+///   default style or of the available fonts
+//---------------------------------------------------------
+
+int PaletteCell::cachedImagesGeneration()
+{
+    return _cachedImagesGeneration + MScore::renderCacheGeneration();
+}
+
 //---------------------------------------------------------
 //   PaletteCell::translationContext
 //---------------------------------------------------------
@@ -1146,12 +1229,10 @@ void PaletteCellIconEngine::paintTag(QPainter& painter, const QRect& rect, QStri
 //   PaletteCellIconEngine::paintCell
 //---------------------------------------------------------
 
-void PaletteCellIconEngine::paintCell(QPainter& p, const QRect& r, bool selected, bool current) const
+void PaletteCellIconEngine::paintCell(QPainter& p, const QRect& r) const
 {
     const qreal _yOffset = 0.0;   // TODO
 
-    paintBackground(p, r, selected, current);
-
     if (!_cell) {
         return;
     }
@@ -1192,10 +1273,30 @@ void PaletteCellIconEngine::paintCell(QPainter& p, const QRect& r, bool selected
 
 void PaletteCellIconEngine::paint(QPainter* painter, const QRect& r, QIcon::Mode mode, QIcon::State state)
 {
+    TRACEFUNC;
+
     QPainter& p = *painter;
     p.save();   // so we can restore it later
     p.setRenderHint(QPainter::Antialiasing, true);
-    paintCell(p, r, mode == QIcon::Selected, state == QIcon::On);
+    paintBackground(p, r, mode == QIcon::Selected, state == QIcon::On);
+
+    if (_cell && r.isValid()) {
+        // the content does not depend on mode and state, it is rendered once
+        // and then only copied until something that affects it changes
+        const QString key = QString("icon|%1|%2|%3|%4|%5|%6|%7|%8")
+                            .arg(_extraMag).arg(_cell->mag).arg(_cell->xoffset).arg(_cell->yoffset)
+                            .arg(_cell->drawStaff).arg(_cell->tag)
+                            .arg(configuration()->elementsColor().rgba())
+                            .arg(MScore::defaultStyle().value(Sid::staffLineWidth).toDouble());
+        const qreal dpr = painter->device() ? painter->device()->devicePixelRatioF() : 1.0;
+        const QRect cellRect(QPoint(0, 0), r.size());
+
+        const QImage& image = _cell->cachedImage(key, r.size(), dpr, [this, cellRect](QPainter& cellPainter) {
+            paintCell(cellPainter, cellRect);
+        });
+        p.drawImage(r.topLeft(), image);
+    }
+
     p.restore();   // return painter to saved initial state (undo any changes to pen, coordinates, font, etc.)
 }
 } // namespace Ms
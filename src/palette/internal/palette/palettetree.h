@@ -20,7 +20,11 @@
 #ifndef __PALETTETREE_H__
 #define __PALETTETREE_H__
 
+#include <functional>
+#include <vector>
+
 #include <QIconEngine>
+#include <QImage>
 
 #include "libmscore/element.h"
 #include "libmscore/xml.h"
@@ -77,6 +81,25 @@ struct PaletteCell
     static PaletteCellPtr readMimeData(const QByteArray& data);
     static PaletteCellPtr readElementMimeData(const QByteArray& data);
     static QString makeId();
+
+    const QImage& cachedImage(const QString& key, const QSize& size, qreal dpr,
+                              const std::function<void(QPainter&)>& paint) const;
+    static void invalidateCachedImages();
+
+private:
+    struct CachedImage {
+        QString key;
+        QImage image;
+        std::weak_ptr<Element> element;
+        int generation { 0 };
+    };
+
+    static constexpr size_t MAX_CACHED_IMAGES = 4;
+
+    mutable std::vector<CachedImage> _cachedImages;   // one per consumer and size
+    static int _cachedImagesGeneration;
+
+    static int cachedImagesGeneration();
 };
 
 //---------------------------------------------------------
@@ -93,7 +116,7 @@ class PaletteCellIconEngine : public QIconEngine
     INJECT_STATIC(palette, mu::palette::IPaletteConfiguration, configuration)
 
 private:
-    void paintCell(QPainter& p, const QRect& r, bool selected, bool current) const;
+    void paintCell(QPainter& p, const QRect& r) const;
     void paintScoreElement(QPainter& p, Element* e, qreal spatium, bool alignToStaff) const;
 
     static qreal paintStaff(QPainter& p, const QRect& rect, qreal spatium);
@@ -26,6 +26,7 @@ class InstrumentsConfigurationStub : public IInstrumentsConfiguration
 {
 public:
     io::paths instrumentPaths() const override;
+    io::path instrumentsCachePath() const override;
 };
 }
 
@@ -45,6 +45,16 @@ io::path UserScoresConfigurationStub::defaultSavingFilePath(const std::string&)
     return io::path();
 }
 
+io::path UserScoresConfigurationStub::recentScoresMetaCachePath() const
+{
+    return io::path();
+}
+
+io::path UserScoresConfigurationStub::templatesMetaCachePath() const
+{
+    return io::path();
+}
+
 QColor UserScoresConfigurationStub::templatePreviewBackgroundColor() const
 {
     return QColor();
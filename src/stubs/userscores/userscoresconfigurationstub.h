@@ -32,6 +32,9 @@ public:
     io::path scoresPath() const override;
     io::path defaultSavingFilePath(const std::string& fileName) const override;
 
+    io::path recentScoresMetaCachePath() const override;
+    io::path templatesMetaCachePath() const override;
+
     QColor templatePreviewBackgroundColor() const override;
     async::Channel<QColor> templatePreviewBackgroundColorChanged() const override;
 };
@@ -0,0 +1,189 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#include "scoresmetacache.h"
+
+#include <QDataStream>
+#include <QDateTime>
+#include <QFile>
+#include <QFileInfo>
+#include <QSaveFile>
+
+#include "log.h"
+
+using namespace mu;
+using namespace mu::notation;
+using namespace mu::userscores;
+
+static constexpr quint32 CACHE_MAGIC = 0x4d534d43;   // "MSMC"
+static constexpr quint32 CACHE_VERSION = 1;
+
+namespace {
+void writeCachedMeta(QDataStream& out, const Meta& meta)
+{
+    out << meta.fileName << meta.filePath << meta.title << meta.subtitle << meta.composer
+        << meta.lyricist << meta.copyright << meta.translator << meta.arranger
+        << quint64(meta.partsCount) << meta.thumbnail << meta.creationDate
+        << meta.source << meta.platform << meta.musescoreVersion
+        << qint32(meta.musescoreRevision) << qint32(meta.mscVersion) << meta.additionalTags;
+}
+
+Meta readCachedMeta(QDataStream& in)
+{
+    Meta meta;
+    quint64 partsCount = 0;
+    qint32 revision = 0;
+    qint32 mscVersion = 0;
+
+    in >> meta.fileName >> meta.filePath >> meta.title >> meta.subtitle >> meta.composer
+    >> meta.lyricist >> meta.copyright >> meta.translator >> meta.arranger
+    >> partsCount >> meta.thumbnail >> meta.creationDate
+    >> meta.source >> meta.platform >> meta.musescoreVersion
+    >> revision >> mscVersion >> meta.additionalTags;
+
+    meta.partsCount = partsCount;
+    meta.musescoreRevision = revision;
+    meta.mscVersion = mscVersion;
+    return meta;
+}
+}
+
+ScoresMetaCache::ScoresMetaCache(const io::path& cachePath)
+    : m_cachePath(cachePath)
+{
+}
+
+//! NOTE Must be called with m_mutex locked
+void ScoresMetaCache::loadIfNeed()
+{
+    if (m_loaded) {
+        return;
+    }
+    m_loaded = true;
+
+    QFile file(m_cachePath.toQString());
+    if (!file.open(QIODevice::ReadOnly)) {
+        return;
+    }
+
+    QDataStream in(&file);
+    in.setVersion(QDataStream::Qt_5_12);
+
+    quint32 magic = 0;
+    quint32 version = 0;
+    in >> magic >> version;
+    if (magic != CACHE_MAGIC || version != CACHE_VERSION) {
+        LOGD() << "outdated scores meta cache: " << m_cachePath;
+        return;
+    }
+
+    QHash<QString, Entry> entries;
+    qint32 count = 0;
+    in >> count;
+    for (qint32 i = 0; i < count && in.status() == QDataStream::Ok; ++i) {
+        QString path;
+        Entry entry;
+        in >> path >> entry.size >> entry.modified;
+        entry.meta = readCachedMeta(in);
+        entries.insert(path, entry);
+    }
+
+    if (in.status() != QDataStream::Ok) {
+        LOGW() << "corrupted scores meta cache: " << m_cachePath;
+        return;
+    }
+
+    m_entries = entries;
+}
+
+Ret ScoresMetaCache::save()
+{
+    QMutexLocker lock(&m_mutex);
+
+    //! NOTE Entries not requested since load belong to files
+    //! that are gone from the list, they are dropped
+    if (m_cachePath.empty() || (!m_changed && m_used.size() == m_entries.size())) {
+        return make_ret(Ret::Code::Ok);
+    }
+
+    QSaveFile file(m_cachePath.toQString());
+    if (!file.open(QIODevice::WriteOnly)) {
+        LOGE() << "failed open file: " << m_cachePath;
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    QDataStream out(&file);
+    out.setVersion(QDataStream::Qt_5_12);
+    out << CACHE_MAGIC << CACHE_VERSION << qint32(m_used.size());
+    for (const QString& path : m_used) {
+        const Entry entry = m_entries.value(path);
+        out << path << entry.size << entry.modified;
+        writeCachedMeta(out, entry.meta);
+    }
+
+    if (out.status() != QDataStream::Ok || !file.commit()) {
+        LOGE() << "failed write scores meta cache: " << m_cachePath;
+        return make_ret(Ret::Code::UnknownError);
+    }
+
+    for (auto it = m_entries.begin(); it != m_entries.end();) {
+        if (m_used.contains(it.key())) {
+            ++it;
+        } else {
+            it = m_entries.erase(it);
+        }
+    }
+    m_changed = false;
+
+    return make_ret(Ret::Code::Ok);
+}
+
+RetVal<Meta> ScoresMetaCache::readMeta(const io::path& filePath, IMsczMetaReader* reader)
+{
+    QFileInfo info(filePath.toQString());
+    if (m_cachePath.empty() || !info.exists()) {
+        return reader->readMeta(filePath);
+    }
+
+    QString key = info.absoluteFilePath();
+    qint64 size = info.size();
+    qint64 modified = info.lastModified().toMSecsSinceEpoch();
+
+    {
+        QMutexLocker lock(&m_mutex);
+        loadIfNeed();
+
+        auto it = m_entries.constFind(key);
+        if (it != m_entries.constEnd() && it->size == size && it->modified == modified) {
+            m_used.insert(key);
+            return RetVal<Meta>::make_ok(it->meta);
+        }
+    }
+
+    RetVal<Meta> meta = reader->readMeta(filePath);
+    if (!meta.ret) {
+        return meta;
+    }
+
+    QMutexLocker lock(&m_mutex);
+    m_entries.insert(key, { size, modified, meta.val });
+    m_used.insert(key);
+    m_changed = true;
+
+    return meta;
+}
@@ -0,0 +1,63 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+#ifndef MU_USERSCORES_SCORESMETACACHE_H
+#define MU_USERSCORES_SCORESMETACACHE_H
+
+#include <QHash>
+#include <QMutex>
+#include <QSet>
+
+#include "retval.h"
+#include "io/path.h"
+#include "notation/notationtypes.h"
+#include "notation/imsczmetareader.h"
+
+namespace mu::userscores {
+//! Persistent cache of score metadata (including the thumbnail).
+//! An entry is valid as long as the size and the modification time
+//! of the file did not change. The cache file is loaded on the first
+//! request; readMeta and save are thread safe, so files can be read in parallel.
+//! An empty cache path disables the cache.
+class ScoresMetaCache
+{
+public:
+    explicit ScoresMetaCache(const io::path& cachePath = io::path());
+
+    RetVal<notation::Meta> readMeta(const io::path& filePath, notation::IMsczMetaReader* reader);
+    Ret save();
+
+private:
+    struct Entry {
+        qint64 size = 0;
+        qint64 modified = 0;
+        notation::Meta meta;
+    };
+
+    void loadIfNeed();
+
+    io::path m_cachePath;
+    QMutex m_mutex;
+    QHash<QString, Entry> m_entries;
+    QSet<QString> m_used;
+    bool m_loaded = false;
+    bool m_changed = false;
+};
+}
+
+#endif // MU_USERSCORES_SCORESMETACACHE_H
@@ -19,6 +19,8 @@
 
 #include "templatesrepository.h"
 
+#include <QtConcurrent>
+
 #include "log.h"
 
 #include "io/path.h"
@@ -30,6 +32,10 @@ using namespace mu::framework;
 
 RetVal<Templates> TemplatesRepository::templates() const
 {
+    if (!m_metaCache) {
+        m_metaCache = std::make_unique<ScoresMetaCache>(configuration()->templatesMetaCachePath());
+    }
+
     Templates result;
 
     for (const io::path& dirPath: configuration()->templatesDirPaths()) {
@@ -44,23 +50,40 @@ RetVal<Templates> TemplatesRepository::templates() const
         result << loadTemplates(files.val);
     }
 
+    m_metaCache->save();
+
     return RetVal<Templates>::make_ok(result);
 }
 
 Templates TemplatesRepository::loadTemplates(const io::paths& filePaths) const
 {
-    Templates result;
+    struct Item {
+        io::path path;
+        RetVal<Meta> meta;
+    };
 
+    std::vector<Item> items;
     for (const io::path& pathToFile: filePaths) {
-        RetVal<Meta> meta = msczReader()->readMeta(pathToFile);
+        items.push_back({ pathToFile, RetVal<Meta>() });
+    }
+
+    //! NOTE Every file is a zip with xml inside, read them in parallel
+    std::shared_ptr<IMsczMetaReader> reader = msczReader();
+    ScoresMetaCache* cache = m_metaCache.get();
+    QtConcurrent::blockingMap(items, [reader, cache](Item& item) {
+        item.meta = cache->readMeta(item.path, reader.get());
+    });
+
+    Templates result;
 
-        if (!meta.ret) {
-            LOGE() << meta.ret.toString();
+    for (const Item& item: items) {
+        if (!item.meta.ret) {
+            LOGE() << item.meta.ret.toString();
             continue;
         }
 
-        Template templ(meta.val);
-        templ.categoryTitle = correctedTitle(io::dirname(pathToFile).toQString());
+        Template templ(item.meta.val);
+        templ.categoryTitle = correctedTitle(io::dirname(item.path).toQString());
 
         result << templ;
     }
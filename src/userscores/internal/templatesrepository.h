@@ -20,6 +20,8 @@
 #ifndef MU_USERSCORES_TEMPLATESREPOSITORY_H
 #define MU_USERSCORES_TEMPLATESREPOSITORY_H
 
+#include <memory>
+
 #include "modularity/ioc.h"
 
 #include "itemplatesrepository.h"
@@ -27,6 +29,8 @@
 #include "notation/imsczmetareader.h"
 #include "system/ifilesystem.h"
 
+#include "scoresmetacache.h"
+
 namespace mu::userscores {
 class TemplatesRepository : public ITemplatesRepository
 {
@@ -40,6 +44,8 @@ public:
 private:
     Templates loadTemplates(const io::paths& filePaths) const;
     QString correctedTitle(const QString& title) const;
+
+    mutable std::unique_ptr<ScoresMetaCache> m_metaCache;
 };
 }
 
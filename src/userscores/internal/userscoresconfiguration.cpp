@@ -93,6 +93,16 @@ io::path UserScoresConfiguration::defaultSavingFilePath(const std::string& fileN
     return scoresPath() + "/" + fileName + DEFAULT_FILE_SUFFIX;
 }
 
+io::path UserScoresConfiguration::recentScoresMetaCachePath() const
+{
+    return globalConfiguration()->dataPath() + "/recentscores.cache";
+}
+
+io::path UserScoresConfiguration::templatesMetaCachePath() const
+{
+    return globalConfiguration()->dataPath() + "/templates.cache";
+}
+
 QColor UserScoresConfiguration::templatePreviewBackgroundColor() const
 {
     return notationConfiguration()->backgroundColor();
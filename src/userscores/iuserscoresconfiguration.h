@@ -41,6 +41,9 @@ public:
     virtual io::path scoresPath() const = 0;
     virtual io::path defaultSavingFilePath(const std::string& fileName) const = 0;
 
+    virtual io::path recentScoresMetaCachePath() const = 0;
+    virtual io::path templatesMetaCachePath() const = 0;
+
     virtual QColor templatePreviewBackgroundColor() const = 0;
     virtual async::Channel<QColor> templatePreviewBackgroundColorChanged() const = 0;
 };
@@ -46,6 +46,12 @@ Item {
                     }
                 }
 
+                onThumbnailChanged: {
+                    if (item && !root.isAdd) {
+                        item.setThumbnail(thumbnail)
+                    }
+                }
+
                 layer.enabled: true
                 layer.effect: OpacityMask {
                     maskSource: Rectangle {
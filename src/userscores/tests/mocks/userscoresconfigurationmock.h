@@ -35,6 +35,9 @@ public:
     MOCK_METHOD(io::path, scoresPath, (), (const, override));
     MOCK_METHOD(io::path, defaultSavingFilePath, (const std::string&), (const, override));
 
+    MOCK_METHOD(io::path, recentScoresMetaCachePath, (), (const, override));
+    MOCK_METHOD(io::path, templatesMetaCachePath, (), (const, override));
+
     MOCK_METHOD(QColor, templatePreviewBackgroundColor, (), (const, override));
     MOCK_METHOD(async::Channel<QColor>, templatePreviewBackgroundColorChanged, (), (const, override));
 };
@@ -0,0 +1,145 @@
+//=============================================================================
+//  MuseScore
+//  Music Composition & Notation
+//
+//  Copyright (C) 2020 MuseScore BVBA and others
+//
+//  This program is free software; you can redistribute it and/or modify
+//  it under the terms of the GNU General Public License version 2.
+//
+//  This program is distributed in the hope that it will be useful,
+//  but WITHOUT ANY WARRANTY; without even the implied warranty of
+//  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+//  GNU General Public License for more details.
+//
+//  You should have received a copy of the GNU General Public License
+//  along with this program; if not, write to the Free Software
+//  Foundation, Inc., 675 Mass Ave, Cambridge, MA 02139, USA.
+//=============================================================================
+
+#include <gtest/gtest.h>
+
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "userscores/internal/scoresmetacache.h"
+
+#include "notation/tests/mocks/msczreadermock.h"
+
+using ::testing::_;
+using ::testing::Return;
+
+using namespace mu;
+using namespace mu::notation;
+using namespace mu::userscores;
+
+class ScoresMetaCacheTest : public ::testing::Test
+{
+protected:
+    void SetUp() override
+    {
+        ASSERT_TRUE(m_dir.isValid());
+
+        m_cachePath = m_dir.filePath("scoresmeta.cache");
+        m_scorePath = m_dir.filePath("score.mscz");
+        m_reader = std::make_shared<MsczReaderMock>();
+
+        writeScore("score");
+    }
+
+    void writeScore(const QByteArray& content) const
+    {
+        QFile file(m_scorePath.toQString());
+        ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+        file.write(content);
+    }
+
+    RetVal<Meta> createMeta(const QString& title) const
+    {
+        Meta meta;
+
+        meta.title = title;
+        meta.filePath = m_scorePath.toQString();
+        meta.partsCount = 2;
+        meta.creationDate = QDate(2020, 10, 1);
+
+        return RetVal<Meta>::make_ok(meta);
+    }
+
+    QTemporaryDir m_dir;
+    io::path m_cachePath;
+    io::path m_scorePath;
+    std::shared_ptr<MsczReaderMock> m_reader;
+};
+
+TEST_F(ScoresMetaCacheTest, CacheHit)
+{
+    // [GIVEN] The score is read once
+    ScoresMetaCache cache(m_cachePath);
+
+    EXPECT_CALL(*m_reader, readMeta(m_scorePath))
+    .WillOnce(Return(createMeta("Title")));
+
+    RetVal<Meta> first = cache.readMeta(m_scorePath, m_reader.get());
+    ASSERT_TRUE(first.ret);
+
+    // [WHEN] The unchanged score is read again
+    RetVal<Meta> second = cache.readMeta(m_scorePath, m_reader.get());
+
+    // [THEN] The meta comes from the cache, the reader was called only once
+    ASSERT_TRUE(second.ret);
+    EXPECT_EQ(second.val.title, "Title");
+    EXPECT_EQ(second.val.partsCount, size_t(2));
+}
+
+TEST_F(ScoresMetaCacheTest, StaleEntry)
+{
+    // [GIVEN] The score is in the cache
+    ScoresMetaCache cache(m_cachePath);
+
+    EXPECT_CALL(*m_reader, readMeta(m_scorePath))
+    .WillOnce(Return(createMeta("Old title")))
+    .WillOnce(Return(createMeta("New title")));
+
+    ASSERT_TRUE(cache.readMeta(m_scorePath, m_reader.get()).ret);
+
+    // [WHEN] The score file is changed
+    writeScore("changed score");
+
+    RetVal<Meta> meta = cache.readMeta(m_scorePath, m_reader.get());
+
+    // [THEN] The score is read again
+    ASSERT_TRUE(meta.ret);
+    EXPECT_EQ(meta.val.title, "New title");
+}
+
+TEST_F(ScoresMetaCacheTest, SaveAndReload)
+{
+    // [GIVEN] The cache with the score is saved
+    {
+        ScoresMetaCache cache(m_cachePath);
+
+        EXPECT_CALL(*m_reader, readMeta(m_scorePath))
+        .WillOnce(Return(createMeta("Title")));
+
+        ASSERT_TRUE(cache.readMeta(m_scorePath, m_reader.get()).ret);
+        ASSERT_TRUE(cache.save());
+    }
+
+    ASSERT_TRUE(QFile::exists(m_cachePath.toQString()));
+
+    // [WHEN] A new cache is created for the same file
+    ScoresMetaCache reloaded(m_cachePath);
+
+    EXPECT_CALL(*m_reader, readMeta(_))
+    .Times(0);
+
+    RetVal<Meta> meta = reloaded.readMeta(m_scorePath, m_reader.get());
+
+    // [THEN] The meta is read from the saved cache
+    ASSERT_TRUE(meta.ret);
+    EXPECT_EQ(meta.val.title, "Title");
+    EXPECT_EQ(meta.val.filePath, m_scorePath.toQString());
+    EXPECT_EQ(meta.val.partsCount, size_t(2));
+    EXPECT_EQ(meta.val.creationDate, QDate(2020, 10, 1));
+}
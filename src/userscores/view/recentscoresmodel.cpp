@@ -18,6 +18,13 @@
 //=============================================================================
 #include "recentscoresmodel.h"
 
+#include <atomic>
+
+#include <QFileInfo>
+#include <QCoreApplication>
+#include <QPointer>
+#include <QtConcurrent>
+
 #include "log.h"
 #include "translation.h"
 #include "actions/actiontypes.h"
@@ -41,6 +48,8 @@ RecentScoresModel::RecentScoresModel(QObject* parent)
     m_roles.insert(RoleTitle, "title");
     m_roles.insert(RoleScore, "score");
 
+    m_metaCache = std::make_shared<ScoresMetaCache>(configuration()->recentScoresMetaCachePath());
+
     ValCh<QStringList> recentScoresCh = configuration()->recentScoreList();
     updateRecentScores(recentScoresCh.val);
 
@@ -103,22 +112,29 @@ void RecentScoresModel::setRecentScores(const QVariantList& recentScores)
 
 void RecentScoresModel::updateRecentScores(const QStringList& recentScoresPathList)
 {
+    QHash<QString, QVariantMap> knownScores;
+    for (const QVariant& score : m_recentScores) {
+        QVariantMap obj = score.toMap();
+        if (!obj[SCORE_ADD_NEW_KEY].toBool()) {
+            knownScores.insert(obj[SCORE_PATH_KEY].toString(), obj);
+        }
+    }
+
     QVariantList recentScores;
 
+    //! NOTE Until the meta is read, a new score is shown with its file name
     for (const QString& path : recentScoresPathList) {
-        RetVal<Meta> meta = msczMetaReader()->readMeta(path);
-
-        if (!meta.ret) {
-            LOGW() << "Score reader error" << path;
+        if (knownScores.contains(path)) {
+            recentScores << knownScores[path];
             continue;
         }
 
         QVariantMap obj;
 
-        obj[SCORE_TITLE_KEY] = !meta.val.title.isEmpty() ? meta.val.title : meta.val.fileName;
+        obj[SCORE_TITLE_KEY] = QFileInfo(path).completeBaseName();
         obj[SCORE_PATH_KEY] = path;
-        obj[SCORE_THUMBNAIL_KEY] = meta.val.thumbnail;
-        obj[SCORE_TIME_SINCE_CREATION_KEY] = DataFormatter::formatTimeSinceCreation(meta.val.creationDate);
+        obj[SCORE_THUMBNAIL_KEY] = QVariant();
+        obj[SCORE_TIME_SINCE_CREATION_KEY] = QString();
         obj[SCORE_ADD_NEW_KEY] = false;
 
         recentScores << obj;
@@ -131,4 +147,72 @@ void RecentScoresModel::updateRecentScores(const QStringList& recentScoresPathLi
     recentScores.prepend(QVariant::fromValue(obj));
 
     setRecentScores(recentScores);
+
+    readMetaAsync(recentScoresPathList);
+}
+
+void RecentScoresModel::readMetaAsync(const QStringList& recentScoresPathList)
+{
+    //! NOTE The results of a previous list that are still on the way are ignored
+    int generation = ++m_generation;
+
+    if (recentScoresPathList.isEmpty()) {
+        return;
+    }
+
+    std::shared_ptr<IMsczMetaReader> reader = msczMetaReader();
+    std::shared_ptr<ScoresMetaCache> cache = m_metaCache;
+    auto remaining = std::make_shared<std::atomic<int> >(recentScoresPathList.size());
+    QPointer<RecentScoresModel> model(this);
+
+    for (const QString& path : recentScoresPathList) {
+        QtConcurrent::run([reader, cache, remaining, model, generation, path]() {
+            RetVal<Meta> meta = cache->readMeta(path, reader.get());
+
+            QMetaObject::invokeMethod(qApp, [model, generation, path, meta]() {
+                if (model && model->m_generation == generation) {
+                    model->setScoreMeta(path, meta);
+                }
+            }, Qt::QueuedConnection);
+
+            if (--(*remaining) == 0) {
+                cache->save();
+            }
+        });
+    }
+}
+
+void RecentScoresModel::setScoreMeta(const QString& path, const RetVal<Meta>& meta)
+{
+    int row = -1;
+    for (int i = 0; i < m_recentScores.size(); ++i) {
+        if (m_recentScores[i].toMap().value(SCORE_PATH_KEY).toString() == path) {
+            row = i;
+            break;
+        }
+    }
+
+    if (row < 0) {
+        return;
+    }
+
+    if (!meta.ret) {
+        LOGW() << "Score reader error" << path;
+
+        beginRemoveRows(QModelIndex(), row, row);
+        m_recentScores.removeAt(row);
+        endRemoveRows();
+        return;
+    }
+
+    QVariantMap obj = m_recentScores[row].toMap();
+
+    obj[SCORE_TITLE_KEY] = !meta.val.title.isEmpty() ? meta.val.title : meta.val.fileName;
+    obj[SCORE_THUMBNAIL_KEY] = meta.val.thumbnail;
+    obj[SCORE_TIME_SINCE_CREATION_KEY] = DataFormatter::formatTimeSinceCreation(meta.val.creationDate);
+
+    m_recentScores[row] = obj;
+
+    QModelIndex modelIndex = index(row);
+    emit dataChanged(modelIndex, modelIndex);
 }
@@ -19,6 +19,8 @@
 #ifndef MU_USERSCORES_RECENTSCORESMODEL_H
 #define MU_USERSCORES_RECENTSCORESMODEL_H
 
+#include <memory>
+
 #include <QAbstractListModel>
 
 #include "modularity/ioc.h"
@@ -26,6 +28,7 @@
 #include "actions/iactionsdispatcher.h"
 #include "iuserscoresconfiguration.h"
 #include "notation/imsczmetareader.h"
+#include "internal/scoresmetacache.h"
 
 namespace mu::userscores {
 class RecentScoresModel : public QAbstractListModel, public async::Asyncable
@@ -55,9 +58,14 @@ private:
 
     void updateRecentScores(const QStringList& recentScoresPathList);
     void setRecentScores(const QVariantList& recentScores);
+    void readMetaAsync(const QStringList& recentScoresPathList);
+    void setScoreMeta(const QString& path, const RetVal<notation::Meta>& meta);
 
     QVariantList m_recentScores;
     QHash<int, QByteArray> m_roles;
+
+    std::shared_ptr<ScoresMetaCache> m_metaCache;
+    int m_generation = 0;
 };
 }
 
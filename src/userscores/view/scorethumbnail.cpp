@@ -9,17 +9,17 @@ ScoreThumbnail::ScoreThumbnail(QQuickItem* parent)
 {
 }
 
-void ScoreThumbnail::setThumbnail(QVariant pixmap)
+void ScoreThumbnail::setThumbnail(QVariant thumbnail)
 {
-    if (pixmap.isNull()) {
+    if (thumbnail.isNull()) {
         return;
     }
 
-    m_thumbnail = pixmap.value<QPixmap>();
+    m_thumbnail = thumbnail.value<QImage>();
     update();
 }
 
 void ScoreThumbnail::paint(QPainter* painter)
 {
-    painter->drawPixmap(0, 0, width(), height(), m_thumbnail);
+    painter->drawImage(QRectF(0, 0, width(), height()), m_thumbnail);
 }
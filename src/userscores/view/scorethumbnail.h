@@ -21,6 +21,7 @@
 
 #include <QQuickPaintedItem>
 #include <QPainter>
+#include <QImage>
 
 namespace mu::userscores {
 class ScoreThumbnail : public QQuickPaintedItem
@@ -30,13 +31,13 @@ class ScoreThumbnail : public QQuickPaintedItem
 public:
     ScoreThumbnail(QQuickItem* parent = nullptr);
 
-    Q_INVOKABLE void setThumbnail(QVariant pixmap);
+    Q_INVOKABLE void setThumbnail(QVariant thumbnail);
 
 protected:
     virtual void paint(QPainter* painter) override;
 
 private:
-    QPixmap m_thumbnail;
+    QImage m_thumbnail;
 };
 }
 
@@ -39,9 +39,14 @@
 
 #ifndef QT_NO_TEXTODFWRITER
 
+#include <QBuffer>
 #include <QDir>
 #include <QDebug>
 #include <QFileInfo>
+#include <QSemaphore>
+#include <QThreadPool>
+
+#include <limits>
 
 #include "qzipreader_p.h"
 #include "qzipwriter_p.h"
@@ -541,9 +546,99 @@ public:
     {
     }
 
+    ~MQZipReaderPrivate()
+    {
+        unmapDevice();
+    }
+
     void scanFiles();
+    void mapDevice();
+    void unmapDevice();
+    int findFile(const QString& fileName) const;
+    bool entryData(int index, QByteArray* data, int* compressionMethod, int* uncompressedSize);
 
     MQZipReader::Status status;
+
+    // the archive is memory mapped if the device is a file, entries are then
+    // read without copying their compressed data
+    uchar* mappedData = nullptr;
+    qint64 mappedSize = 0;
+};
+
+//---------------------------------------------------------
+//   MQZipInflateDevice
+//    sequential device that inflates an entry while it is read
+//---------------------------------------------------------
+
+class MQZipInflateDevice : public QIODevice
+{
+public:
+    MQZipInflateDevice(const QByteArray& compressed, qint64 uncompressedSize)
+        : m_compressed(compressed), m_uncompressedSize(uncompressedSize)
+    {
+        memset(&m_stream, 0, sizeof(m_stream));
+        m_stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(m_compressed.constData()));
+        m_stream.avail_in = uInt(m_compressed.size());
+        m_initialized = inflateInit2(&m_stream, -MAX_WBITS) == Z_OK;
+    }
+
+    ~MQZipInflateDevice()
+    {
+        if (m_initialized) {
+            inflateEnd(&m_stream);
+        }
+    }
+
+    bool isSequential() const override { return true; }
+
+    qint64 bytesAvailable() const override
+    {
+        qint64 left = m_finished ? 0 : qMax(m_uncompressedSize - qint64(m_stream.total_out), qint64(0));
+        return left + QIODevice::bytesAvailable();
+    }
+
+protected:
+    qint64 readData(char* data, qint64 maxlen) override
+    {
+        if (!m_initialized) {
+            return -1;
+        }
+        if (m_finished || maxlen <= 0) {
+            return 0;
+        }
+
+        m_stream.next_out = reinterpret_cast<Bytef*>(data);
+        m_stream.avail_out = uInt(qMin(maxlen, qint64(std::numeric_limits<uInt>::max())));
+        const uInt outSize = m_stream.avail_out;
+
+        // a call may consume input without producing output, keep going until it does
+        while (m_stream.avail_out == outSize) {
+            int res = inflate(&m_stream, Z_SYNC_FLUSH);
+            if (res == Z_STREAM_END) {
+                m_finished = true;
+                break;
+            }
+            if (res != Z_OK) {
+                qWarning("QZip: inflate failed: %d", res);
+                setErrorString(QStringLiteral("Input data is corrupted"));
+                m_finished = true;
+                if (m_stream.avail_out == outSize) {
+                    return -1;
+                }
+                break;
+            }
+        }
+        return outSize - m_stream.avail_out;
+    }
+
+    qint64 writeData(const char*, qint64) override { return -1; }
+
+private:
+    QByteArray m_compressed;
+    qint64 m_uncompressedSize = 0;
+    z_stream m_stream;
+    bool m_initialized = false;
+    bool m_finished = false;
 };
 
 class MQZipWriterPrivate : public MQZipPrivate
@@ -565,7 +660,17 @@ public:
         Directory, File, Symlink
     };
 
+    // contents of an entry as it is stored in the archive
+    struct StoredData {
+        QByteArray data;
+        ushort compressionMethod = CompressionMethodStored;
+        uint crc = 0;
+        int uncompressedSize = 0;
+    };
+
     void addEntry(EntryType type, const QString& fileName, const QByteArray& contents);
+    void addStoredEntry(EntryType type, const QString& fileName, const StoredData& stored);
+    static StoredData compress(const QByteArray& contents, MQZipWriter::CompressionPolicy policy);
 };
 
 LocalFileHeader CentralFileHeader::toLocalHeader() const
@@ -673,26 +778,108 @@ void MQZipReaderPrivate::scanFiles()
         ZDEBUG("found file '%s'", header.file_name.data());
         fileHeaders.append(header);
     }
+
+    mapDevice();
 }
 
-void MQZipWriterPrivate::addEntry(EntryType type, const QString& fileName,
-                                  const QByteArray& contents /*, QFile::Permissions permissions, QZip::Method m*/)
+void MQZipReaderPrivate::mapDevice()
 {
-#ifndef NDEBUG
-    static const char* const entryTypes[] = {
-        "directory",
-        "file     ",
-        "symlink  " };
-    ZDEBUG() << "adding" << entryTypes[type] << ":" << fileName.toUtf8().data()
-             << (type == 2 ? QByteArray(" -> " + contents).constData() : "");
-#endif
+    QFile* file = qobject_cast<QFile*>(device);
+    if (!file || mappedData) {
+        return;
+    }
+    mappedSize = file->size();
+    mappedData = mappedSize > 0 ? file->map(0, mappedSize) : nullptr;
+    if (!mappedData) {
+        mappedSize = 0;
+    }
+}
 
-    if (!(device->isOpen() || device->open(QIODevice::WriteOnly))) {
-        status = MQZipWriter::FileOpenError;
+void MQZipReaderPrivate::unmapDevice()
+{
+    if (!mappedData) {
         return;
     }
-    device->seek(start_of_directory);
+    QFile* file = qobject_cast<QFile*>(device);
+    if (file) {
+        file->unmap(mappedData);
+    }
+    mappedData = nullptr;
+    mappedSize = 0;
+}
+
+int MQZipReaderPrivate::findFile(const QString& fileName) const
+{
+    const QByteArray name = fileName.toUtf8();
+    for (int i = 0; i < fileHeaders.size(); ++i) {
+        if (fileHeaders.at(i).file_name == name) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+//---------------------------------------------------------
+//   entryData
+//    return the (still compressed) data of an entry; the returned
+//    array references the mapped archive if possible and must not
+//    outlive the reader
+//---------------------------------------------------------
+
+bool MQZipReaderPrivate::entryData(int index, QByteArray* data, int* compressionMethod, int* uncompressedSize)
+{
+    const FileHeader& header = fileHeaders.at(index);
+
+    ushort version_needed = readUShort(header.h.version_needed);
+    if (version_needed > ZIP_VERSION) {
+        qWarning("QZip: .ZIP specification version %d implementationis needed to extract the data.", version_needed);
+        return false;
+    }
 
+    ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
+    if ((general_purpose_bits & Encrypted) != 0) {
+        qWarning("QZip: Unsupported encryption method is needed to extract the data.");
+        return false;
+    }
+
+    int compressed_size = readUInt(header.h.compressed_size);
+    *uncompressedSize = readUInt(header.h.uncompressed_size);
+    qint64 start = readUInt(header.h.offset_local_header);
+
+    LocalFileHeader lh;
+    if (mappedData) {
+        if (start + qint64(sizeof(LocalFileHeader)) > mappedSize) {
+            return false;
+        }
+        memcpy(&lh, mappedData + start, sizeof(LocalFileHeader));
+    } else {
+        device->seek(start);
+        device->read((char*)&lh, sizeof(LocalFileHeader));
+    }
+
+    uint skip = readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
+    qint64 dataStart = start + sizeof(LocalFileHeader) + skip;
+    *compressionMethod = readUShort(lh.compression_method);
+
+    if (*compressionMethod == CompressionMethodStored) {
+        compressed_size = qMin(compressed_size, *uncompressedSize);
+    }
+
+    if (mappedData) {
+        if (dataStart + compressed_size > mappedSize) {
+            return false;
+        }
+        *data = QByteArray::fromRawData(reinterpret_cast<const char*>(mappedData + dataStart), compressed_size);
+    } else {
+        device->seek(dataStart);
+        *data = device->read(compressed_size);
+    }
+    return true;
+}
+
+MQZipWriterPrivate::StoredData MQZipWriterPrivate::compress(const QByteArray& contents,
+                                                             MQZipWriter::CompressionPolicy compressionPolicy)
+{
     // don't compress small files
     MQZipWriter::CompressionPolicy compression = compressionPolicy;
     if (compressionPolicy == MQZipWriter::AutoCompress) {
@@ -703,32 +890,27 @@ void MQZipWriterPrivate::addEntry(EntryType type, const QString& fileName,
         }
     }
 
-    FileHeader header;
-    memset(&header.h, 0, sizeof(CentralFileHeader));
-    writeUInt(header.h.signature, 0x02014b50);
-
-    writeUShort(header.h.version_needed, ZIP_VERSION);
-    writeUInt(header.h.uncompressed_size, contents.length());
-    writeMSDosDate(header.h.last_mod_file, QDateTime::currentDateTime());
-    QByteArray data = contents;
+    StoredData stored;
+    stored.uncompressedSize = contents.length();
+    stored.data = contents;
     if (compression == MQZipWriter::AlwaysCompress) {
-        writeUShort(header.h.compression_method, CompressionMethodDeflated);
+        stored.compressionMethod = CompressionMethodDeflated;
 
         ulong len = contents.length();
         // shamelessly copied form zlib
         len += (len >> 12) + (len >> 14) + 11;
         int res;
         do {
-            data.resize(len);
-            res = deflate((uchar*)data.data(), &len, (const uchar*)contents.constData(), contents.length());
+            stored.data.resize(len);
+            res = deflate((uchar*)stored.data.data(), &len, (const uchar*)contents.constData(), contents.length());
 
             switch (res) {
             case Z_OK:
-                data.resize(len);
+                stored.data.resize(len);
                 break;
             case Z_MEM_ERROR:
                 qWarning("QZip: Z_MEM_ERROR: Not enough memory to compress file, skipping");
-                data.resize(0);
+                stored.data.resize(0);
                 break;
             case Z_BUF_ERROR:
                 len *= 2;
@@ -737,10 +919,44 @@ void MQZipWriterPrivate::addEntry(EntryType type, const QString& fileName,
         } while (res == Z_BUF_ERROR);
     }
 // TODO add a check if data.length() > contents.length().  Then try to store the original and revert the compression method to be uncompressed
-    writeUInt(header.h.compressed_size, data.length());
     uint crc_32 = ::crc32(0, 0, 0);
-    crc_32 = ::crc32(crc_32, (const uchar*)contents.constData(), contents.length());
-    writeUInt(header.h.crc_32, crc_32);
+    stored.crc = ::crc32(crc_32, (const uchar*)contents.constData(), contents.length());
+    return stored;
+}
+
+void MQZipWriterPrivate::addEntry(EntryType type, const QString& fileName,
+                                  const QByteArray& contents /*, QFile::Permissions permissions, QZip::Method m*/)
+{
+#ifndef NDEBUG
+    static const char* const entryTypes[] = {
+        "directory",
+        "file     ",
+        "symlink  " };
+    ZDEBUG() << "adding" << entryTypes[type] << ":" << fileName.toUtf8().data()
+             << (type == 2 ? QByteArray(" -> " + contents).constData() : "");
+#endif
+
+    addStoredEntry(type, fileName, compress(contents, compressionPolicy));
+}
+
+void MQZipWriterPrivate::addStoredEntry(EntryType type, const QString& fileName, const StoredData& stored)
+{
+    if (!(device->isOpen() || device->open(QIODevice::WriteOnly))) {
+        status = MQZipWriter::FileOpenError;
+        return;
+    }
+    device->seek(start_of_directory);
+
+    FileHeader header;
+    memset(&header.h, 0, sizeof(CentralFileHeader));
+    writeUInt(header.h.signature, 0x02014b50);
+
+    writeUShort(header.h.version_needed, ZIP_VERSION);
+    writeUInt(header.h.uncompressed_size, stored.uncompressedSize);
+    writeMSDosDate(header.h.last_mod_file, QDateTime::currentDateTime());
+    writeUShort(header.h.compression_method, stored.compressionMethod);
+    writeUInt(header.h.compressed_size, stored.data.length());
+    writeUInt(header.h.crc_32, stored.crc);
 
     // if bit 11 is set, the filename and comment fields must be encoded using UTF-8
     ushort general_purpose_bits = Utf8Names; // always use utf-8
@@ -785,7 +1001,7 @@ void MQZipWriterPrivate::addEntry(EntryType type, const QString& fileName,
     LocalFileHeader h = header.h.toLocalHeader();
     device->write((const char*)&h, sizeof(LocalFileHeader));
     device->write(header.file_name);
-    device->write(data);
+    device->write(stored.data);
     start_of_directory = device->pos();
     dirtyFileTree = true;
 }
@@ -971,54 +1187,25 @@ MQZipReader::FileInfo MQZipReader::entryInfoAt(int index) const
 QByteArray MQZipReader::fileData(const QString& fileName) const
 {
     d->scanFiles();
-    int i;
-    for (i = 0; i < d->fileHeaders.size(); ++i) {
-        if (QString::fromUtf8(d->fileHeaders.at(i).file_name) == fileName) {
-            break;
-        }
-    }
-    if (i == d->fileHeaders.size()) {
+    int i = d->findFile(fileName);
+    if (i < 0) {
         return QByteArray();
     }
 
-    FileHeader header = d->fileHeaders.at(i);
-
-    ushort version_needed = readUShort(header.h.version_needed);
-    if (version_needed > ZIP_VERSION) {
-        qWarning("QZip: .ZIP specification version %d implementationis needed to extract the data.", version_needed);
-        return QByteArray();
-    }
-
-    ushort general_purpose_bits = readUShort(header.h.general_purpose_bits);
-    int compressed_size = readUInt(header.h.compressed_size);
-    int uncompressed_size = readUInt(header.h.uncompressed_size);
-    int start = readUInt(header.h.offset_local_header);
-    //qDebug("uncompressing file %d: local header at %d", i, start);
-
-    d->device->seek(start);
-    LocalFileHeader lh;
-    d->device->read((char*)&lh, sizeof(LocalFileHeader));
-    uint skip = readUShort(lh.file_name_length) + readUShort(lh.extra_field_length);
-    d->device->seek(d->device->pos() + skip);
-
-    int compression_method = readUShort(lh.compression_method);
-    //qDebug("file=%s: compressed_size=%d, uncompressed_size=%d", fileName.toLocal8Bit().data(), compressed_size, uncompressed_size);
-
-    if ((general_purpose_bits & Encrypted) != 0) {
-        qWarning("QZip: Unsupported encryption method is needed to extract the data.");
+    QByteArray compressed;
+    int compression_method = 0;
+    int uncompressed_size = 0;
+    if (!d->entryData(i, &compressed, &compression_method, &uncompressed_size)) {
         return QByteArray();
     }
+    int compressed_size = compressed.size();
 
-    //qDebug("file at %lld", d->device->pos());
-    QByteArray compressed = d->device->read(compressed_size);
     if (compression_method == CompressionMethodStored) {
-        // no compression
-        compressed.truncate(uncompressed_size);
-        return compressed;
+        // no compression; detach from the mapped archive
+        return QByteArray(compressed.constData(), compressed.size());
     } else if (compression_method == CompressionMethodDeflated) {
         // Deflate
         //qDebug("compressed=%d", compressed.size());
-        compressed.truncate(compressed_size);
         QByteArray baunzip;
         ulong len = qMax(uncompressed_size,  1);
         int res;
@@ -1051,6 +1238,66 @@ QByteArray MQZipReader::fileData(const QString& fileName) const
     return QByteArray();
 }
 
+/*!
+    Fetch the contents of \a fileName as they are stored in the archive,
+    together with the compression method, the uncompressed size and the crc.
+    The data may reference the archive and must not outlive the reader.
+*/
+bool MQZipReader::rawFileData(const QString& fileName, QByteArray* data, int* compressionMethod,
+                              int* uncompressedSize, uint* crc) const
+{
+    d->scanFiles();
+    int i = d->findFile(fileName);
+    if (i < 0) {
+        return false;
+    }
+    if (!d->entryData(i, data, compressionMethod, uncompressedSize)) {
+        return false;
+    }
+    if (*compressionMethod != CompressionMethodStored && *compressionMethod != CompressionMethodDeflated) {
+        return false;
+    }
+    *crc = readUInt(d->fileHeaders.at(i).h.crc_32);
+    return true;
+}
+
+/*!
+    Returns a read-only device that delivers the uncompressed contents of
+    \a fileName while it is read, without inflating the whole file into
+    memory first. Returns 0 if the file is not found or cannot be extracted.
+    The caller takes ownership of the device, which must not outlive the reader.
+*/
+QIODevice* MQZipReader::fileDevice(const QString& fileName) const
+{
+    d->scanFiles();
+    int i = d->findFile(fileName);
+    if (i < 0) {
+        return 0;
+    }
+
+    QByteArray compressed;
+    int compression_method = 0;
+    int uncompressed_size = 0;
+    if (!d->entryData(i, &compressed, &compression_method, &uncompressed_size)) {
+        return 0;
+    }
+
+    QIODevice* dev = 0;
+    if (compression_method == CompressionMethodStored) {
+        QBuffer* buffer = new QBuffer();
+        buffer->setData(compressed);
+        dev = buffer;
+    } else if (compression_method == CompressionMethodDeflated) {
+        dev = new MQZipInflateDevice(compressed, uncompressed_size);
+    } else {
+        qWarning("QZip: Unsupported compression method %d is needed to extract the data.", compression_method);
+        return 0;
+    }
+
+    dev->open(QIODevice::ReadOnly);
+    return dev;
+}
+
 /*!
     Extracts the full contents of the zip file into \a destinationDir on
     the local filesystem.
@@ -1138,6 +1385,7 @@ MQZipReader::Status MQZipReader::status() const
 */
 void MQZipReader::close()
 {
+    d->unmapDevice();
     d->device->close();
 }
 
@@ -1321,6 +1569,61 @@ void MQZipWriter::addFile(const QString& fileName, const QByteArray& data)
     d->addEntry(MQZipWriterPrivate::File, QDir::fromNativeSeparators(fileName), data);
 }
 
+/*!
+    Add several files to the archive. The contents are compressed in parallel
+    on the global thread pool and written in the given order.
+*/
+void MQZipWriter::addFiles(const QVector<QPair<QString, QByteArray> >& files)
+{
+    QVector<MQZipWriterPrivate::StoredData> stored(files.size());
+    const MQZipWriter::CompressionPolicy policy = d->compressionPolicy;
+
+    QThreadPool* pool = QThreadPool::globalInstance();
+    QSemaphore done;
+    for (int i = 0; i < files.size(); ++i) {
+        MQZipWriterPrivate::StoredData* out = &stored[i];
+        const QByteArray* contents = &files.at(i).second;
+        auto task = [out, contents, policy, &done]() {
+            *out = MQZipWriterPrivate::compress(*contents, policy);
+            done.release();
+        };
+        // compress on the calling thread if no worker is free, so that
+        // calling this from a pool thread can not block the pool
+        if (!pool->tryStart(task)) {
+            task();
+        }
+    }
+    done.acquire(files.size());
+
+    for (int i = 0; i < files.size(); ++i) {
+        d->addStoredEntry(MQZipWriterPrivate::File, QDir::fromNativeSeparators(files.at(i).first), stored.at(i));
+    }
+}
+
+/*!
+    Copy the file \a sourceName from the archive \a source to \a fileName
+    without decompressing and compressing it again. Returns false if the
+    file cannot be read from \a source.
+*/
+bool MQZipWriter::copyFile(const MQZipReader& source, const QString& sourceName, const QString& fileName)
+{
+    QByteArray data;
+    int compressionMethod = 0;
+    int uncompressedSize = 0;
+    uint crc = 0;
+    if (!source.rawFileData(sourceName, &data, &compressionMethod, &uncompressedSize, &crc)) {
+        return false;
+    }
+
+    MQZipWriterPrivate::StoredData stored;
+    stored.data = data;
+    stored.compressionMethod = compressionMethod;
+    stored.uncompressedSize = uncompressedSize;
+    stored.crc = crc;
+    d->addStoredEntry(MQZipWriterPrivate::File, QDir::fromNativeSeparators(fileName), stored);
+    return true;
+}
+
 /*!
     Add a file to the archive with \a device as the source of the contents.
     The contents returned from QIODevice::readAll() will be used as the
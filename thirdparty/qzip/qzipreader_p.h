@@ -99,6 +99,9 @@ public:
 
     FileInfo entryInfoAt(int index) const;
     QByteArray fileData(const QString &fileName) const;
+    QIODevice* fileDevice(const QString &fileName) const;
+    bool rawFileData(const QString &fileName, QByteArray* data, int* compressionMethod, int* uncompressedSize,
+                     uint* crc) const;
     bool extractAll(const QString &destinationDir) const;
 
     enum Status {
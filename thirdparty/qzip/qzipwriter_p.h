@@ -56,10 +56,13 @@
 
 #include <QtCore/qstring.h>
 #include <QtCore/qfile.h>
+#include <QtCore/qpair.h>
+#include <QtCore/qvector.h>
 
 QT_BEGIN_NAMESPACE
 
 class MQZipWriterPrivate;
+class MQZipReader;
 
 
 class MQZipWriter
@@ -101,6 +104,10 @@ public:
 
     void addFile(const QString &fileName, QIODevice *device);
 
+    void addFiles(const QVector<QPair<QString, QByteArray> > &files);
+
+    bool copyFile(const MQZipReader &source, const QString &sourceName, const QString &fileName);
+
     void addDirectory(const QString &dirName);
 
     void addSymLink(const QString &fileName, const QString &destination);